@@ -0,0 +1,282 @@
+/*
+ * XBoing - An X11 blockout style computer game
+ *
+ * (c) Copyright 1993, 1994, 1995, Justin C. Kibell, All Rights Reserved
+ *
+ * The X Consortium, and any party obtaining a copy of these files from
+ * the X Consortium, directly or indirectly, is granted, free of charge, a
+ * full and unrestricted irrevocable, world-wide, paid up, royalty-free,
+ * nonexclusive right and license to deal in this software and
+ * documentation files (the "Software"), including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons who receive
+ * copies from any such party to do so.  This license includes without
+ * limitation a license to do the foregoing actions under any patents of
+ * the party supplying this software to the X Consortium.
+ *
+ * In no event shall the author be liable to any party for direct, indirect,
+ * special, incidental, or consequential damages arising out of the use of
+ * this software and its documentation, even if the author has been advised
+ * of the possibility of such damage.
+ *
+ * The author specifically disclaims any warranties, including, but not limited
+ * to, the implied warranties of merchantability and fitness for a particular
+ * purpose.  The software provided hereunder is on an "AS IS" basis, and the
+ * author has no obligation to provide maintenance, support, updates,
+ * enhancements, or modifications.
+ */
+
+/*
+ * =========================================================================
+ *
+ * Mode scoped asset groups with reference counts and a memory budget.
+ *
+ * Each group lists the modes that draw it and the routines in its own
+ * module that create and free its pixmaps. The current mode holds one
+ * reference on each of its groups. A group whose count falls to zero is
+ * kept, unless it is only ever shown once, and evicted least recently
+ * used first when the loaded groups come to more than the budget. Groups
+ * in use are never evicted, so the budget can be overrun while they are.
+ *
+ * =========================================================================
+ */
+
+/*
+ *  Include file dependencies:
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "include/faketypes.h"
+#include "include/error.h"
+#include "include/init.h"
+#include "include/main.h"
+#include "include/stage.h"
+#include "include/presents.h"
+#include "include/intro.h"
+#include "include/keys.h"
+#include "include/highscore.h"
+#include "include/dialogue.h"
+
+#include "include/assets.h"
+
+/*
+ *  Internal macro definitions:
+ */
+
+#define MODE_BIT(m)		(1 << (m))
+
+/*
+ *  Internal type declarations:
+ */
+
+typedef struct
+{
+	char 	*name;
+	int 	modes;			/* MODE_BIT() of every mode that draws it */
+	int 	once;			/* Never shown again once let go */
+	int 	kilobytes;		/* Pixmaps and masks at 32 bits a pixel */
+	Window 	*window;		/* Window the pixmaps are made for */
+	void 	(*load)(Display *display, Window window, Colormap colormap);
+	void 	(*unload)(Display *display);
+} assetGroup;
+
+static int 	ModeAssets(int m);
+static void AcquireAssets(Display *display, int group);
+static void ReleaseAssets(int group);
+static void LoadAssets(Display *display, int group);
+static void UnloadAssets(Display *display, int group);
+static void EvictAssets(Display *display);
+
+/*
+ *  Internal variable declarations:
+ */
+
+static assetGroup groups[NUM_ASSET_GROUPS] =
+{
+	{ "presents", 	MODE_BIT(MODE_PRESENTS), True, 308, &mainWindow,
+		SetUpPresents, FreeAllPresents },
+	{ "earth", 		MODE_BIT(MODE_PRESENTS) | MODE_BIT(MODE_HIGHSCORE), False,
+		645, &mainWindow, SetUpEarth, FreeSomePresents },
+	{ "title", 		MODE_BIT(MODE_INTRO), False, 141, &playWindow,
+		SetUpIntroduction, FreeIntroduction },
+	{ "sparkles", 	MODE_BIT(MODE_PRESENTS) | MODE_BIT(MODE_INTRO) |
+		MODE_BIT(MODE_INSTRUCT) | MODE_BIT(MODE_KEYS) |
+		MODE_BIT(MODE_KEYSEDIT) | MODE_BIT(MODE_HIGHSCORE), False, 18,
+		&playWindow, SetUpSparkles, FreeSparkles },
+	{ "keys", 		MODE_BIT(MODE_KEYS), False, 13, &playWindow,
+		SetUpKeys, FreeKeyControl },
+	{ "highscore", 	MODE_BIT(MODE_HIGHSCORE), False, 56, &playWindow,
+		SetUpHighScoreTitle, FreeHighScore },
+	{ "dialogue", 	MODE_BIT(MODE_DIALOGUE), False, 11, &inputWindow,
+		InitialiseDialoguePixmaps, FreeDialoguePixmaps },
+};
+
+static int 		refCount[NUM_ASSET_GROUPS];
+static int 		loaded[NUM_ASSET_GROUPS];
+static long 	lastUsed[NUM_ASSET_GROUPS];
+static long 	useCount = 0L;
+static int 		residentKb = 0;
+static int 		budgetKb = ASSET_BUDGET_KB;
+static int 		assetMode = MODE_NONE;
+static Colormap assetColormap;
+
+
+/**
+ * Returns a bit for each group the mode draws.
+ *
+ */
+static int ModeAssets(int m)
+{
+	int i, need = 0;
+
+	for (i = 0; i < NUM_ASSET_GROUPS; i++)
+		if (groups[i].modes & MODE_BIT(m))
+			need |= (1 << i);
+
+	return need;
+}
+
+
+static void LoadAssets(Display *display, int group)
+{
+	char str[80];
+
+	groups[group].load(display, *groups[group].window, assetColormap);
+
+	loaded[group] = True;
+	residentKb += groups[group].kilobytes;
+
+	sprintf(str, "Loaded %s assets, %d KB resident.", groups[group].name,
+		residentKb);
+	DEBUG(str)
+}
+
+
+static void UnloadAssets(Display *display, int group)
+{
+	char str[80];
+
+	groups[group].unload(display);
+
+	loaded[group] = False;
+	residentKb -= groups[group].kilobytes;
+
+	sprintf(str, "Freed %s assets, %d KB resident.", groups[group].name,
+		residentKb);
+	DEBUG(str)
+}
+
+
+static void AcquireAssets(Display *display, int group)
+{
+	if (loaded[group] == False)
+		LoadAssets(display, group);
+
+	refCount[group]++;
+	lastUsed[group] = ++useCount;
+}
+
+
+static void ReleaseAssets(int group)
+{
+	if (refCount[group] > 0)
+		refCount[group]--;
+}
+
+
+/**
+ * Frees groups nobody holds, least recently used first, until what is
+ * loaded fits the budget. Groups shown only once go straight away.
+ *
+ */
+static void EvictAssets(Display *display)
+{
+	int i, oldest;
+
+	for (i = 0; i < NUM_ASSET_GROUPS; i++)
+		if (loaded[i] == True && refCount[i] == 0 && groups[i].once == True)
+			UnloadAssets(display, i);
+
+	while (residentKb > budgetKb)
+	{
+		oldest = -1;
+
+		for (i = 0; i < NUM_ASSET_GROUPS; i++)
+			if (loaded[i] == True && refCount[i] == 0 &&
+				(oldest == -1 || lastUsed[i] < lastUsed[oldest]))
+				oldest = i;
+
+		/* Everything left is in use */
+		if (oldest == -1)
+			break;
+
+		UnloadAssets(display, oldest);
+	}
+}
+
+
+void InitialiseAssets(Display *display, Colormap colormap)
+{
+	char *budget;
+	int i;
+
+	assetColormap 	= colormap;
+	assetMode 		= MODE_NONE;
+
+	for (i = 0; i < NUM_ASSET_GROUPS; i++)
+	{
+		refCount[i] = 0;
+		loaded[i] 	= False;
+		lastUsed[i] = 0L;
+	}
+
+	/* Memory for unused groups, in kilobytes */
+	if ((budget = getenv("XBOING_ASSET_BUDGET")) != NULL)
+		budgetKb = atoi(budget);
+
+	if (budgetKb < 0)
+		budgetKb = 0;
+}
+
+
+void UseModeAssets(Display *display, int newMode)
+{
+	int i, need, held;
+
+	if (newMode == assetMode)
+		return;
+
+	need = ModeAssets(newMode);
+	held = ModeAssets(assetMode);
+
+	/* Take the new references first so shared groups stay loaded */
+	for (i = 0; i < NUM_ASSET_GROUPS; i++)
+		if (need & (1 << i))
+			AcquireAssets(display, i);
+
+	for (i = 0; i < NUM_ASSET_GROUPS; i++)
+		if (held & (1 << i))
+			ReleaseAssets(i);
+
+	assetMode = newMode;
+
+	EvictAssets(display);
+}
+
+
+void FreeAllAssets(Display *display)
+{
+	int i;
+
+	for (i = 0; i < NUM_ASSET_GROUPS; i++)
+	{
+		if (loaded[i] == True)
+			UnloadAssets(display, i);
+
+		refCount[i] = 0;
+	}
+
+	assetMode = MODE_NONE;
+}
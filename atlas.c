@@ -0,0 +1,420 @@
+/*
+ * XBoing - An X11 blockout style computer game
+ *
+ * (c) Copyright 1993, 1994, 1995, Justin C. Kibell, All Rights Reserved
+ *
+ * The X Consortium, and any party obtaining a copy of these files from
+ * the X Consortium, directly or indirectly, is granted, free of charge, a
+ * full and unrestricted irrevocable, world-wide, paid up, royalty-free,
+ * nonexclusive right and license to deal in this software and
+ * documentation files (the "Software"), including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons who receive
+ * copies from any such party to do so.  This license includes without
+ * limitation a license to do the foregoing actions under any patents of
+ * the party supplying this software to the X Consortium.
+ *
+ * In no event shall the author be liable to any party for direct, indirect,
+ * special, incidental, or consequential damages arising out of the use of
+ * this software and its documentation, even if the author has been advised
+ * of the possibility of such damage.
+ *
+ * The author specifically disclaims any warranties, including, but not limited
+ * to, the implied warranties of merchantability and fitness for a particular
+ * purpose.  The software provided hereunder is on an "AS IS" basis, and the
+ * author has no obligation to provide maintenance, support, updates,
+ * enhancements, or modifications.
+ */
+
+/*
+ * =========================================================================
+ *
+ * Sprite atlas - see include/atlas.h.
+ *
+ * Packing is a simple shelf packer: the sprites are sorted tallest first
+ * and laid left to right along a shelf as tall as the first one on it,
+ * starting a new shelf when a row fills and a new page when a page fills.
+ * The game's sprites are all much the same height so very little of a
+ * page is wasted.
+ *
+ * =========================================================================
+ */
+
+/*
+ *  Include file dependencies:
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <raylib.h>
+
+#include "include/error.h"
+#include "include/atlas.h"
+#include "include/pack.h"
+#include "include/loader.h"
+
+/*
+ *  Internal macro definitions:
+ */
+
+#define SPRITE_DIR		"bitmaps/"
+#define SPRITE_EXT		".png"
+#define NUM_SPRITES		((int) (sizeof(sprites) / sizeof(sprites[0])))
+
+/*
+ *  Internal type declarations:
+ */
+
+typedef struct
+{
+	char 		*name;		/* Image under bitmaps/ without the extension */
+	int 		page;		/* Atlas texture it was packed into */
+	Rectangle 	rect;		/* Where it is on that page */
+} atlasSprite;
+
+static int CheckSpriteImages(Image *images);
+static int CompareSpriteHeight(const void *a, const void *b);
+static int PackSprites(Image *images);
+
+/*
+ *  Internal variable declarations:
+ */
+
+/* Every sprite that goes into the atlas */
+static atlasSprite sprites[] =
+{
+	/* Blocks */
+	{ "blocks/redblk" }, 	{ "blocks/blueblk" }, 	{ "blocks/grnblk" },
+	{ "blocks/yellblk" }, 	{ "blocks/tanblk" }, 	{ "blocks/purpblk" },
+	{ "blocks/blakblk" }, 	{ "blocks/blakblkH" }, 	{ "blocks/bombblk" },
+	{ "blocks/reverse" }, 	{ "blocks/hypspc" }, 	{ "blocks/machgun" },
+	{ "blocks/walloff" }, 	{ "blocks/multibal" }, 	{ "blocks/stkyblk" },
+	{ "blocks/padshrk" }, 	{ "blocks/padexpn" }, 	{ "blocks/lotsammo" },
+	{ "blocks/clock" }, 	{ "blocks/dynamite" }, 	{ "blocks/cntblk" },
+	{ "blocks/cntblk1" }, 	{ "blocks/cntblk2" }, 	{ "blocks/cntblk3" },
+	{ "blocks/cntblk4" }, 	{ "blocks/cntblk5" }, 	{ "blocks/xtrabal" },
+	{ "blocks/xtrabal2" }, 	{ "blocks/roamer" }, 	{ "blocks/roamerL" },
+	{ "blocks/roamerR" }, 	{ "blocks/roamerU" }, 	{ "blocks/roamerD" },
+	{ "blocks/x2bonus1" }, 	{ "blocks/x2bonus2" }, 	{ "blocks/x2bonus3" },
+	{ "blocks/x2bonus4" }, 	{ "blocks/x4bonus1" }, 	{ "blocks/x4bonus2" },
+	{ "blocks/x4bonus3" }, 	{ "blocks/x4bonus4" }, 	{ "blocks/bonus1" },
+	{ "blocks/bonus2" }, 	{ "blocks/bonus3" }, 	{ "blocks/bonus4" },
+	{ "blocks/death1" }, 	{ "blocks/death2" }, 	{ "blocks/death3" },
+	{ "blocks/death4" }, 	{ "blocks/death5" },
+
+	/* Block explosions */
+	{ "blockex/exred1" }, 	{ "blockex/exred2" }, 	{ "blockex/exred3" },
+	{ "blockex/exblue1" }, 	{ "blockex/exblue2" }, 	{ "blockex/exblue3" },
+	{ "blockex/exgren1" }, 	{ "blockex/exgren2" }, 	{ "blockex/exgren3" },
+	{ "blockex/exyell1" }, 	{ "blockex/exyell2" }, 	{ "blockex/exyell3" },
+	{ "blockex/extan1" }, 	{ "blockex/extan2" }, 	{ "blockex/extan3" },
+	{ "blockex/expurp1" }, 	{ "blockex/expurp2" }, 	{ "blockex/expurp3" },
+	{ "blockex/exbomb1" }, 	{ "blockex/exbomb2" }, 	{ "blockex/exbomb3" },
+	{ "blockex/excnt1" }, 	{ "blockex/excnt2" }, 	{ "blockex/excnt3" },
+	{ "blockex/exx2bs1" }, 	{ "blockex/exx2bs2" }, 	{ "blockex/exx2bs3" },
+	{ "blockex/exdeath1" }, { "blockex/exdeath2" }, { "blockex/exdeath3" },
+	{ "blockex/exdeath4" },
+
+	/* Balls */
+	{ "balls/ball1" }, 		{ "balls/ball2" }, 		{ "balls/ball3" },
+	{ "balls/ball4" }, 		{ "balls/killer" }, 	{ "balls/life" },
+	{ "balls/bbirth1" }, 	{ "balls/bbirth2" }, 	{ "balls/bbirth3" },
+	{ "balls/bbirth4" }, 	{ "balls/bbirth5" }, 	{ "balls/bbirth6" },
+	{ "balls/bbirth7" }, 	{ "balls/bbirth8" },
+
+	/* Ball guides */
+	{ "guides/guide1" }, 	{ "guides/guide2" }, 	{ "guides/guide3" },
+	{ "guides/guide4" }, 	{ "guides/guide5" }, 	{ "guides/guide6" },
+	{ "guides/guide7" }, 	{ "guides/guide8" }, 	{ "guides/guide9" },
+	{ "guides/guide10" }, 	{ "guides/guide11" },
+
+	/* Digits */
+	{ "digits/digit0" }, 	{ "digits/digit1" }, 	{ "digits/digit2" },
+	{ "digits/digit3" }, 	{ "digits/digit4" }, 	{ "digits/digit5" },
+	{ "digits/digit6" }, 	{ "digits/digit7" }, 	{ "digits/digit8" },
+	{ "digits/digit9" },
+
+	/* Devil eyes */
+	{ "eyes/deveyes" }, 	{ "eyes/deveyes1" }, 	{ "eyes/deveyes2" },
+	{ "eyes/deveyes3" }, 	{ "eyes/deveyes4" }, 	{ "eyes/deveyes5" },
+
+	/* Paddles */
+	{ "paddle/padsml" }, 	{ "paddle/padmed" }, 	{ "paddle/padhuge" },
+
+	/* Bullets */
+	{ "guns/bullet" }, 		{ "guns/tink" },
+};
+
+static Texture2D 	pages[ATLAS_MAX_PAGES];
+static int 			numPages = 0;
+
+/* Sprite images, decoded by the loader threads until they are packed */
+static Image 		spriteImages[NUM_SPRITES];
+static int 			imagesQueued = False;
+
+/* Images being packed, for CompareSpriteHeight() */
+static Image 		*sortImages;
+
+
+/**
+ * Checks that the image of every sprite in the table was loaded.
+ *
+ * @param Image *images One image per sprite.
+ *
+ * @return True if they all loaded, False if any is missing.
+ *
+ */
+static int CheckSpriteImages(Image *images)
+{
+	char path[256];
+	int i, ok = True;
+
+	for (i = 0; i < NUM_SPRITES; i++)
+	{
+		if (images[i].data == NULL)
+		{
+			snprintf(path, sizeof(path), "Cannot load sprite %s.", 
+				sprites[i].name);
+			ErrorMessage(path);
+			ok = False;
+		}
+	}
+
+	return ok;
+}
+
+
+/**
+ * qsort() order for PackSprites() - tallest first, then widest.
+ *
+ */
+static int CompareSpriteHeight(const void *a, const void *b)
+{
+	Image *ia = &sortImages[*(const int *) a];
+	Image *ib = &sortImages[*(const int *) b];
+
+	if (ia->height != ib->height)
+		return ib->height - ia->height;
+
+	return ib->width - ia->width;
+}
+
+
+/**
+ * Lays every sprite out on the atlas pages and uploads the pages.
+ *
+ * @param Image *images One loaded image per sprite.
+ *
+ * @return True if everything fitted, False if the pages ran out.
+ *
+ */
+static int PackSprites(Image *images)
+{
+	Image canvas[ATLAS_MAX_PAGES];
+	int order[NUM_SPRITES];
+	int i, n, w, h, page = 0;
+	int x = ATLAS_PADDING, y = ATLAS_PADDING, shelf = 0;
+
+	for (i = 0; i < NUM_SPRITES; i++)
+		order[i] = i;
+
+	sortImages = images;
+	qsort(order, NUM_SPRITES, sizeof(int), CompareSpriteHeight);
+
+	canvas[0] = GenImageColor(ATLAS_SIZE, ATLAS_SIZE, BLANK);
+
+	for (i = 0; i < NUM_SPRITES; i++)
+	{
+		n = order[i];
+		w = images[n].width;
+		h = images[n].height;
+
+		if (w + 2 * ATLAS_PADDING > ATLAS_SIZE || 
+			h + 2 * ATLAS_PADDING > ATLAS_SIZE)
+		{
+			ErrorMessage("Sprite is larger than an atlas page.");
+			break;
+		}
+
+		/* No room left on this shelf so start the next one down */
+		if (x + w + ATLAS_PADDING > ATLAS_SIZE)
+		{
+			x 		= ATLAS_PADDING;
+			y 		+= shelf + ATLAS_PADDING;
+			shelf 	= 0;
+		}
+
+		/* No room left on this page so start another */
+		if (y + h + ATLAS_PADDING > ATLAS_SIZE)
+		{
+			if (page + 1 >= ATLAS_MAX_PAGES)
+			{
+				ErrorMessage("Sprites do not fit in the atlas.");
+				break;
+			}
+
+			canvas[++page] = GenImageColor(ATLAS_SIZE, ATLAS_SIZE, BLANK);
+			x = y = ATLAS_PADDING;
+			shelf = 0;
+		}
+
+		sprites[n].page = page;
+		sprites[n].rect = (Rectangle) { x, y, w, h };
+
+		ImageDraw(&canvas[page], images[n], 
+			(Rectangle) { 0, 0, w, h }, sprites[n].rect, WHITE);
+
+		x += w + ATLAS_PADDING;
+		if (h > shelf) shelf = h;
+	}
+
+	/* Upload the pages and drop the CPU copies */
+	for (numPages = 0; numPages <= page; numPages++)
+	{
+		pages[numPages] = LoadTextureFromImage(canvas[numPages]);
+		UnloadImage(canvas[numPages]);
+	}
+
+	return (i == NUM_SPRITES) ? True : False;
+}
+
+
+/**
+ * @brief Queues every sprite image to be decoded by the loader threads
+ */
+void QueueAtlasImages(void)
+{
+	char path[256];
+	int i;
+
+	for (i = 0; i < NUM_SPRITES; i++)
+	{
+		snprintf(path, sizeof(path), "%s%s%s", 
+			SPRITE_DIR, sprites[i].name, SPRITE_EXT);
+		QueueImage("atlas", path, &spriteImages[i]);
+	}
+
+	imagesQueued = True;
+}
+
+
+/**
+ * @brief Loads every sprite image and packs them into the atlas textures
+ *
+ * @return True if all the sprites were loaded and packed, False if not
+ */
+int InitialiseAtlas(void)
+{
+	int i, ok;
+
+	/* Decoded on the loader threads if they were queued early enough */
+	if (imagesQueued == False)
+		QueueAtlasImages();
+
+	FinishImageDecode();
+
+	BeginLoadTiming("atlas");
+
+	ok = CheckSpriteImages(spriteImages);
+	if (ok == True)
+		ok = PackSprites(spriteImages);
+
+	EndLoadTiming();
+
+	for (i = 0; i < NUM_SPRITES; i++)
+		if (spriteImages[i].data != NULL)
+			UnloadPackedImage(spriteImages[i]);
+
+	imagesQueued = False;
+	return ok;
+}
+
+
+/**
+ * @brief Unloads the atlas textures, every sprite handle becomes invalid
+ */
+void FreeAtlas(void)
+{
+	int i;
+
+	for (i = 0; i < numPages; i++)
+		UnloadTexture(pages[i]);
+
+	numPages = 0;
+}
+
+
+/**
+ * @brief Looks up a sprite by name
+ *
+ * @param name Image path under bitmaps/ without the extension
+ *
+ * @return The sprite handle, or SPRITE_NONE if there is no such sprite
+ */
+int GetSprite(char *name)
+{
+	char message[256];
+	int i;
+
+	/* Only done when initialising so a linear search is fine */
+	for (i = 0; i < NUM_SPRITES; i++)
+		if (strcmp(sprites[i].name, name) == 0)
+			return i;
+
+	snprintf(message, sizeof(message), "No sprite called %s.", name);
+	WarningMessage(message);
+
+	return SPRITE_NONE;
+}
+
+
+/**
+ * @brief Draws a sprite with its top left corner at x, y
+ *
+ * @param sprite Handle from GetSprite(), SPRITE_NONE draws nothing
+ * @param x Left edge in screen pixels
+ * @param y Top edge in screen pixels
+ */
+void DrawSprite(int sprite, int x, int y)
+{
+	if (sprite < 0 || sprite >= NUM_SPRITES || numPages == 0)
+		return;
+
+	DrawTextureRec(pages[sprites[sprite].page], sprites[sprite].rect,
+		(Vector2) { x, y }, WHITE);
+}
+
+
+/**
+ * @brief Returns where a sprite lives in its atlas page
+ *
+ * @param sprite Handle from GetSprite()
+ *
+ * @return The source rectangle, all zero for SPRITE_NONE
+ */
+Rectangle GetSpriteRect(int sprite)
+{
+	if (sprite < 0 || sprite >= NUM_SPRITES)
+		return (Rectangle) { 0, 0, 0, 0 };
+
+	return sprites[sprite].rect;
+}
+
+
+/**
+ * @brief Returns the width of a sprite in pixels
+ */
+int GetSpriteWidth(int sprite)
+{
+	return (int) GetSpriteRect(sprite).width;
+}
+
+
+/**
+ * @brief Returns the height of a sprite in pixels
+ */
+int GetSpriteHeight(int sprite)
+{
+	return (int) GetSpriteRect(sprite).height;
+}
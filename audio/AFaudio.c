@@ -73,6 +73,7 @@
 #include <fcntl.h>
 #include <X11/Xlib.h>
 #include "include/error.h"
+#include "include/sounds.h"
 #include "AFlib.h"
 
 /* 
@@ -316,6 +317,15 @@ void playSoundFile(char *filename, int volume)
     (void) close(fd);
 }
 
+void startSound(int id, int volume)
+{
+	char *name;
+
+	/* Sounds are played from their files here so go by name */
+	if ((name = GetSoundName(id)) != NULL)
+		playSoundFile(name, volume);
+}
+
 void audioDeviceEvents(void)
 {
     /* None to do */
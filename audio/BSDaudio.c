@@ -71,6 +71,8 @@
 #include <fcntl.h>
 #include <sys/sblast.h>
 
+#include "include/sounds.h"
+
 /*
  *  Internal macro definitions:
  */
@@ -316,6 +318,15 @@ void playSoundFile(char *filename, int volume)
     (void) close(fd);
 }
 
+void startSound(int id, int volume)
+{
+	char *name;
+
+	/* Sounds are played from their files here so go by name */
+	if ((name = GetSoundName(id)) != NULL)
+		playSoundFile(name, volume);
+}
+
 void audioDeviceEvents(void)
 {
 	/* None to do */
@@ -55,10 +55,12 @@
 #include <unistd.h>
 #include <stdio.h>
 #include <fcntl.h>
+#include <sys/ioctl.h>
 #include <linux/soundcard.h>
 
 #include "include/error.h"
 #include "include/audio.h"
+#include "include/pack.h"
 
 /*
  *  Internal macro definitions:
@@ -73,11 +75,14 @@ static int snd_pipes[2];
  *  Internal type declarations:
  */
 
+static int PlayPackedSound(char *name);
+
 /*
  *  Internal variable declarations:
  */
 
 static char				*Audio_dev = "/dev/audio";
+static char				*Dsp_dev = "/dev/dsp";
 static int 				Audio_fd;
 /* size should depend on sample_rate */
 static unsigned char   	buf[BUFFER_SIZE];       
@@ -125,6 +130,10 @@ int SetUpAudioSystem(Display *display)
 		     exit(0); 
 	             }	
 
+		/* Packed sounds are already PCM and go to the DSP device */
+		if (str == NULL && PlayPackedSound(string) == True)
+			continue;
+
 	          /* Try to open the audio device */
  	          if (!(Audio_fd = open(Audio_dev, O_WRONLY)))
   	          {	
@@ -185,6 +194,43 @@ int SetUpAudioSystem(Display *display)
        
      }
 }
+/*
+ * Plays a sound from the asset pack, set up for its rate and channels,
+ * and waits for it to finish like the file path does.
+ * Returns False if the sound is not packed.
+ */
+static int PlayPackedSound(char *name)
+{
+	char path[300];
+	packEntry *entry;
+	int fd, format = AFMT_S16_NE, channels, rate;
+
+	sprintf(path, "sounds/%s.au", name);
+	if ((entry = FindPackEntry(path, PACK_SOUND)) == NULL)
+		return False;
+
+	if ((fd = open(Dsp_dev, O_WRONLY)) < 0)
+	{
+		WarningMessage("Unable to open the sound device.");
+		return True;
+	}
+
+	channels 	= (int) entry->height;
+	rate 		= (int) entry->width;
+
+	if (ioctl(fd, SNDCTL_DSP_SETFMT, &format) < 0 ||
+		ioctl(fd, SNDCTL_DSP_CHANNELS, &channels) < 0 ||
+		ioctl(fd, SNDCTL_DSP_SPEED, &rate) < 0)
+		WarningMessage("Unable to set up the sound device.");
+	else if (write(fd, GetPackData(entry), entry->size) != (int) entry->size)
+		WarningMessage("Problem while writing to sound device");
+
+	ioctl(fd, SNDCTL_DSP_SYNC, 0);
+	close(fd);
+
+	return True;
+}
+
 void FreeAudioSystem(void)
 {
 	char exit_command[256];
@@ -221,6 +267,15 @@ void playSoundFile(char *filename, int volume)
 		ErrorMessage("Cannot write to audio device.");
 }
 
+void startSound(int id, int volume)
+{
+	char *name;
+
+	/* Sounds are played from their files here so go by name */
+	if ((name = GetSoundName(id)) != NULL)
+		playSoundFile(name, volume);
+}
+
 void SetMaximumVolume(int Volume)
 {
 }
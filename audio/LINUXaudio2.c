@@ -281,6 +281,15 @@ channels++;
 if (channels > 3) channels = 0;
 }
 
+void startSound(int id, int volume)
+{
+	char *name;
+
+	/* Sounds are played from their files here so go by name */
+	if ((name = GetSoundName(id)) != NULL)
+		playSoundFile(name, volume);
+}
+
 void SetMaximumVolume(int Volume)
 {
 }
@@ -0,0 +1,802 @@
+/*
+ * XBoing - An X11 blockout style computer game
+ *
+ * (c) Copyright 1993, 1994, 1995, Justin C. Kibell, All Rights Reserved
+ *
+ * The X Consortium, and any party obtaining a copy of these files from
+ * the X Consortium, directly or indirectly, is granted, free of charge, a
+ * full and unrestricted irrevocable, world-wide, paid up, royalty-free,
+ * nonexclusive right and license to deal in this software and
+ * documentation files (the "Software"), including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons who receive
+ * copies from any such party to do so.  This license includes without
+ * limitation a license to do the foregoing actions under any patents of
+ * the party supplying this software to the X Consortium.
+ *
+ * In no event shall the author be liable to any party for direct, indirect,
+ * special, incidental, or consequential damages arising out of the use of
+ * this software and its documentation, even if the author has been advised
+ * of the possibility of such damage.
+ *
+ * The author specifically disclaims any warranties, including, but not limited
+ * to, the implied warranties of merchantability and fitness for a particular
+ * purpose.  The software provided hereunder is on an "AS IS" basis, and the
+ * author has no obligation to provide maintenance, support, updates,
+ * enhancements, or modifications.
+ */
+
+/*
+ * =========================================================================
+ *
+ * Linux sound mixer. Every sound in the sounds directory (or the asset
+ * pack) is decoded to 16 bit PCM once, when the audio system is set up.
+ * The DSP device is opened then and kept open with short fragments, and a
+ * mixer thread adds up the sounds playing and writes them a fragment at a
+ * time. Sounds overlap instead of queueing behind each other and the
+ * game never waits on the device. Samples are kept by SND_ id so finding
+ * one is an array index.
+ *
+ * startSound() does not touch the voices. It puts a small command on a
+ * single producer, single consumer ring which the mixer thread empties
+ * before each fragment, so the game thread never takes a lock or makes a
+ * system call to start a sound. When the ring is full the sound is
+ * dropped and counted, and commands the mixer gets to more than
+ * MIX_STALE_MSEC after they were queued are dropped as too late.
+ *
+ * There are XBOING_SOUND_VOICES voices, 8 unless set. The volume given to
+ * startSound() is also the sound's priority: with every voice busy a
+ * new sound takes over the quietest voice playing, the one that has
+ * played longest if several are as quiet, as long as that is no louder
+ * than itself. Otherwise the new sound is dropped. With -debug the
+ * numbers dropped and cut short are printed on exit.
+ *
+ * With two 4ms fragments queued a sound starts within about 10ms of the
+ * call.
+ *
+ * =========================================================================
+ */
+
+/*
+ *  Include file dependencies:
+ */
+
+#include <unistd.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <linux/soundcard.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "include/init.h"
+#include "include/error.h"
+#include "include/audio.h"
+#include "include/pack.h"
+
+/*
+ *  Internal macro definitions:
+ */
+
+/* Every sound shipped is 8kHz, others are stepped to the device rate */
+#define MIX_RATE				8000
+#define MIX_FRAGMENT_SHIFT		6			/* 64 bytes, 4ms at MIX_RATE */
+#define MIX_FRAGMENTS			2
+#define MIX_MAX_PERIOD			1024		/* Frames mixed in one go */
+
+#define MIX_VOICES				8			/* Unless XBOING_SOUND_VOICES */
+#define MIX_MAX_VOICES			32
+
+/* Commands waiting for the mixer, a power of two */
+#define MIX_RING_SIZE			64
+#define MIX_STALE_MSEC			100
+
+/* Pan runs from MIX_PAN_LEFT to MIX_PAN_RIGHT, only heard in stereo */
+#define MIX_PAN_LEFT			-100
+#define MIX_PAN_CENTRE			0
+#define MIX_PAN_RIGHT			100
+
+/* Cache line size, to keep each end of the ring to itself */
+#define MIX_LINE				64
+
+/* Sun .au header */
+#define AU_MAGIC				0x2e736e64
+#define AU_ULAW					1
+#define AU_LINEAR_8				2
+#define AU_LINEAR_16			3
+
+/*
+ *  Internal type declarations:
+ */
+
+typedef struct
+{
+	short 			*pcm;			/* NULL if the sound failed to load */
+	int 			frames;
+	int 			rate;
+	int 			packed;			/* True if pcm is in the asset pack */
+} mixSample;
+
+typedef struct
+{
+	mixSample 		*sample;		/* NULL when the voice is free */
+	unsigned long 	pos;			/* 16.16 fixed point frame */
+	unsigned long 	step;			/* Sample frames per output frame */
+	int 			gain[2];		/* 0 - 256, left and right */
+	int 			priority;		/* Volume it was started with */
+	unsigned long 	started;		/* Start order, for stealing */
+} mixVoice;
+
+typedef struct
+{
+	short 			id;				/* SND_ id */
+	short 			volume;			/* 0 - 100, also the priority */
+	short 			gain;			/* 0 - 256, after the maximum volume */
+	short 			pan;			/* MIX_PAN_LEFT - MIX_PAN_RIGHT */
+	unsigned long 	start;			/* Mixer clock when it was queued */
+} soundCommand;
+
+/*
+ * The indices only ever count up and are masked on use. head is written
+ * by the game thread alone and tail by the mixer thread alone.
+ */
+typedef struct
+{
+	unsigned int 	head;
+	char 			pad1[MIX_LINE - sizeof(unsigned int)];
+	unsigned int 	tail;
+	char 			pad2[MIX_LINE - sizeof(unsigned int)];
+	soundCommand 	commands[MIX_RING_SIZE];
+} soundRing;
+
+static int 		LoadSamples(void);
+static int 		LoadSample(char *dir, int id);
+static short 	*DecodeAuFile(char *path, int *frames, int *rate);
+static short 	DecodeUlaw(unsigned char u);
+static int 		OpenMixerDevice(void);
+static int 		WriteDevice(char *data, size_t size);
+static void 	*MixerThread(void *arg);
+static void 	MixSpan(int *mix, short *pcm, int n, int gain);
+static void 	ClipSpan(int *mix, short *out, int n);
+static mixVoice *ChooseVoice(int priority);
+static int 		QueueSound(int id, int volume, int pan);
+static void 	StartQueuedSounds(void);
+
+/*
+ *  Internal variable declarations:
+ */
+
+static char				*Dsp_dev = "/dev/dsp";
+static int 				dspFd = -1;
+static int 				deviceRate, deviceChannels, periodFrames;
+
+static mixSample 		samples[NUM_SOUNDS];
+static int 				numSamples = 0;		/* Loaded, not counting failures */
+
+static mixVoice 		voices[MIX_MAX_VOICES];
+static int 				numVoices = MIX_VOICES;
+static unsigned long 	voicesStarted = 0UL;
+static unsigned long 	voicesDropped = 0UL, voicesStolen = 0UL;
+static unsigned long 	voicesLate = 0UL, ringOverflows = 0UL;
+static soundRing 		ring;
+static unsigned long 	mixClock = 0UL;		/* Frames written so far */
+static pthread_t 		mixer;
+static int 				mixerRunning = False;	/* __atomic only */
+static int 				maxVolume = 100;
+
+static char 			errorString[255];
+
+
+/**
+ * Expands one G.711 mu-law byte to a 16 bit sample, as xbpack does.
+ *
+ */
+static short DecodeUlaw(unsigned char u)
+{
+	int t;
+
+	u = ~u;
+	t = (((u & 0x0f) << 3) + 0x84) << ((u & 0x70) >> 4);
+
+	return (short) ((u & 0x80) ? (0x84 - t) : (t - 0x84));
+}
+
+
+/**
+ * Reads a Sun .au file and decodes it to 16 bit PCM. Only mono files are
+ * played; the channels of anything else are run together.
+ *
+ */
+static short *DecodeAuFile(char *path, int *frames, int *rate)
+{
+	unsigned char *file, *p;
+	unsigned long offset, length, encoding, i, n;
+	short *pcm;
+	struct stat st;
+	int fd;
+
+	if ((fd = open(path, O_RDONLY)) < 0 || fstat(fd, &st) < 0)
+	{
+		if (fd >= 0) close(fd);
+		return NULL;
+	}
+
+	file = malloc(st.st_size > 0 ? st.st_size : 1);
+	if (file == NULL || read(fd, file, st.st_size) != st.st_size || 
+		st.st_size < 24 || 
+		((file[0] << 24) | (file[1] << 16) | (file[2] << 8) | file[3]) 
+			!= AU_MAGIC)
+	{
+		close(fd);
+		free(file);
+		return NULL;
+	}
+	close(fd);
+
+#define BE32(b)	(((unsigned long) (b)[0] << 24) | ((b)[1] << 16) | \
+				((b)[2] << 8) | (b)[3])
+	offset 		= BE32(file + 4);
+	length 		= BE32(file + 8);
+	encoding 	= BE32(file + 12);
+	*rate 		= (int) BE32(file + 16);
+#undef BE32
+
+	/* The length may be unknown (~0) or run past the end of the file */
+	if (offset > (unsigned long) st.st_size) offset = st.st_size;
+	if (length > st.st_size - offset) length = st.st_size - offset;
+	p = file + offset;
+
+	n = (encoding == AU_LINEAR_16) ? length / 2 : length;
+	if ((encoding != AU_ULAW && encoding != AU_LINEAR_8 && 
+		encoding != AU_LINEAR_16) || 
+		(pcm = malloc((n ? n : 1) * sizeof(short))) == NULL)
+	{
+		free(file);
+		return NULL;
+	}
+
+	for (i = 0; i < n; i++)
+	{
+		if (encoding == AU_ULAW)
+			pcm[i] = DecodeUlaw(p[i]);
+		else if (encoding == AU_LINEAR_8)
+			pcm[i] = (short) ((signed char) p[i] * 256);
+		else
+			pcm[i] = (short) ((p[2 * i] << 8) | p[2 * i + 1]);
+	}
+
+	free(file);
+	*frames = (int) n;
+	return pcm;
+}
+
+
+/**
+ * Loads one sound into its slot in the sample table, from the pack if it
+ * is there and the sound directory was not given, else from its file.
+ *
+ */
+static int LoadSample(char *dir, int id)
+{
+	char path[1024];
+	mixSample *s = &samples[id];
+	packEntry *entry = NULL;
+	char *name = GetSoundName(id);
+
+	sprintf(path, "sounds/%s.au", name);
+	if (getenv("XBOING_SOUND_DIR") == NULL)
+		entry = FindPackEntry(path, PACK_SOUND);
+
+	if (entry != NULL)
+	{
+		/* Mapped until the pack is closed, which is after audio is freed */
+		s->pcm 		= (short *) GetPackData(entry);
+		s->frames 	= (int) (entry->size / (sizeof(short) * entry->height));
+		s->rate 	= (int) entry->width;
+		s->packed 	= True;
+	}
+	else
+	{
+		snprintf(path, sizeof(path), "%s/%s.au", dir, name);
+		if ((s->pcm = DecodeAuFile(path, &s->frames, &s->rate)) == NULL)
+		{
+			sprintf(errorString, "Unable to load sound file %s.au.", name);
+			WarningMessage(errorString);
+			return False;
+		}
+		s->packed = False;
+	}
+
+	numSamples++;
+	return True;
+}
+
+
+/**
+ * Decodes every sound in the registry, see sounds.h.
+ *
+ */
+static int LoadSamples(void)
+{
+	char *dir;
+	int id;
+
+	if ((dir = getenv("XBOING_SOUND_DIR")) == NULL)
+		dir = SOUNDS_DIR;
+
+	for (id = 0; id < NUM_SOUNDS; id++)
+		(void) LoadSample(dir, id);
+
+	if (numSamples == 0)
+	{
+		sprintf(errorString, "Cannot load any sounds from %s.", dir);
+		ErrorMessage(errorString);
+		return False;
+	}
+
+	return True;
+}
+
+
+/**
+ * Opens the DSP device with short fragments so little is ever queued.
+ *
+ */
+static int OpenMixerDevice(void)
+{
+	int frag = (MIX_FRAGMENTS << 16) | MIX_FRAGMENT_SHIFT;
+	int format = AFMT_S16_NE, block = 0;
+
+	if ((dspFd = open(Dsp_dev, O_WRONLY)) < 0)
+	{
+		sprintf(errorString, "Cannot open audio device %s.", Dsp_dev);
+		ErrorMessage(errorString);
+		return False;
+	}
+
+	/* Fragments have to be asked for before anything else is set */
+	deviceChannels 	= 1;
+	deviceRate 		= MIX_RATE;
+	if (ioctl(dspFd, SNDCTL_DSP_SETFRAGMENT, &frag) < 0)
+		WarningMessage("Unable to set the sound fragment size.");
+
+	if (ioctl(dspFd, SNDCTL_DSP_SETFMT, &format) < 0 || 
+		format != AFMT_S16_NE ||
+		ioctl(dspFd, SNDCTL_DSP_CHANNELS, &deviceChannels) < 0 ||
+		deviceChannels < 1 || deviceChannels > 2 ||
+		ioctl(dspFd, SNDCTL_DSP_SPEED, &deviceRate) < 0 || deviceRate <= 0)
+	{
+		ErrorMessage("Unable to set up the sound device.");
+		close(dspFd);
+		dspFd = -1;
+		return False;
+	}
+
+	/* Mix one fragment at a time */
+	if (ioctl(dspFd, SNDCTL_DSP_GETBLKSIZE, &block) < 0 || block <= 0)
+		block = 1 << MIX_FRAGMENT_SHIFT;
+
+	periodFrames = block / (int) (sizeof(short) * deviceChannels);
+	if (periodFrames < 1) 				periodFrames = 1;
+	if (periodFrames > MIX_MAX_PERIOD) 	periodFrames = MIX_MAX_PERIOD;
+
+	return True;
+}
+
+
+/**
+ * Writes a whole fragment to the device, carrying on after a signal or a
+ * device that is busy for a moment. Returns False if the device has gone
+ * or the audio system is being shut down.
+ *
+ */
+static int WriteDevice(char *data, size_t size)
+{
+	ssize_t n;
+
+	while (size > 0)
+	{
+		if ((n = write(dspFd, data, size)) < 0)
+		{
+			if (errno != EINTR && errno != EAGAIN)
+				return False;
+
+			if (__atomic_load_n(&mixerRunning, __ATOMIC_ACQUIRE) == False)
+				return False;
+
+			if (errno == EAGAIN)
+				usleep(1000);
+
+			continue;
+		}
+
+		data += n;
+		size -= (size_t) n;
+	}
+
+	return True;
+}
+
+
+/**
+ * Mixes the playing voices a fragment at a time for as long as the audio
+ * system is up, starting whatever sounds have been queued first. The
+ * write blocks until the device has room, which is what paces the thread.
+ * The voices belong to this thread alone.
+ *
+ */
+static void *MixerThread(void *arg)
+{
+	int mix[2][MIX_MAX_PERIOD];
+	short clipped[2][MIX_MAX_PERIOD], out[MIX_MAX_PERIOD * 2], *data;
+	mixVoice *v;
+	int c, i, f, n, left, sample;
+
+	(void) arg;
+
+	while (__atomic_load_n(&mixerRunning, __ATOMIC_ACQUIRE) == True)
+	{
+		StartQueuedSounds();
+
+		for (c = 0; c < deviceChannels; c++)
+			memset(mix[c], 0, periodFrames * sizeof(int));
+
+		for (i = 0; i < numVoices; i++)
+		{
+			v = &voices[i];
+			if (v->sample == NULL)
+				continue;
+
+			left = v->sample->frames - (int) (v->pos >> 16);
+			n = (left < periodFrames) ? left : periodFrames;
+
+			if (v->step == (1UL << 16))
+			{
+				/* Same rate as the device, the usual case */
+				for (c = 0; c < deviceChannels; c++)
+					MixSpan(mix[c], v->sample->pcm + (v->pos >> 16), n, 
+						v->gain[c]);
+				v->pos += (unsigned long) n << 16;
+			}
+			else
+			{
+				for (f = 0; f < periodFrames && 
+					(v->pos >> 16) < (unsigned long) v->sample->frames; f++)
+				{
+					sample = v->sample->pcm[v->pos >> 16];
+					for (c = 0; c < deviceChannels; c++)
+						mix[c][f] += (sample * v->gain[c]) >> 8;
+					v->pos += v->step;
+				}
+			}
+
+			/* Finished so the voice is free again */
+			if ((v->pos >> 16) >= (unsigned long) v->sample->frames)
+				v->sample = NULL;
+		}
+
+		for (c = 0; c < deviceChannels; c++)
+			ClipSpan(mix[c], clipped[c], periodFrames);
+
+		/* Interleave the channels for the device */
+		if (deviceChannels == 1)
+			data = clipped[0];
+		else
+		{
+			for (f = 0; f < periodFrames; f++)
+			{
+				out[2 * f] 		= clipped[0][f];
+				out[2 * f + 1] 	= clipped[1][f];
+			}
+			data = out;
+		}
+
+		if (WriteDevice((char *) data, 
+			periodFrames * deviceChannels * sizeof(short)) == False)
+			break;
+
+		/* Read by the game thread to stamp the sounds it queues */
+		__atomic_store_n(&mixClock, mixClock + periodFrames, __ATOMIC_RELAXED);
+	}
+
+	return NULL;
+}
+
+
+/**
+ * Adds n samples scaled by gain / 256 into the mix.
+ *
+ */
+static void MixSpan(int *mix, short *pcm, int n, int gain)
+{
+	int i = 0;
+#ifdef __SSE2__
+	__m128i g = _mm_set1_epi16((short) gain);
+	__m128i s, lo, hi, a, b;
+
+	/* Eight samples at a time, the 32 bit products made from two halves */
+	for (; i + 8 <= n; i += 8)
+	{
+		s 	= _mm_loadu_si128((__m128i *) (pcm + i));
+		lo 	= _mm_mullo_epi16(s, g);
+		hi 	= _mm_mulhi_epi16(s, g);
+		a 	= _mm_srai_epi32(_mm_unpacklo_epi16(lo, hi), 8);
+		b 	= _mm_srai_epi32(_mm_unpackhi_epi16(lo, hi), 8);
+
+		_mm_storeu_si128((__m128i *) (mix + i), 
+			_mm_add_epi32(_mm_loadu_si128((__m128i *) (mix + i)), a));
+		_mm_storeu_si128((__m128i *) (mix + i + 4), 
+			_mm_add_epi32(_mm_loadu_si128((__m128i *) (mix + i + 4)), b));
+	}
+#endif
+
+	for (; i < n; i++)
+		mix[i] += (pcm[i] * gain) >> 8;
+}
+
+
+/**
+ * Clips the mix to 16 bit samples.
+ *
+ */
+static void ClipSpan(int *mix, short *out, int n)
+{
+	int i = 0, s;
+#ifdef __SSE2__
+	/* Packing to 16 bits saturates, which is the clip */
+	for (; i + 8 <= n; i += 8)
+		_mm_storeu_si128((__m128i *) (out + i), _mm_packs_epi32(
+			_mm_loadu_si128((__m128i *) (mix + i)),
+			_mm_loadu_si128((__m128i *) (mix + i + 4))));
+#endif
+
+	for (; i < n; i++)
+	{
+		s = mix[i];
+		if (s > 32767) 	s = 32767;
+		if (s < -32768) s = -32768;
+		out[i] = (short) s;
+	}
+}
+
+
+/**
+ * Picks the voice for a new sound of this priority: a free one, else the
+ * quietest playing, the longest playing of those if there is a tie, as
+ * long as it is no louder than the new sound. Only called by the mixer
+ * thread.
+ *
+ */
+static mixVoice *ChooseVoice(int priority)
+{
+	mixVoice *victim = NULL, *v;
+	int i;
+
+	for (i = 0; i < numVoices; i++)
+	{
+		v = &voices[i];
+		if (v->sample == NULL)
+			return v;
+
+		if (victim == NULL || v->priority < victim->priority ||
+			(v->priority == victim->priority && v->started < victim->started))
+			victim = v;
+	}
+
+	if (victim == NULL || victim->priority > priority)
+	{
+		voicesDropped++;
+		return NULL;
+	}
+
+	voicesStolen++;
+	return victim;
+}
+
+
+/**
+ * Puts a sound on the ring for the mixer thread. Game thread only. Never
+ * waits: if the mixer has not emptied the ring the sound is dropped.
+ *
+ */
+static int QueueSound(int id, int volume, int pan)
+{
+	soundCommand *cmd;
+	unsigned int head = ring.head;
+	int top;
+
+	if (head - __atomic_load_n(&ring.tail, __ATOMIC_ACQUIRE) == MIX_RING_SIZE)
+	{
+		ringOverflows++;
+		return False;
+	}
+
+	/* A maximum of 0 means the system default, which is full volume here */
+	top = (maxVolume == 0) ? 100 : maxVolume;
+
+	cmd = &ring.commands[head & (MIX_RING_SIZE - 1)];
+	cmd->id 	= (short) id;
+	cmd->volume = (short) volume;
+	cmd->gain 	= (short) ((volume * top * 256) / (100 * 100));
+	cmd->pan 	= (short) pan;
+	cmd->start 	= __atomic_load_n(&mixClock, __ATOMIC_RELAXED);
+
+	/* The mixer may only see the command once it is all written */
+	__atomic_store_n(&ring.head, head + 1, __ATOMIC_RELEASE);
+
+	return True;
+}
+
+
+/**
+ * Empties the ring into voices. Mixer thread only.
+ *
+ */
+static void StartQueuedSounds(void)
+{
+	soundCommand *cmd;
+	mixSample *s;
+	mixVoice *v;
+	unsigned int tail = ring.tail;
+	unsigned int head = __atomic_load_n(&ring.head, __ATOMIC_ACQUIRE);
+	unsigned long stale = (unsigned long) deviceRate * MIX_STALE_MSEC / 1000;
+
+	for (; tail != head; tail++)
+	{
+		cmd = &ring.commands[tail & (MIX_RING_SIZE - 1)];
+
+		/* Held up so long it would no longer match what is on screen */
+		if (mixClock - cmd->start > stale)
+		{
+			voicesLate++;
+			continue;
+		}
+
+		if ((v = ChooseVoice(cmd->volume)) == NULL)
+			continue;
+
+		s = &samples[cmd->id];
+
+		v->pos 		= 0UL;
+		v->step 	= ((unsigned long) s->rate << 16) / deviceRate;
+		v->priority = cmd->volume;
+		v->started 	= voicesStarted++;
+		v->sample 	= s;
+
+		/* Mono hears the full volume, stereo turns one side down */
+		v->gain[0] = v->gain[1] = cmd->gain;
+		if (deviceChannels == 2 && cmd->pan > MIX_PAN_CENTRE)
+			v->gain[0] = cmd->gain * (MIX_PAN_RIGHT - cmd->pan) / MIX_PAN_RIGHT;
+		else if (deviceChannels == 2 && cmd->pan < MIX_PAN_CENTRE)
+			v->gain[1] = cmd->gain * (cmd->pan - MIX_PAN_LEFT) / MIX_PAN_RIGHT;
+	}
+
+	/* Hands the slots back to the game thread */
+	__atomic_store_n(&ring.tail, tail, __ATOMIC_RELEASE);
+}
+
+
+int SetUpAudioSystem(Display *display)
+{
+	char *env;
+
+	if (__atomic_load_n(&mixerRunning, __ATOMIC_ACQUIRE) == True)
+		return True;
+
+	if ((env = getenv("XBOING_SOUND_VOICES")) != NULL)
+	{
+		numVoices = atoi(env);
+		if (numVoices < 1) 				numVoices = 1;
+		if (numVoices > MIX_MAX_VOICES) numVoices = MIX_MAX_VOICES;
+	}
+
+	if (LoadSamples() == False || OpenMixerDevice() == False)
+	{
+		FreeAudioSystem();
+		return False;
+	}
+
+	memset(voices, 0, sizeof(voices));
+	ring.head 	= ring.tail = 0;
+	mixClock 	= 0UL;
+	__atomic_store_n(&mixerRunning, True, __ATOMIC_RELEASE);
+
+	if (pthread_create(&mixer, NULL, MixerThread, NULL))
+	{
+		ErrorMessage("Cannot start the sound mixer thread.");
+		__atomic_store_n(&mixerRunning, False, __ATOMIC_RELEASE);
+		FreeAudioSystem();
+		return False;
+	}
+
+	return True;
+}
+
+void FreeAudioSystem(void)
+{
+	int i;
+
+	/* The thread sees the flag within one fragment */
+	if (__atomic_load_n(&mixerRunning, __ATOMIC_ACQUIRE) == True)
+	{
+		__atomic_store_n(&mixerRunning, False, __ATOMIC_RELEASE);
+		pthread_join(mixer, NULL);
+	}
+
+	if (dspFd >= 0)
+	{
+		/* Throw away whatever is still queued */
+		ioctl(dspFd, SNDCTL_DSP_RESET, 0);
+		close(dspFd);
+		dspFd = -1;
+	}
+
+	for (i = 0; i < NUM_SOUNDS; i++)
+	{
+		if (samples[i].pcm != NULL && samples[i].packed == False)
+			free(samples[i].pcm);
+
+		samples[i].pcm = NULL;
+	}
+
+	numSamples = 0;
+
+	if (debug == True)
+	{
+		sprintf(errorString, 
+			"Sounds played %lu, dropped %lu, cut short %lu, late %lu.",
+			voicesStarted, voicesDropped, voicesStolen, voicesLate);
+		NormalMessage(errorString);
+		sprintf(errorString, "Sounds lost to a full queue %lu.", ringOverflows);
+		NormalMessage(errorString);
+	}
+}
+
+void setNewVolume(unsigned int Volume)
+{
+	/* Do nothing here as volume is applied to each voice */
+}
+
+void audioDeviceEvents(void)
+{
+    /* None to do */
+}
+
+void playSoundFile(char *filename, int volume)
+{
+	startSound(GetSoundId(filename), volume);
+}
+
+void startSound(int id, int volume)
+{
+	mixSample *s;
+
+	if (__atomic_load_n(&mixerRunning, __ATOMIC_ACQUIRE) == False || 
+		id < 0 || id >= NUM_SOUNDS)
+		return;
+
+	s = &samples[id];
+	if (s->pcm == NULL || s->frames == 0)
+		return;
+
+	(void) QueueSound(id, volume, MIX_PAN_CENTRE);
+}
+
+void SetMaximumVolume(int Volume)
+{
+	if (Volume < 0) 	Volume = 0;
+	if (Volume > 100) 	Volume = 100;
+
+	maxVolume = Volume;
+}
+
+int GetMaximumVolume(void)
+{
+    return maxVolume;
+}
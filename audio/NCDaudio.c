@@ -218,6 +218,15 @@ void playSoundFile(char *filename, int volume)
     audioDevicePlay(sound_table[i].filename, volume, &sound_table[i].private);
 }
 
+void startSound(int id, int volume)
+{
+	char *name;
+
+	/* Sounds are played from their files here so go by name */
+	if ((name = GetSoundName(id)) != NULL)
+		playSoundFile(name, volume);
+}
+
 void SetMaximumVolume(int Volume)
 {
 }
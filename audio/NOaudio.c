@@ -87,6 +87,11 @@ void playSoundFile(char *filename, int volume)
 	/* Do nothing here as we don't have audio support */
 }
 
+void startSound(int id, int volume)
+{
+	/* Do nothing here as we don't have audio support */
+}
+
 void audioDeviceEvents(void)
 {
     /* None to do */
@@ -176,6 +176,15 @@ void playSoundFile(char *filename, int volume)
     }
 }
 
+void startSound(int id, int volume)
+{
+	char *name;
+
+	/* Sounds are played from their files here so go by name */
+	if ((name = GetSoundName(id)) != NULL)
+		playSoundFile(name, volume);
+}
+
 void SetMaximumVolume(int Volume)
 {
 }
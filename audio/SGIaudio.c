@@ -289,6 +289,15 @@ void playSoundFile(char *filename, int volume)
     fclose(theFile);
 }
 
+void startSound(int id, int volume)
+{
+	char *name;
+
+	/* Sounds are played from their files here so go by name */
+	if ((name = GetSoundName(id)) != NULL)
+		playSoundFile(name, volume);
+}
+
 void audioDeviceEvents(void)
 {
     /* None to do */
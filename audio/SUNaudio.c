@@ -326,6 +326,15 @@ closeinput:
 	(void) close(ifd);
 }
 
+void startSound(int id, int volume)
+{
+	char *name;
+
+	/* Sounds are played from their files here so go by name */
+	if ((name = GetSoundName(id)) != NULL)
+		playSoundFile(name, volume);
+}
+
 void audioDeviceEvents(void)
 {
 	/* None to do */
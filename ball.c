@@ -102,6 +102,9 @@
 #include "include/mess.h"
 #include "include/special.h"
 #include "include/ball.h"
+#include "include/simclock.h"
+#include "include/rng.h"
+#include "include/atlas.h"
 #include "include/faketypes.h"
 
 /*
@@ -133,6 +136,20 @@
 #define MINFLOAT ((float)1.40129846432481707e-45)
 #endif
 
+/* What stopped a swept ball - see SweepABall() */
+#define SWEEP_NONE			0
+#define SWEEP_LEFT_WALL		1
+#define SWEEP_RIGHT_WALL	2
+#define SWEEP_TOP_WALL		3
+#define SWEEP_PADDLE		4
+#define SWEEP_BLOCK			5
+
+/* tan(22.5 degrees) - corner hits steeper than this bounce one way only */
+#define CORNER_SLOPE		0.4142f
+
+/* Larger than any time of impact within a single frame */
+#define SWEEP_NEVER			1.0e30f
+
 
 /*
  *  Internal type declarations:
@@ -145,15 +162,24 @@ static void MoveBallBirth(Display *display, Window window, int x, int y,
 static void TeleportBall(Display *display, Window window, int i);
 static int BallHitPaddle(Display *display, Window window, int *hit, int i,
 	int *x, int *y);
+static void BounceOffPaddle(Display *display, int hitPos, int i);
+static void SetBallSpeed(int i);
 static void UpdateABall(Display *display, Window window, int i);
+static void CheckBallToBall(Display *display, Window window, int i);
 static int CheckRegions(Display *display, Window window, int row, int col,
 	int x, int y, int i);
 static int CheckForCollision(Display *display, Window window, int x, int y, 
 	int *r, int *c, int i);
+static int SideFromNormal(float nx, float ny);
+static float SweepCircleBlock(int row, int col, float x, float y, float vx,
+	float vy, float tmax, int *side);
+static int SweepBlockGrid(float x, float y, float vx, float vy, float tmax,
+	float *toi, int *r, int *c);
+static int FilterBlockSides(int row, int col, int side, float vx, float vy);
+static int SweepABall(Display *display, Window window, int i);
 static void updateBallVariables(int i);
 static void SetBallWait(enum BallStates newMode, int waitFrame, int i);
 static void DoBallWait(int i);
-static void EraseTheBall(Display *display, Window window, int x, int y);
 static void ChangeBallDirectionToGuide(int i);
 static void Ball2BallCollision(BALL *ball1, BALL *ball2);
 static int WhenBallsCollide(BALL *ball1, BALL *ball2, float *time);
@@ -167,170 +193,71 @@ typedef struct
  *  Internal variable declarations:
  */
 
-static Pixmap ballsPixmap[BALL_SLIDES];
-static Pixmap ballsMask[BALL_SLIDES];
-static Pixmap ballBirthPixmap[BIRTH_SLIDES];
-static Pixmap ballBirthMask[BIRTH_SLIDES];
-static Pixmap guides[11];
-static Pixmap guidesM[11];
+static int ballsSprite[BALL_SLIDES];
+static int ballBirthSprite[BIRTH_SLIDES];
+static int guides[11];
 BALL balls[MAX_BALLS];
 static int guidePos = 6;	 /* Start in middle of guider */
+static int collisionMode = COLLIDE_STEP;
+
+/* Work counters read by the physics benchmark, see GetBallStats() */
+static unsigned long ballUpdates = 0UL;
+static unsigned long collisionQueries = 0UL;
 
 /* global constant machine epsilon */
 float MACHINE_EPS;
 
+#ifndef HEADLESS
 void InitialiseBall(Display *display, Window window, Colormap colormap)
 {
 	/*
-	 * Read and create all the animation frames for the balls and guides.
+	 * Look up all the animation frames for the balls and guides in the
+	 * sprite atlas.
 	 */
 
-    XpmAttributes   attributes;
-	int		    	XpmErrorStatus;
-
-    attributes.valuemask = XpmColormap;
-	attributes.colormap = colormap;
-
-	/* Create the xpm pixmap ball frames */
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, ball1_xpm,
-		&ballsPixmap[0], &ballsMask[0], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBall(ball1)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, ball2_xpm,
-		&ballsPixmap[1], &ballsMask[1], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBall(ball2)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, ball3_xpm,
-		&ballsPixmap[2], &ballsMask[2], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBall(ball3)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, ball4_xpm,
-		&ballsPixmap[3], &ballsMask[3], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBall(ball4)");
+	char name[20];
+	int i;
 
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, killer_xpm,
-		&ballsPixmap[4], &ballsMask[4], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBall(killer)");
+	/* Look up the ball frames in the sprite atlas */
+	ballsSprite[0] = GetSprite("balls/ball1");
+	ballsSprite[1] = GetSprite("balls/ball2");
+	ballsSprite[2] = GetSprite("balls/ball3");
+	ballsSprite[3] = GetSprite("balls/ball4");
+	ballsSprite[4] = GetSprite("balls/killer");
 
 	/* Ball birth sequence */
+	for (i = 0; i < BIRTH_SLIDES; i++)
+	{
+		sprintf(name, "balls/bbirth%d", i + 1);
+		ballBirthSprite[i] = GetSprite(name);
+	}
 
-	/* Create the xpm pixmap ball birth frames */
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, ballbirth1_xpm,
-		&ballBirthPixmap[0], &ballBirthMask[0], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBall(ballbirth1)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, ballbirth2_xpm,
-		&ballBirthPixmap[1], &ballBirthMask[1], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBall(ballbirth2)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, ballbirth3_xpm,
-		&ballBirthPixmap[2], &ballBirthMask[2], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBall(ballbirth3)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, ballbirth4_xpm,
-		&ballBirthPixmap[3], &ballBirthMask[3], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBall(ballbirth4)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, ballbirth5_xpm,
-		&ballBirthPixmap[4], &ballBirthMask[4], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBall(ballbirth5)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, ballbirth6_xpm,
-		&ballBirthPixmap[5], &ballBirthMask[5], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBall(ballbirth6)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, ballbirth7_xpm,
-		&ballBirthPixmap[6], &ballBirthMask[6], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBall(ballbirth7)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, ballbirth8_xpm,
-		&ballBirthPixmap[7], &ballBirthMask[7], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBall(ballbirth8)");
-
-	/* Now load in the guide pixmaps */
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, guide1_xpm,
-		&guides[0], &guidesM[0], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBall(guide1)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, guide2_xpm,
-		&guides[1], &guidesM[1], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBall(guide2)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, guide3_xpm,
-		&guides[2], &guidesM[2], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBall(guide3)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, guide4_xpm,
-		&guides[3], &guidesM[3], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBall(guide4)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, guide5_xpm,
-		&guides[4], &guidesM[4], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBall(guide5)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, guide6_xpm,
-		&guides[5], &guidesM[5], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBall(guide6)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, guide7_xpm,
-		&guides[6], &guidesM[6], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBall(guide7)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, guide8_xpm,
-		&guides[7], &guidesM[7], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBall(guide8)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, guide9_xpm,
-		&guides[8], &guidesM[8], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBall(guide9)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, guide10_xpm,
-		&guides[9], &guidesM[9], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBall(guide10)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, guide11_xpm,
-		&guides[10], &guidesM[10], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBall(guide11)");
-
-	/* Free the xpm pixmap attributes */
-	XpmFreeAttributes(&attributes);
+	/* Now the guide frames */
+	for (i = 0; i < 11; i++)
+	{
+		sprintf(name, "guides/guide%d", i + 1);
+		guides[i] = GetSprite(name);
+	}
 
 	MACHINE_EPS = sqrt(MINFLOAT);
 
 	/* Make sure that all the balls are initialised */
 	ClearAllBalls();
 }
+#endif
 
 void FreeBall(Display *display)
 {
 	/*
-	 * Free all the animation frames for the balls and guides etc.
+	 * The ball, birth and guide frames all live in the sprite atlas and
+	 * are freed with it, see FreeAtlas(). Just forget the handles.
 	 */
 
 	int i;
 
-	/* Free all animation frames for the ball */
-	for (i = 0; i < BALL_SLIDES; i++)
-	{
-		if (ballsPixmap[i]) 	XFreePixmap(display, ballsPixmap[i]);
-	 	if (ballsMask[i]) 		XFreePixmap(display, ballsMask[i]);
-	}
-
-	/* Free all animation frames for the guides */
-	for (i = 0; i < 11; i++)
-	{
-		if (guides[i]) 	XFreePixmap(display, guides[i]);
-	 	if (guidesM[i]) XFreePixmap(display, guidesM[i]);
-	}
-
-	/* Free all animation frames for the ball birth */
-	for (i = 0; i < BIRTH_SLIDES; i++)
-	{
-		/* Free the ball birth animation pixmaps */
-		if (ballBirthPixmap[i]) 	XFreePixmap(display, ballBirthPixmap[i]);
-	 	if (ballBirthMask[i]) 		XFreePixmap(display, ballBirthMask[i]);
-	}
+	for (i = 0; i < BALL_SLIDES; i++)	ballsSprite[i] = SPRITE_NONE;
+	for (i = 0; i < BIRTH_SLIDES; i++)	ballBirthSprite[i] = SPRITE_NONE;
+	for (i = 0; i < 11; i++)			guides[i] = SPRITE_NONE;
 }
 
 void RedrawBall(Display *display, Window window)
@@ -338,7 +265,7 @@ void RedrawBall(Display *display, Window window)
 	/* not hard - STILL TO BE IMPLEMENTED */
 }
 
-static void EraseTheBall(Display *display, Window window, int x, int y)
+void EraseTheBall(Display *display, Window window, int x, int y)
 {
 	/* 
 	 * Clear the ball area! The x, y coordinates are the centre of ball 
@@ -355,8 +282,7 @@ void DrawTheBall(Display *display, Window window, int x, int y, int slide)
 	 * of the ball animation. The x,y are the centre of the ball.
 	 */
 
-    RenderShape(display, window, ballsPixmap[slide], ballsMask[slide],
-		x - BALL_WC, y - BALL_HC, BALL_WIDTH, BALL_HEIGHT, False);
+    DrawSprite(ballsSprite[slide], x - BALL_WC, y - BALL_HC);
 }
 
 void DrawTheBallBirth(Display *display, Window window, int x, int y, int slide)
@@ -366,8 +292,7 @@ void DrawTheBallBirth(Display *display, Window window, int x, int y, int slide)
 	 * of the ball animation. The x,y are the centre of the ball birth anim.
 	 */
 
-    RenderShape(display, window, ballBirthPixmap[slide], ballBirthMask[slide],
-		x - BALL_WC, y - BALL_HC, BALL_WIDTH, BALL_HEIGHT, False);
+    DrawSprite(ballBirthSprite[slide], x - BALL_WC, y - BALL_HC);
 }
 
 static void MoveBallBirth(Display *display, Window window, int x, int y, 
@@ -402,26 +327,14 @@ static void MoveBall(Display *display, Window window, int x, int y, int replace,
 	 * Move the ball from one position to the next and also update the
 	 * balls old positions. Will only move if the frame is correct for
 	 * this move, ie: framrate. Ball animates as well - hard to see though.
+	 * The ball is drawn at its old position once a frame from the game
+	 * snapshot, see RenderSnapshot().
 	 */
 
-	if (replace)
-		EraseTheBall(display, window, balls[i].oldx, balls[i].oldy);
-
 	/* Update the old position of this ball */
 	balls[i].oldx = x;
 	balls[i].oldy = y;
 
-	if (Killer == True)
-	{
-		/* Render the killer ball now ie: red ball */
-		DrawTheBall(display, window, x, y, BALL_SLIDES-1);
-	}
-	else
-	{
-		/* Render the ball now */
-		DrawTheBall(display, window, x, y, balls[i].slide);
-	}	
-
 	/* Change slide for ball every n frames of animation */
 	if ((frame % BALL_ANIM_RATE) == 0)
 		balls[i].slide++;
@@ -457,8 +370,7 @@ static void MoveGuides(Display *display, Window window, int i, int remove)
 			ErrorMessage("Guidepos out of range.");
 
 		/* draw the guide pixmap */
-    	RenderShape(display, window, guides[guidePos], guidesM[guidePos],
-			oldgx - 14, oldgy - 6, 29, 12, False);
+    	DrawSprite(guides[guidePos], oldgx - 14, oldgy - 6);
 
 		/* Don't draw it ever frame */
 		if ((frame % (BALL_FRAME_RATE*8)) == 0)
@@ -480,13 +392,13 @@ void RandomiseBallVelocity(int i)
 	while (balls[i].dx == 0 || balls[i].dy == 0)
 	{
 		/* Randomise the ball btwn [3, MAX_VEL] */
-   	 	balls[i].dx = (rand() % (MAX_X_VEL - 3)) + 3;
-   	 	balls[i].dy = (rand() % (MAX_Y_VEL - 3)) + 3;
+   	 	balls[i].dx = (GameRandom(RNG_BALL) % (MAX_X_VEL - 3)) + 3;
+   	 	balls[i].dy = (GameRandom(RNG_BALL) % (MAX_Y_VEL - 3)) + 3;
 
 		/* Make it possible for negative numbers */
-		if ((rand() % 10) < 5)
+		if ((GameRandom(RNG_BALL) % 10) < 5)
 			balls[i].dx *= -1;
-		if ((rand() % 10) < 5)
+		if ((GameRandom(RNG_BALL) % 10) < 5)
 			balls[i].dy *= -1;
 
 		balls[i].lastPaddleHitFrame = frame + PADDLE_BALL_FRAME_TILT;
@@ -522,7 +434,6 @@ static void TeleportBall(Display *display, Window window, int i)
 
 	int r1, c1, s1, r2, c2, s2, r3, c3, s3, r4, c4, s4;
     int r, c, x, y;
-    struct aBlock *blockP, *bP;
 	int done = False;
 	int count = 0;
 
@@ -532,18 +443,9 @@ static void TeleportBall(Display *display, Window window, int i)
 		/* Stop this going on forever */
 		count++;
 
-		/* Give me a new random block position */
-		r = (rand() % (MAX_ROW - 6)) + 1;
-		c = (rand() % MAX_COL) + 1;
-
-    	if (r < 0 || r >= MAX_ROW) continue;
-    	if (c < 0 || c >= MAX_COL) continue;
-
-		/* Pointer to the correct block we need - speed things up */
-		blockP = &blocks[r][c];
-
-		/* Check that the block is not occupied and not exploding */
-		if ((blockP->occupied == False) && (blockP->exploding == False))
+		/* Give me a random block position not occupied and not exploding */
+		if (PickRandomFreeBlock(1, MAX_ROW - 6, 1, MAX_COL - 1, &r, &c) 
+			== True)
 		{
         	/* Check that the block is not a closed in position */
 
@@ -552,8 +454,7 @@ static void TeleportBall(Display *display, Window window, int i)
             if (c1 < 0 || c1 >= MAX_COL) s1 = 1;
             if (s1 == 0) 
 			{
-            	bP = &blocks[r1][c1];
-                if (bP->blockType == BLACK_BLK)
+                if (GetBlockType(r1, c1) == BLACK_BLK)
                 s1 = 1;
             }
 
@@ -562,8 +463,7 @@ static void TeleportBall(Display *display, Window window, int i)
             if (c2 < 0 || c2 >= MAX_COL) s2 = 1;
             if (s2 == 0) 
 			{
-                bP = &blocks[r2][c2];
-                if (bP->blockType == BLACK_BLK)
+                if (GetBlockType(r2, c2) == BLACK_BLK)
                     s2 = 1;
             }
 
@@ -572,8 +472,7 @@ static void TeleportBall(Display *display, Window window, int i)
             if (c3 < 0 || c3 >= MAX_COL) s3 = 1;
             if (s3 == 0) 
 			{
-                bP = &blocks[r3][c3];
-                if (bP->blockType == BLACK_BLK)
+                if (GetBlockType(r3, c3) == BLACK_BLK)
                     s3 = 1;
             }
 
@@ -582,8 +481,7 @@ static void TeleportBall(Display *display, Window window, int i)
             if (c4 < 0 || c4 >= MAX_COL) s4 = 1;
             if (s4 == 0) 
 			{
-                bP = &blocks[r4][c4];
-                if (bP->blockType == BLACK_BLK)
+                if (GetBlockType(r4, c4) == BLACK_BLK)
                     s4 = 1;
             }
 
@@ -601,6 +499,10 @@ static void TeleportBall(Display *display, Window window, int i)
 			balls[i].ballx = x;
 			balls[i].bally = y;
 
+			/* Jump straight there - don't interpolate across the screen */
+			balls[i].prevx = x;
+			balls[i].prevy = y;
+
 			/* Move the ball to the new position */
 			MoveBall(display, window, x, y, True, i);
 
@@ -615,7 +517,8 @@ static void TeleportBall(Display *display, Window window, int i)
 		}
 		else
 		{
-			DEBUG("Looping in teleport function.");
+			/* Nowhere free to go so stop looking */
+			break;
 		}
 	}
 
@@ -684,6 +587,25 @@ void GetBallPosition(int *ballX, int *ballY, int i)
 	*ballY = balls[i].bally;
 }
 
+void GetBallRenderPosition(int *ballX, int *ballY, int i)
+{
+	/*
+	 * Get the position to draw ball i at between simulation ticks. The
+	 * ball only moves every BALL_FRAME_RATE frames so blend from where it
+	 * was before that move over the whole interval.
+	 */
+
+	float alpha;
+
+	alpha = ((float) (frame % BALL_FRAME_RATE) + SimAlpha()) / 
+		(float) BALL_FRAME_RATE;
+
+	*ballX = balls[i].prevx + 
+		(int) ((float) (balls[i].ballx - balls[i].prevx) * alpha);
+	*ballY = balls[i].prevy + 
+		(int) ((float) (balls[i].bally - balls[i].prevy) * alpha);
+}
+
 static int BallHitPaddle(Display *display, Window window, int *hit, int i,
 	int *x, int *y)
 {
@@ -793,9 +715,9 @@ static int HandleTheBlocks(Display *display, Window window, int row, int col,
 	blockP = &blocks[row][col];
 
 	/* There has been a collision so handle it */
-	if (blockP->exploding == False)
+	if (IsBlockExploding(row, col) == False)
 	{
-		switch (blockP->blockType)
+		switch (GetBlockType(row, col))
 		{
 			case COUNTER_BLK:
 				balls[i].lastPaddleHitFrame = frame + PADDLE_BALL_FRAME_TILT;
@@ -987,7 +909,7 @@ static int HandleTheBlocks(Display *display, Window window, int row, int col,
 				{
 					/* Redraw the solid wall block to make sure */
 					DrawBlock(display, window, row, col, BLACKHIT_BLK);
-					blockP->nextFrame = frame + 30;
+					ScheduleBlockTimer(row, col, TIMER_ANIMATE, frame + 30);
 				}
 					
 				break;
@@ -1008,6 +930,102 @@ static int HandleTheBlocks(Display *display, Window window, int row, int col,
 	return False;
 }
 
+static void BounceOffPaddle(Display *display, int hitPos, int i)
+{
+	/*
+	 * The ball has hit the paddle hitPos pixels from its centre. Score it
+	 * and send the ball back up at an angle that depends on where it hit
+	 * and how fast the paddle was moving.
+	 */
+
+	float Vs, Vx, Vy, alpha, beta, gamma, padSize;
+
+	/* Keep track of how long it was since the last paddle hit */
+	balls[i].lastPaddleHitFrame = frame + PADDLE_BALL_FRAME_TILT;
+	if (noSound == False) playSound(SND_PADDLE, 50);
+
+	/* Add a paddle hit bonus score, I'm nice ;-) */
+	AddToScore((u_long) PADDLE_HIT_SCORE);
+	DisplayScore(display, scoreWindow, score);
+
+	/* speed vector of the ball */
+	Vx = (float) balls[i].dx;    
+	Vy = (float) balls[i].dy;
+
+	/* speed intensity of the ball */
+	Vs = sqrt(Vx * Vx + Vy * Vy );
+
+	alpha = atan(Vx / -Vy);
+
+	padSize = (float) (GetPaddleSize() + BALL_WC);
+	Vx = (float) hitPos;
+	Vy = (float) padSize / 1.0;
+
+	beta = atan(Vx / Vy);
+	gamma = 2.0 * beta - alpha;
+
+	Vx = Vs * sin(gamma);
+	Vy = -Vs * cos(gamma);
+
+	/* take in account the horizontal speed of the paddle: 
+	 * vectorial summ 
+	 */
+	Vx += (float) (paddleDx / 10.0);
+
+	if (Vx > 0.0)
+		balls[i].dx = (int) (Vx + 0.5);
+	else
+		balls[i].dx = (int) (Vx - 0.5);
+
+	if (Vy < 0.0)
+		balls[i].dy = (int) (Vy - 0.5);
+	else
+		balls[i].dy = -MIN_DY_BALL;
+
+	if (balls[i].dy > -MIN_DY_BALL) 
+		balls[i].dy = -MIN_DY_BALL;
+}
+
+static void SetBallSpeed(int i)
+{
+	/*
+	 * Scale the ball's direction vector so that it moves at the speed
+	 * set by the current speed level, never letting dx or dy reach 0.
+	 */
+
+	float Vs, Vx, Vy, alpha, beta;
+
+	Vx = (float) balls[i].dx;
+	Vy = (float) balls[i].dy;
+	Vs = sqrt(Vx * Vx + Vy * Vy);
+
+	alpha = sqrt((float)MAX_X_VEL*(float)MAX_X_VEL + (float)MAX_Y_VEL*
+		(float)MAX_Y_VEL );
+	alpha /= 9.0; /* number of speed level */
+	alpha *= (float) speedLevel;
+	if (Vs == 0.0) Vs = 1.0;
+	beta = alpha / Vs;
+
+	Vx *= beta;
+	Vy *= beta;
+
+	if (Vx > 0.0)
+		balls[i].dx = (int) (Vx + 0.5);
+	else
+		balls[i].dx = (int) (Vx - 0.5);
+
+	if (Vy > 0.0)
+		balls[i].dy = (int) (Vy + 0.5);
+	else
+		balls[i].dy = (int) (Vy - 0.5);
+
+	if (balls[i].dy == 0) 
+		balls[i].dy = MIN_DY_BALL;
+
+	if (balls[i].dx == 0) 
+		balls[i].dx = MIN_DX_BALL;
+}
+
 static void UpdateABall(Display *display, Window window, int i)
 {
 	/*
@@ -1015,11 +1033,20 @@ static void UpdateABall(Display *display, Window window, int i)
 	 * and also bouce off all walls and blocks.
 	 */
 
-	int row, col, hitPos, ret, t;
+	int row, col, hitPos, ret;
 	int cx, cy, step, j, r, ddx, ddy, Hx, Hy;
 	float incx, incy, x, y;
-	float Vs, Vx, Vy, alpha, beta, gamma, padSize;
-	float dummy;
+
+	ballUpdates++;
+
+	/* Fast path - sweep the ball to its first hit instead of stepping */
+	if (collisionMode == COLLIDE_SWEPT)
+	{
+		if (SweepABall(display, window, i) == True)
+			CheckBallToBall(display, window, i);
+
+		return;
+	}
 
 	/* Update ball position using dx and dy values */	
 	balls[i].ballx = balls[i].oldx + balls[i].dx;
@@ -1033,7 +1060,7 @@ static void UpdateABall(Display *display, Window window, int i)
 	if (balls[i].ballx < BALL_WC && noWalls == False)
 	{
 		balls[i].dx = abs(balls[i].dx);
-		if (noSound == False) playSoundFile("boing", 10);
+		if (noSound == False) playSound(SND_BOING, 10);
 
 	} else if (noWalls == True && balls[i].ballx < BALL_WC)
 	{
@@ -1050,7 +1077,7 @@ static void UpdateABall(Display *display, Window window, int i)
 	if (balls[i].ballx > (PLAY_WIDTH - BALL_WC) && noWalls == False)
 	{
 		balls[i].dx = -(abs(balls[i].dx));
-		if (noSound == False) playSoundFile("boing", 10);
+		if (noSound == False) playSound(SND_BOING, 10);
 
 	} else if (noWalls == True && balls[i].ballx > (PLAY_WIDTH - BALL_WC))
 	{
@@ -1067,7 +1094,7 @@ static void UpdateABall(Display *display, Window window, int i)
 	if (balls[i].bally < BALL_HC) 
 	{
 		balls[i].dy = abs(balls[i].dy);
-		if (noSound == False) playSoundFile("boing", 10);
+		if (noSound == False) playSound(SND_BOING, 10);
 	}
 
 	if (balls[i].ballState != BALL_DIE)
@@ -1075,50 +1102,8 @@ static void UpdateABall(Display *display, Window window, int i)
 		/* Check if the ball has hit the paddle */
 		if (BallHitPaddle(display, window, &hitPos, i, &Hx, &Hy) == True)
 		{
-			/* Keep track of how long it was since the last paddle hit */
-			balls[i].lastPaddleHitFrame = frame + PADDLE_BALL_FRAME_TILT;
-			if (noSound == False) playSoundFile("paddle", 50);
-
-			/* Add a paddle hit bonus score, I'm nice ;-) */
-			AddToScore((u_long) PADDLE_HIT_SCORE);
-			DisplayScore(display, scoreWindow, score);
-
-			/* speed vector of the ball */
-           	Vx = (float) balls[i].dx;    
-           	Vy = (float) balls[i].dy;
-
-			/* speed intensity of the ball */
-           	Vs = sqrt(Vx * Vx + Vy * Vy );
-
-           	alpha = atan(Vx / -Vy);
-
-           	padSize = (float) (GetPaddleSize() + BALL_WC);
-           	Vx = (float) hitPos;
-           	Vy = (float) padSize / 1.0;
-
-           	beta = atan(Vx / Vy);
-           	gamma = 2.0 * beta - alpha;
-
-           	Vx = Vs * sin(gamma);
-           	Vy = -Vs * cos(gamma);
-
-			/* take in account the horizontal speed of the paddle: 
-			 * vectorial summ 
-			 */
-           	Vx += (float) (paddleDx / 10.0);
-
-           	if (Vx > 0.0)
-            	balls[i].dx = (int) (Vx + 0.5);
-           	else
-             	balls[i].dx = (int) (Vx - 0.5);
-
-           	if (Vy < 0.0)
-             	balls[i].dy = (int) (Vy - 0.5);
-           	else
-             	balls[i].dy = -MIN_DY_BALL;
-
-           	if (balls[i].dy > -MIN_DY_BALL) 
-				balls[i].dy = -MIN_DY_BALL;
+			/* Send the ball back up depending on where it hit */
+			BounceOffPaddle(display, hitPos, i);
 
            	balls[i].ballx = Hx;
            	balls[i].bally = Hy;
@@ -1150,35 +1135,8 @@ static void UpdateABall(Display *display, Window window, int i)
 				DoBoardTilt(display, i);
 		}
 
-       	Vx = (float) balls[i].dx;
-       	Vy = (float) balls[i].dy;
-       	Vs = sqrt(Vx * Vx + Vy * Vy);
-
-       	alpha = sqrt((float)MAX_X_VEL*(float)MAX_X_VEL + (float)MAX_Y_VEL*
-			(float)MAX_Y_VEL );
-       	alpha /= 9.0; /* number of speed level */
-       	alpha *= (float) speedLevel;
-		if (Vs == 0.0) Vs = 1.0;
-       	beta = alpha / Vs;
-
-       	Vx *= beta;
-       	Vy *= beta;
-
-       	if (Vx > 0.0)
-         	balls[i].dx = (int) (Vx + 0.5);
-       	else
-         	balls[i].dx = (int) (Vx - 0.5);
-
-       	if (Vy > 0.0)
-         	balls[i].dy = (int) (Vy + 0.5);
-       	else
-         	balls[i].dy = (int) (Vy - 0.5);
-
-       	if (balls[i].dy == 0) 
-			balls[i].dy = MIN_DY_BALL;
-
-       	if (balls[i].dx == 0) 
-			balls[i].dx = MIN_DX_BALL;
+		/* Keep the ball moving at the current speed level */
+		SetBallSpeed(i);
 	}
 
 	/* Has the player lost the ball of the bottom of the screen */
@@ -1229,7 +1187,7 @@ static void UpdateABall(Display *display, Window window, int i)
 				return;
 
 			ddx = ddy = 0;
-			r = (rand() >> 16) % 4;
+			r = (GameRandom(RNG_BALL) >> 16) % 4;
 
 			/* Find out which side the ball hit the brick */
 			switch (ret)
@@ -1285,8 +1243,8 @@ static void UpdateABall(Display *display, Window window, int i)
 
 
 			/* Update ball position using dx and dy values */	
-			balls[i].ballx = (int) x + balls[i].dx + ddx + 1 - rand() % 3;
-			balls[i].bally = (int) y + balls[i].dy + ddy + 1 - rand() % 3;
+			balls[i].ballx = (int) x + balls[i].dx + ddx + 1 - GameRandom(RNG_BALL) % 3;
+			balls[i].bally = (int) y + balls[i].dy + ddy + 1 - GameRandom(RNG_BALL) % 3;
 
 			break;
 		}
@@ -1299,6 +1257,20 @@ static void UpdateABall(Display *display, Window window, int i)
 	/* Move the ball to the new position */
 	MoveBall(display, window, balls[i].ballx, balls[i].bally, True, i);
 
+	/* Bounce off any other balls and the eyedude */
+	CheckBallToBall(display, window, i);
+}
+
+static void CheckBallToBall(Display *display, Window window, int i)
+{
+	/*
+	 * Check the ball just moved against all the other active balls and
+	 * rebound them if they collide. Also sees if the eyedude got hit.
+	 */
+
+	int t;
+	float dummy;
+
 	/* Loop all the balls checking for ball2ball collisions */
 	for (t = 0; t < MAX_BALLS; t++)
 	{
@@ -1313,7 +1285,7 @@ static void UpdateABall(Display *display, Window window, int i)
 				/* Ok collided - so rebound please */
 				Ball2BallCollision(&balls[i], &balls[t]);
 
-				if (noSound == False) playSoundFile("ball2ball", 90);
+				if (noSound == False) playSound(SND_BALL2BALL, 90);
 			}
 
 			/* Check if the ball has hit an eye dude */
@@ -1338,99 +1310,33 @@ static int CheckRegions(Display *display, Window window, int row, int col,
 	 * Returns the region hit or REGION_NONE.
 	 */
 
-    struct aBlock *blockP;
-	struct aBlock *blockPleft;
-	struct aBlock *blockPright;
-	struct aBlock *blockPtop;
-	struct aBlock *blockPbottom;
-
 	int region = REGION_NONE;
+	int hit, bx, by, bw, bh;
 
     if (row < 0 || row >= MAX_ROW) return REGION_NONE;
     if (col < 0 || col >= MAX_COL) return REGION_NONE;
 
-    blockP = &blocks[row][col];
-    blockPleft = &blocks[row][col-1];
-    blockPright = &blocks[row][col+1];
-    blockPtop = &blocks[row-1][col];
-    blockPbottom = &blocks[row+1][col];
-
     /* If blocks is occupied then check for collision */
-    if (blockP->occupied == 1 && blockP->exploding == False)
+    if (IsBlockSolid(row, col) == True)
     {
-        /* Suss out if ball is moving more vertically than horizontally */
-        if (abs(balls[i].dx) > abs(balls[i].dy))
-        {
-            /* Check left and right first as ball is moving more horizontal */
-
-            /* See if the ball intersects with the block's left region */
-            if (XRectInRegion(blockP->regionLeft, x - BALL_WC, y - BALL_HC,
-                BALL_WIDTH, BALL_HEIGHT) != RectangleOut)
-			{
-            	if (blockPleft->occupied == False)
-                	region |= REGION_LEFT;
-			}
+		GetBlockRect(row, col, &bx, &by, &bw, &bh);
 
-            /* See if the ball intersects with the block's right region */
-            if (XRectInRegion(blockP->regionRight, x - BALL_WC, y - BALL_HC,
-                BALL_WIDTH, BALL_HEIGHT) != RectangleOut)
-			{
-            	if (blockPright->occupied == False)
-                	region |= REGION_RIGHT;
-			}
+		/* Which of the four triangles does the ball rectangle touch */
+		hit = BlockRegionHit(bx, by, bw, bh, 
+			x - BALL_WC, y - BALL_HC, BALL_WIDTH, BALL_HEIGHT);
 
-            /* See if the ball intersects with the block's bottom region */
-            if (XRectInRegion(blockP->regionBottom, x - BALL_WC, y - BALL_HC,
-                BALL_WIDTH, BALL_HEIGHT) != RectangleOut)
-			{
-            	if (blockPbottom->occupied == False)
-                	region |= REGION_BOTTOM;
-			}
+		/* Only count a side if no block is sitting up against it */
+		if ((hit & REGION_LEFT) && IsBlockOccupied(row, col-1) == False)
+			region |= REGION_LEFT;
 
-            /* See if the ball intersects with the block's top region */
-            if (XRectInRegion(blockP->regionTop, x - BALL_WC, y - BALL_HC,
-                BALL_WIDTH, BALL_HEIGHT) != RectangleOut)
-			{
-            	if (blockPtop->occupied == False)
-                	region |= REGION_TOP;
-			}
-        }
-        else
-        {
-            /* Check top and bottom first as ball is moving more vertical */
-
-            /* See if the ball intersects with the block's bottom region */
-            if (XRectInRegion(blockP->regionBottom, x - BALL_WC, y - BALL_HC,
-                BALL_WIDTH, BALL_HEIGHT) != RectangleOut)
-			{
-            	if (blockPbottom->occupied == False)
-                	region |= REGION_BOTTOM;
-			}
+		if ((hit & REGION_RIGHT) && IsBlockOccupied(row, col+1) == False)
+			region |= REGION_RIGHT;
 
-            /* See if the ball intersects with the block's top region */
-            if (XRectInRegion(blockP->regionTop, x - BALL_WC, y - BALL_HC,
-                BALL_WIDTH, BALL_HEIGHT) != RectangleOut)
-			{
-            	if (blockPtop->occupied == False)
-                	region |= REGION_TOP;
-			}
+		if ((hit & REGION_BOTTOM) && IsBlockOccupied(row+1, col) == False)
+			region |= REGION_BOTTOM;
 
-            /* See if the ball intersects with the block's left region */
-            if (XRectInRegion(blockP->regionLeft, x - BALL_WC, y - BALL_HC,
-                BALL_WIDTH, BALL_HEIGHT) != RectangleOut)
-			{
-            	if (blockPleft->occupied == False)
-                	region |= REGION_LEFT;
-			}
-
-            /* See if the ball intersects with the block's right region */
-            if (XRectInRegion(blockP->regionRight, x - BALL_WC, y - BALL_HC,
-                BALL_WIDTH, BALL_HEIGHT) != RectangleOut)
-			{
-            	if (blockPright->occupied == False)
-                	region |= REGION_RIGHT;
-			}
-        }
+		if ((hit & REGION_TOP) && IsBlockOccupied(row-1, col) == False)
+			region |= REGION_TOP;
     }
 
 	/* Return the region combination */
@@ -1446,6 +1352,8 @@ static int CheckForCollision(Display *display, Window window, int x, int y,
 	 */
 	int ret, row, col;
 
+	collisionQueries++;
+
 	row = *r;
 	col = *c;
 
@@ -1481,6 +1389,464 @@ static int CheckForCollision(Display *display, Window window, int x, int y,
 	return ret;
 }
 
+static int SideFromNormal(float nx, float ny)
+{
+	/*
+	 * Turn the direction from a block corner to the ball centre into the
+	 * sides of the block that the ball should bounce off. Glancing corner
+	 * hits bounce off one side, square on ones off both.
+	 */
+
+	int side = REGION_NONE;
+
+	if (fabs(nx) > fabs(ny) * CORNER_SLOPE)
+		side |= (nx < 0.0) ? REGION_LEFT : REGION_RIGHT;
+
+	if (fabs(ny) > fabs(nx) * CORNER_SLOPE)
+		side |= (ny < 0.0) ? REGION_TOP : REGION_BOTTOM;
+
+	return side;
+}
+
+static float SweepCircleBlock(int row, int col, float x, float y, float vx,
+	float vy, float tmax, int *side)
+{
+	/*
+	 * Find when a ball at x,y moving vx,vy per frame first touches the
+	 * block at row,col. The ball is a circle of radius BALL_WC so it hits
+	 * when its centre enters the block grown by BALL_WC, with rounded
+	 * corners. Returns the time of impact in [0, tmax] and the sides hit,
+	 * or -1.0 if the block is not reached within tmax.
+	 */
+
+	float R = (float) BALL_WC;
+	float x0, y0, x1, y1, nx, ny, cx, cy, hx, hy;
+	float t1, t2, tEnter, tExit, a, b, c, disc;
+	int axis = 0, bx, by, bw, bh;
+
+	/* Only solid blocks get in the way */
+	if (IsBlockSolid(row, col) == False)
+		return -1.0;
+
+	GetBlockRect(row, col, &bx, &by, &bw, &bh);
+	x0 = (float) bx;
+	y0 = (float) by;
+	x1 = x0 + (float) bw;
+	y1 = y0 + (float) bh;
+
+	/* Already touching - only a hit if still heading into the block */
+	nx = x - ((x < x0) ? x0 : (x > x1) ? x1 : x);
+	ny = y - ((y < y0) ? y0 : (y > y1) ? y1 : y);
+	if (nx * nx + ny * ny < R * R)
+	{
+		if (nx == 0.0 && ny == 0.0)
+		{
+			/* Centre is inside the block - push out the nearest side */
+			nx = (x - x0 < x1 - x) ? -(x - x0) : (x1 - x);
+			ny = (y - y0 < y1 - y) ? -(y - y0) : (y1 - y);
+			if (fabs(nx) < fabs(ny)) ny = 0.0; else nx = 0.0;
+		}
+
+		if (nx * vx + ny * vy >= 0.0)
+			return -1.0;
+
+		*side = SideFromNormal(nx, ny);
+		return 0.0;
+	}
+
+	/* Slab test against the grown block */
+	tEnter = -SWEEP_NEVER;
+	tExit = tmax;
+
+	if (vx == 0.0)
+	{
+		if (x <= x0 - R || x >= x1 + R) return -1.0;
+	}
+	else
+	{
+		t1 = (x0 - R - x) / vx;
+		t2 = (x1 + R - x) / vx;
+		if (t1 > t2) { a = t1; t1 = t2; t2 = a; }
+		if (t1 > tEnter) { tEnter = t1; axis = 1; }
+		if (t2 < tExit) tExit = t2;
+	}
+
+	if (vy == 0.0)
+	{
+		if (y <= y0 - R || y >= y1 + R) return -1.0;
+	}
+	else
+	{
+		t1 = (y0 - R - y) / vy;
+		t2 = (y1 + R - y) / vy;
+		if (t1 > t2) { a = t1; t1 = t2; t2 = a; }
+		if (t1 > tEnter) { tEnter = t1; axis = 2; }
+		if (t2 < tExit) tExit = t2;
+	}
+
+	if (tEnter > tExit || tExit < 0.0 || tEnter > tmax)
+		return -1.0;
+
+	if (tEnter < 0.0) tEnter = 0.0;
+
+	hx = x + vx * tEnter;
+	hy = y + vy * tEnter;
+
+	/* Entering beside a corner so check against the rounded corner */
+	if ((hx < x0 || hx > x1) && (hy < y0 || hy > y1))
+	{
+		cx = (hx < x0) ? x0 : x1;
+		cy = (hy < y0) ? y0 : y1;
+
+		a = vx * vx + vy * vy;
+		b = (x - cx) * vx + (y - cy) * vy;
+		c = (x - cx) * (x - cx) + (y - cy) * (y - cy) - R * R;
+		disc = b * b - a * c;
+
+		if (a == 0.0 || disc < 0.0)
+			return -1.0;
+
+		t1 = (-b - sqrt(disc)) / a;
+		if (t1 < 0.0 || t1 > tmax)
+			return -1.0;
+
+		*side = SideFromNormal(x + vx * t1 - cx, y + vy * t1 - cy);
+		return t1;
+	}
+
+	/* Flat side of the block */
+	if (axis == 1)
+		*side = (vx > 0.0) ? REGION_LEFT : REGION_RIGHT;
+	else
+		*side = (vy > 0.0) ? REGION_TOP : REGION_BOTTOM;
+
+	return tEnter;
+}
+
+static int SweepBlockGrid(float x, float y, float vx, float vy, float tmax,
+	float *toi, int *r, int *c)
+{
+	/*
+	 * Walk the grid cells the ball centre passes through this frame, in
+	 * order, and find the first block the ball touches. The ball is
+	 * smaller than a cell so only the blocks around each cell are looked
+	 * at. Returns the sides hit with the time and block in toi, r and c,
+	 * or REGION_NONE if the path is clear up to tmax.
+	 */
+
+	int row, col, stepRow, stepCol, rr, cc, side, hit = REGION_NONE;
+	float tNextRow, tNextCol, tDeltaRow, tDeltaCol, tCell, t;
+	float best = SWEEP_NEVER;
+
+	collisionQueries++;
+
+	col = (int) floor(x / (float) colWidth);
+	row = (int) floor(y / (float) rowHeight);
+
+	/* Time to cross one cell and to reach the next cell boundary */
+	stepCol = (vx > 0.0) ? 1 : -1;
+	stepRow = (vy > 0.0) ? 1 : -1;
+
+	if (vx == 0.0)
+	{
+		tDeltaCol = SWEEP_NEVER;
+		tNextCol = SWEEP_NEVER;
+	}
+	else
+	{
+		tDeltaCol = (float) colWidth / fabs(vx);
+		tNextCol = ((float) ((vx > 0.0) ? col + 1 : col) * (float) colWidth 
+			- x) / vx;
+	}
+
+	if (vy == 0.0)
+	{
+		tDeltaRow = SWEEP_NEVER;
+		tNextRow = SWEEP_NEVER;
+	}
+	else
+	{
+		tDeltaRow = (float) rowHeight / fabs(vy);
+		tNextRow = ((float) ((vy > 0.0) ? row + 1 : row) * (float) rowHeight
+			- y) / vy;
+	}
+
+	for (;;)
+	{
+		/* Check the blocks in and around this cell */
+		for (rr = row - 1; rr <= row + 1; rr++)
+		{
+			if (rr < 0 || rr >= MAX_ROW) continue;
+
+			for (cc = col - 1; cc <= col + 1; cc++)
+			{
+				if (cc < 0 || cc >= MAX_COL) continue;
+
+				t = SweepCircleBlock(rr, cc, x, y, vx, vy, tmax, &side);
+				if (t >= 0.0 && t < best)
+				{
+					best = t;
+					hit = side;
+					*r = rr;
+					*c = cc;
+				}
+			}
+		}
+
+		/* Nothing later along the path can be hit any sooner */
+		tCell = MIN(tNextRow, tNextCol);
+		if (best <= tCell || tCell > tmax)
+			break;
+
+		/* Step into the next cell along the path */
+		if (tNextCol < tNextRow)
+		{
+			col += stepCol;
+			tNextCol += tDeltaCol;
+		}
+		else
+		{
+			row += stepRow;
+			tNextRow += tDeltaRow;
+		}
+	}
+
+	*toi = best;
+	return hit;
+}
+
+static int FilterBlockSides(int row, int col, int side, float vx, float vy)
+{
+	/*
+	 * Drop any side that has another block sitting up against it, just as
+	 * CheckRegions() does. If that leaves nothing the ball has clipped the
+	 * gap between two blocks so bounce it along the other axis instead.
+	 */
+
+	int keep = side;
+
+	if ((side & REGION_LEFT) && IsBlockOccupied(row, col-1) == True)
+		keep &= ~REGION_LEFT;
+
+	if ((side & REGION_RIGHT) && IsBlockOccupied(row, col+1) == True)
+		keep &= ~REGION_RIGHT;
+
+	if ((side & REGION_TOP) && IsBlockOccupied(row-1, col) == True)
+		keep &= ~REGION_TOP;
+
+	if ((side & REGION_BOTTOM) && IsBlockOccupied(row+1, col) == True)
+		keep &= ~REGION_BOTTOM;
+
+	if (keep == REGION_NONE)
+	{
+		if (side & (REGION_LEFT | REGION_RIGHT))
+			keep = (vy > 0.0) ? REGION_TOP : REGION_BOTTOM;
+		else
+			keep = (vx > 0.0) ? REGION_LEFT : REGION_RIGHT;
+	}
+
+	return keep;
+}
+
+static int SweepABall(Display *display, Window window, int i)
+{
+	/*
+	 * Swept collision version of UpdateABall(). Rather than stepping the
+	 * ball a pixel at a time it works out exactly when the ball first
+	 * touches a wall, the paddle or a block, moves it there, bounces and
+	 * carries on with the rest of the frame. Cost does not grow with the
+	 * ball speed and fast balls can't slip through block corners.
+	 *
+	 * Returns False if the ball was stopped, killed or teleported.
+	 */
+
+	float x, y, vx, vy, t, toi, remain, paddleLine, padHalf;
+	int event, side, row, col, bounces, hitPos;
+
+	/* Ball has not hit the paddle in ages so tilt the board */
+	if (balls[i].lastPaddleHitFrame <= frame)
+		DoBoardTilt(display, i);
+
+	if (balls[i].ballState != BALL_DIE)
+		SetBallSpeed(i);
+
+	/* The line the ball centre must cross to land on the paddle */
+	paddleLine = (float) (PLAY_HEIGHT - DIST_BASE - 2 - BALL_HC);
+
+	x = (float) balls[i].oldx;
+	y = (float) balls[i].oldy;
+	remain = 1.0;
+
+	for (bounces = 0; remain > 0.0 && bounces <= MAX_SWEPT_BOUNCES; bounces++)
+	{
+		vx = (float) balls[i].dx;
+		vy = (float) balls[i].dy;
+		event = SWEEP_NONE;
+		toi = remain;
+
+		/* Side walls bounce the ball, or wrap it if walls are off */
+		if (vx < 0.0 && x + vx * toi < (float) BALL_WC)
+		{
+			toi = MAX(((float) BALL_WC - x) / vx, 0.0);
+			event = SWEEP_LEFT_WALL;
+		}
+		else if (vx > 0.0 && x + vx * toi > (float) (PLAY_WIDTH - BALL_WC))
+		{
+			toi = MAX(((float) (PLAY_WIDTH - BALL_WC) - x) / vx, 0.0);
+			event = SWEEP_RIGHT_WALL;
+		}
+
+		if (vy < 0.0 && y + vy * toi < (float) BALL_HC)
+		{
+			toi = MAX(((float) BALL_HC - y) / vy, 0.0);
+			event = SWEEP_TOP_WALL;
+		}
+
+		/* Paddle only catches balls coming down onto it */
+		if (balls[i].ballState != BALL_DIE && vy > 0.0 && 
+			y <= paddleLine && y + vy * toi > paddleLine)
+		{
+			t = (paddleLine - y) / vy;
+			padHalf = (float) (GetPaddleSize() / 2 + BALL_WC);
+
+			if (x + vx * t > (float) paddlePos - padHalf &&
+				x + vx * t < (float) paddlePos + padHalf)
+			{
+				toi = t;
+				event = SWEEP_PADDLE;
+			}
+		}
+
+		/* Blocks along the way */
+		side = SweepBlockGrid(x, y, vx, vy, toi, &t, &row, &col);
+		if (side != REGION_NONE && t <= toi)
+		{
+			toi = t;
+			event = SWEEP_BLOCK;
+		}
+
+		/* Move up to whatever got hit first */
+		x += vx * toi;
+		y += vy * toi;
+		remain -= toi;
+
+		switch (event)
+		{
+			case SWEEP_LEFT_WALL:
+				if (noWalls == True)
+					x = (float) (PLAY_WIDTH - BALL_WC);
+				else
+				{
+					balls[i].dx = abs(balls[i].dx);
+					if (noSound == False) playSound(SND_BOING, 10);
+				}
+				break;
+
+			case SWEEP_RIGHT_WALL:
+				if (noWalls == True)
+					x = (float) BALL_WC;
+				else
+				{
+					balls[i].dx = -(abs(balls[i].dx));
+					if (noSound == False) playSound(SND_BOING, 10);
+				}
+				break;
+
+			case SWEEP_TOP_WALL:
+				balls[i].dy = abs(balls[i].dy);
+				if (noSound == False) playSound(SND_BOING, 10);
+				break;
+
+			case SWEEP_PADDLE:
+				hitPos = (int) (x + 0.5) - paddlePos;
+				BounceOffPaddle(display, hitPos, i);
+				SetBallSpeed(i);
+
+				/* Sticky paddle holds the ball until it is shot off again */
+				if (stickyBat == True)
+				{
+					balls[i].ballx = (int) (x + 0.5);
+					balls[i].bally = (int) paddleLine;
+					ChangeBallMode(BALL_READY, i);
+
+					MoveBall(display, window, 
+						balls[i].ballx, balls[i].bally, True, i);
+
+					/* So that it will auto shoot off if you wait too long */
+					balls[i].nextFrame = frame + BALL_AUTO_ACTIVE_DELAY;
+
+					return False;
+				}
+				break;
+
+			case SWEEP_BLOCK:
+				if (HandleTheBlocks(display, window, row, col, i) == True)
+				{
+					/* Killer ball ploughs on through the exploding block */
+					if (balls[i].ballState != BALL_ACTIVE ||
+						IsBlockExploding(row, col) == False)
+						return False;
+
+					break;
+				}
+
+				side = FilterBlockSides(row, col, side, vx, vy);
+
+				if (side & REGION_LEFT)		balls[i].dx = -(abs(balls[i].dx));
+				if (side & REGION_RIGHT)	balls[i].dx = abs(balls[i].dx);
+				if (side & REGION_TOP)		balls[i].dy = -(abs(balls[i].dy));
+				if (side & REGION_BOTTOM)	balls[i].dy = abs(balls[i].dy);
+				break;
+		}
+	}
+
+	balls[i].ballx = (int) floor(x + 0.5);
+	balls[i].bally = (int) floor(y + 0.5);
+
+	/* Mark the ball to die as it is past the paddle */
+	if (balls[i].bally > (PLAY_HEIGHT - DIST_BASE + BALL_HEIGHT))
+		ChangeBallMode(BALL_DIE, i);
+
+	/* Has the player lost the ball of the bottom of the screen */
+	if (balls[i].bally > (PLAY_HEIGHT + BALL_HEIGHT*2))
+	{
+		DEBUG("Ball lost off bottom.");
+
+		/* Make ball start to die */
+		ClearBallNow(display, window, i);
+		return False;
+	}
+
+	/* Move the ball to the new position */
+	MoveBall(display, window, balls[i].ballx, balls[i].bally, True, i);
+
+	return True;
+}
+
+void SetBallCollisionMode(int mode)
+{
+	/* COLLIDE_STEP is the classic pixel stepping, COLLIDE_SWEPT is swept */
+	collisionMode = mode;
+}
+
+int GetBallCollisionMode(void)
+{
+	return collisionMode;
+}
+
+void GetBallStats(unsigned long *updates, unsigned long *queries)
+{
+	/* Ball moves and block collision queries since the last reset */
+	*updates = ballUpdates;
+	*queries = collisionQueries;
+}
+
+void ResetBallStats(void)
+{
+	ballUpdates 		= 0UL;
+	collisionQueries 	= 0UL;
+}
+
 static int WhenBallsCollide(BALL *ball1, BALL *ball2, float *time)
 {
     /*
@@ -1907,7 +2273,7 @@ int AddANewBall(Display *display, int x, int y, int dx, int dy)
 			balls[i].dx 		= dx;
 			balls[i].dy 		= dy;
 			balls[i].ballState 	= BALL_CREATE;
-			balls[i].mass 		= (rand() % (int)MAX_BALL_MASS) + MIN_BALL_MASS;
+			balls[i].mass 		= (GameRandom(RNG_BALL) % (int)MAX_BALL_MASS) + MIN_BALL_MASS;
 			balls[i].slide 		= 0;
 			balls[i].nextFrame 	= frame + BIRTH_FRAME_RATE;
 
@@ -1940,6 +2306,8 @@ void ClearBall(int i)
 	balls[i].oldy 				= 0;
 	balls[i].ballx 				= 0;
 	balls[i].bally 				= 0;
+	balls[i].prevx 				= 0;
+	balls[i].prevy 				= 0;
 	balls[i].dx 				= 0;
 	balls[i].dy 				= 0;
 	balls[i].slide 				= 0;
@@ -1982,6 +2350,13 @@ void HandleBallMode(Display *display, Window window)
 		/* Only handle active balls - sounds disgusting! :-) */
 		if (balls[i].active == True)
 		{
+			/* Remember where it was for drawing in between ticks */
+			if ((frame % BALL_FRAME_RATE) == 0)
+			{
+				balls[i].prevx = balls[i].ballx;
+				balls[i].prevy = balls[i].bally;
+			}
+
 			/* Switch on the state of the ball */
 			switch (balls[i].ballState)
 			{
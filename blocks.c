@@ -50,6 +50,10 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stddef.h>
+#include <string.h>
+#ifndef HEADLESS
+#include <raylib.h>
+#endif
 
 /*
 // TODO: Remove instances of X11-associated data types
@@ -175,6 +179,8 @@
 #include "include/sfx.h"
 #include "include/file.h"
 #include "include/blocks.h"
+#include "include/rng.h"
+#include "include/atlas.h"
 #include "include/faketypes.h"
 
 /*
@@ -190,38 +196,41 @@
 
 static void CalculateBlockGeometry(int row, int col);
 static void SetBlockUpForExplosion(int row, int col, int frame);
+static int IsRequiredType(int blockType);
+static void SyncBlockCell(int row, int col);
+static int CountBits(BITBOARD *board);
+static int FindNthBit(BITBOARD *board, int n);
+static int *TimerDeadline(struct aBlock *blockP, int timer);
+static void CollectDueTimers(int timer);
+static int TakeDueTimer(int timer, int cell);
+static int NextDueCell(int timer1, int timer2, int first);
+static void RunBlockTimers(Display *display, Window window, int r, int c,
+	int animDue, int expireDue);
+static void HandlePendingBonuses(Display *display, Window window, int type, 
+	int r, int c);
+static void GetAnimatedCells(BITBOARD *board);
+static void RebuildBlockLayer(Display *display, Window window,
+	BITBOARD *animated);
+static void DrawAnimatedBlocks(Display *display, Window window,
+	BITBOARD *animated);
+static void FreeBlockLayer(void);
 
 /*
  *  Internal variable declarations:
  */
 
-static Pixmap	exredblock[3],		exredblockM[3];
-static Pixmap	extanblock[3],		extanblockM[3];
-Pixmap	exyellowblock[3],	exyellowblockM[3];
-static Pixmap	exgreenblock[3],	exgreenblockM[3];
-static Pixmap	exblueblock[3],		exblueblockM[3];
-static Pixmap	expurpleblock[3],	expurpleblockM[3];
-static Pixmap	exbombblock[3],		exbombblockM[3];
-static Pixmap	excounterblock[3],	excounterblockM[3];
-static Pixmap	exx2bonus[3],		exx2bonusM[3];
-static Pixmap	x2bonus[4],			x2bonusM[4];
-static Pixmap	x4bonus[4],			x4bonusM[4];
-static Pixmap	Bonus[4],			BonusM[4];
-static Pixmap	death[5],			deathM[5];
-static Pixmap	exdeath[5],			exdeathM[5];
-static Pixmap	counterblock[6],	counterblockM[6];
-static Pixmap	extraball[3],		extraballM[3];
-static Pixmap	roamer[5],			roamerM[5];
-
-static Pixmap	redblock, greenblock, blueblock, yellowblock, purpleblock;	
-static Pixmap	tanblock, blackblock, bombblock, revblock, 	hyperblock;
-static Pixmap	mgunblock, walloffblock, multiball, sticky, paddleshrink;
-static Pixmap	paddleexpand, unlimitammo, blackhit, timeblock, dynamite;
-
-static Pixmap	redblockM, greenblockM, blueblockM, yellowblockM, purpleblockM;	
-static Pixmap	tanblockM, blackblockM, bombblockM, revblockM, 	hyperblockM;
-static Pixmap	mgunblockM, walloffblockM, multiballM, stickyM, paddleshrinkM;
-static Pixmap	paddleexpandM, unlimitammoM, blackhitM, timeblockM, dynamiteM;
+/* Sprite atlas handles for every block frame, see InitialiseBlocks() */
+static int	exredblock[3], extanblock[3];
+int			exyellowblock[3];
+static int	exgreenblock[3], exblueblock[3], expurpleblock[3];
+static int	exbombblock[3], excounterblock[3], exx2bonus[3];
+static int	x2bonus[4], x4bonus[4], Bonus[4];
+static int	death[5], exdeath[5], counterblock[6], extraball[3], roamer[5];
+
+static int	redblock, greenblock, blueblock, yellowblock, purpleblock;	
+static int	tanblock, blackblock, bombblock, revblock, 	hyperblock;
+static int	mgunblock, walloffblock, multiball, sticky, paddleshrink;
+static int	paddleexpand, unlimitammo, blackhit, timeblock, dynamite;
 
 struct aBlock 		blocks[MAX_ROW][MAX_COL];
 struct blockInfo 	BlockInfo[MAX_BLOCKS];
@@ -229,403 +238,150 @@ int					blocksExploding = 0;
 int					rowHeight;
 int					colWidth;
 
-void InitialiseBlocks(Display *display, Window window, Colormap colormap)
-{
-	XpmAttributes   attributes;
-	int 			XpmErrorStatus;
-
-	attributes.valuemask = XpmColormap;
-	attributes.colormap = colormap;
-
-	/* Create all xpm pixmap blocks from the files */
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, redblock_xpm, 
-		&redblock, &redblockM, &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(red)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, blueblock_xpm, 
-		&blueblock, &blueblockM, &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(blue)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, greenblock_xpm, 
-		&greenblock, &greenblockM, &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(green)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, yellowblock_xpm, 
-		&yellowblock, &yellowblockM, &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(yellow)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, tanblock_xpm, 
-		&tanblock, &tanblockM, &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(tan)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, purpleblock_xpm, 
-		&purpleblock, &purpleblockM, &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(purple)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, blackblock_xpm, 
-		&blackblock, &blackblockM, &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(wall)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		blackhitblock_xpm, &blackhit, &blackhitM, &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(wallhit)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, bombblock_xpm, 
-		&bombblock, &bombblockM, &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(bomb)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, reverse_xpm, 
-		&revblock, &revblockM, &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(reverse)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, hyperspace_xpm, 
-		&hyperblock, &hyperblockM, &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(hyperspace)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, machinegun_xpm, 
-		&mgunblock, &mgunblockM, &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(machinegun)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, walloff_xpm, 
-		&walloffblock, &walloffblockM, &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(walloff)");
-
-	/* Explosion for yellow block */
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		exyellowblock1_xpm, &exyellowblock[0], &exyellowblockM[0], 
-		&attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(exyellow)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		exyellowblock2_xpm, &exyellowblock[1], &exyellowblockM[1], 
-		&attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(exyellow)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		exyellowblock3_xpm, &exyellowblock[2], &exyellowblockM[2], 
-		&attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(exyellow)");
-
-	/* Explosion for red block */
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, exredblock1_xpm, 
-		&exredblock[0], &exredblockM[0], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(exred)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, exredblock2_xpm, 
-		&exredblock[1], &exredblockM[1], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(exred)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, exredblock3_xpm, 
-		&exredblock[2], &exredblockM[2], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(exred)");
-
-	/* Explosion for green block */
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		exgreenblock1_xpm, &exgreenblock[0], &exgreenblockM[0], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(exgreen)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		exgreenblock2_xpm, &exgreenblock[1], &exgreenblockM[1], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(exgreen)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		exgreenblock3_xpm, &exgreenblock[2], &exgreenblockM[2], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(exgreen)");
-
-	/* Explosion for blue block */
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		exblueblock1_xpm, &exblueblock[0], &exblueblockM[0], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(exblue)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		exblueblock2_xpm, &exblueblock[1], &exblueblockM[1], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(exblue)");
+/* Bitboards over the block grid - kept up to date by SyncBlockCell() */
+static BITBOARD		occupiedBits;			/* Cells with a block in them */
+static BITBOARD		explodingBits;			/* Blocks blowing up */
+static BITBOARD		requiredBits;			/* Must go to finish the level */
+static BITBOARD		typeBits[MAX_BLOCKS];	/* One board per block type */
 
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		exblueblock3_xpm, &exblueblock[2], &exblueblockM[2], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(exblue)");
+/* Collision fields of every block - also kept by SyncBlockCell() */
+struct blockHot		hotBlocks;
 
-	/* Explosion for tan block */
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		extanblock1_xpm, &extanblock[0], &extanblockM[0], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(extan)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		extanblock2_xpm, &extanblock[1], &extanblockM[1], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(extan)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		extanblock3_xpm, &extanblock[2], &extanblockM[2], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(extan)");
-
-	/* Explosion for purple block */
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		expurpleblock1_xpm, &expurpleblock[0], &expurpleblockM[0], 
-		&attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(expurple)");
+/* 
+ * Timer wheel - a block timer due on frame f has its cell bit set in slot
+ * f & WHEEL_MASK until the wheel passes it, then in dueBits until it is
+ * handled. See ScheduleBlockTimer().
+ */
+static BITBOARD		timerWheel[NUM_BLOCK_TIMERS][WHEEL_SLOTS];
+static BITBOARD		dueBits[NUM_BLOCK_TIMERS];
+static int			wheelFrame[NUM_BLOCK_TIMERS];
 
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		expurpleblock2_xpm, &expurpleblock[1], &expurpleblockM[1], 
-		&attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(expurple)");
+/*
+ * Block layer - every block that is not animating is drawn once into an
+ * offscreen texture and only the cells in layerDirty are drawn again, so
+ * a frame costs one quad plus the animating blocks. See DrawBlockLayer().
+ */
+static BITBOARD		layerDirty;
+static int			layerDrawing = False;
+#ifndef HEADLESS
+static RenderTexture2D	blockLayer;
+static int				blockLayerLoaded = False;
+#endif
+
+#ifndef HEADLESS
+void InitialiseBlocks(Display *display, Window window, Colormap colormap)
+{
+	char name[24];
+	int i;
 
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		expurpleblock3_xpm, &expurpleblock[2], &expurpleblockM[2], 
-		&attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(expurple)");
+	/* Look up all the block sprites in the atlas */
+	redblock 		= GetSprite("blocks/redblk");
+	blueblock 		= GetSprite("blocks/blueblk");
+	greenblock 		= GetSprite("blocks/grnblk");
+	yellowblock 	= GetSprite("blocks/yellblk");
+	tanblock 		= GetSprite("blocks/tanblk");
+	purpleblock 	= GetSprite("blocks/purpblk");
+	blackblock 		= GetSprite("blocks/blakblk");
+	blackhit 		= GetSprite("blocks/blakblkH");
+	bombblock 		= GetSprite("blocks/bombblk");
+	revblock 		= GetSprite("blocks/reverse");
+	hyperblock 		= GetSprite("blocks/hypspc");
+	mgunblock 		= GetSprite("blocks/machgun");
+	walloffblock 	= GetSprite("blocks/walloff");
+
+	/* Explosions for the plain blocks, bomb, counter and bonus coins */
+	for (i = 0; i < 3; i++)
+	{
+		sprintf(name, "blockex/exyell%d", i + 1);
+		exyellowblock[i] = GetSprite(name);
 
-	/* Explosion for bomb block */
+		sprintf(name, "blockex/exred%d", i + 1);
+		exredblock[i] = GetSprite(name);
 
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		exbombblock1_xpm, &exbombblock[0], &exbombblockM[0], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(exbomb)");
+		sprintf(name, "blockex/exgren%d", i + 1);
+		exgreenblock[i] = GetSprite(name);
 
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		exbombblock2_xpm, &exbombblock[1], &exbombblockM[1], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(exbomb)");
+		sprintf(name, "blockex/exblue%d", i + 1);
+		exblueblock[i] = GetSprite(name);
 
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		exbombblock3_xpm, &exbombblock[2], &exbombblockM[2], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(exbomb)");
+		sprintf(name, "blockex/extan%d", i + 1);
+		extanblock[i] = GetSprite(name);
 
-	/* Explosion for counter block */
+		sprintf(name, "blockex/expurp%d", i + 1);
+		expurpleblock[i] = GetSprite(name);
 
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		excounterblock1_xpm, &excounterblock[0], &excounterblockM[0], 
-		&attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(excounter)");
+		sprintf(name, "blockex/exbomb%d", i + 1);
+		exbombblock[i] = GetSprite(name);
 
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		excounterblock2_xpm, &excounterblock[1], &excounterblockM[1], 
-		&attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(excounter)");
+		sprintf(name, "blockex/excnt%d", i + 1);
+		excounterblock[i] = GetSprite(name);
 
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		excounterblock3_xpm, &excounterblock[2], &excounterblockM[2], 
-		&attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(excounter)");
+		sprintf(name, "blockex/exx2bs%d", i + 1);
+		exx2bonus[i] = GetSprite(name);
+	}
 
 	/* countdown for counter block */
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		counterblock_xpm, &counterblock[0], &counterblockM[0], 
-		&attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(counter0)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		counterblock1_xpm, &counterblock[1], &counterblockM[1], 
-		&attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(counter1)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		counterblock2_xpm, &counterblock[2], &counterblockM[2], 
-		&attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(counter2)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		counterblock3_xpm, &counterblock[3], &counterblockM[3], 
-		&attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(counter3)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		counterblock4_xpm, &counterblock[4], &counterblockM[4], 
-		&attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(counter4)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		counterblock5_xpm, &counterblock[5], &counterblockM[5], 
-		&attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(counter5)");
+	counterblock[0] = GetSprite("blocks/cntblk");
+	for (i = 1; i < 6; i++)
+	{
+		sprintf(name, "blocks/cntblk%d", i);
+		counterblock[i] = GetSprite(name);
+	}
 
 	/* Bonus block stuff */
+	for (i = 0; i < 4; i++)
+	{
+		sprintf(name, "blocks/x2bonus%d", i + 1);
+		x2bonus[i] = GetSprite(name);
 
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		x2bonus1_xpm, &x2bonus[0], &x2bonusM[0], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(x2bonus1)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		x2bonus2_xpm, &x2bonus[1], &x2bonusM[1], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(x2bonus2)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		x2bonus3_xpm, &x2bonus[2], &x2bonusM[2], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(x2bonus3)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		x2bonus4_xpm, &x2bonus[3], &x2bonusM[3], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(x2bonus4)");
-
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		x4bonus1_xpm, &x4bonus[0], &x4bonusM[0], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(x4bonus1)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		x4bonus2_xpm, &x4bonus[1], &x4bonusM[1], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(x4bonus2)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		x4bonus3_xpm, &x4bonus[2], &x4bonusM[2], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(x4bonus3)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		x4bonus4_xpm, &x4bonus[3], &x4bonusM[3], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(x4bonus4)");
-
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		bonus1_xpm, &Bonus[0], &BonusM[0], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(bonus1)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		bonus2_xpm, &Bonus[1], &BonusM[1], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(bonus2)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		bonus3_xpm, &Bonus[2], &BonusM[2], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(bonus3)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		bonus4_xpm, &Bonus[3], &BonusM[3], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(bonus4)");
-
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		exx2bonus1_xpm, &exx2bonus[0], &exx2bonusM[0], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(exbonus)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		exx2bonus2_xpm, &exx2bonus[1], &exx2bonusM[1], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(exbonus)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		exx2bonus3_xpm, &exx2bonus[2], &exx2bonusM[2], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(exbonus)");
-
-	/* Death block initialisation */
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		death1_xpm, &death[0], &deathM[0], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(death)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		death2_xpm, &death[1], &deathM[1], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(death)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		death3_xpm, &death[2], &deathM[2], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(death)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		death4_xpm, &death[3], &deathM[3], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(death)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		death5_xpm, &death[4], &deathM[4], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(death)");
-
-	/* Death block explosion init */
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		exdeath1_xpm, &exdeath[0], &exdeathM[0], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(exdeath)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		exdeath2_xpm, &exdeath[1], &exdeathM[1], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(exdeath)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		exdeath3_xpm, &exdeath[2], &exdeathM[2], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(exdeath)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		exdeath4_xpm, &exdeath[3], &exdeathM[3], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(exdeath)");
-
-	/* Extra balll pixmaps */
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		xtraball_xpm, &extraball[0], &extraballM[0], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(extraball)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		xtraball2_xpm, &extraball[1], &extraballM[1], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(extraball)");
-
-	/* Multiple ball pixmap */
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		multiballblock_xpm, &multiball, &multiballM, &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(multiball)");
-
-	/* Sticky block */
+		sprintf(name, "blocks/x4bonus%d", i + 1);
+		x4bonus[i] = GetSprite(name);
 
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		stickyblock_xpm, &sticky, &stickyM, &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(sticky)");
+		sprintf(name, "blocks/bonus%d", i + 1);
+		Bonus[i] = GetSprite(name);
+	}
 
-	/* Dynamite block for blowing up all of a kind */
+	/* Death block and its explosion */
+	for (i = 0; i < 5; i++)
+	{
+		sprintf(name, "blocks/death%d", i + 1);
+		death[i] = GetSprite(name);
+	}
 
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		dynamite_xpm, &dynamite, &dynamiteM, &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(dynamite)");
+	for (i = 0; i < 4; i++)
+	{
+		sprintf(name, "blockex/exdeath%d", i + 1);
+		exdeath[i] = GetSprite(name);
+	}
 
-	/* Unlimited ammo block symbol */
+	/* Extra ball sprites */
+	extraball[0] 	= GetSprite("blocks/xtrabal");
+	extraball[1] 	= GetSprite("blocks/xtrabal2");
 
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		unlimitammo_xpm, &unlimitammo, &unlimitammoM, &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(unlimitammo)");
+	/* Multiple ball, sticky, dynamite and unlimited ammo blocks */
+	multiball 		= GetSprite("blocks/multibal");
+	sticky 			= GetSprite("blocks/stkyblk");
+	dynamite 		= GetSprite("blocks/dynamite");
+	unlimitammo 	= GetSprite("blocks/lotsammo");
 
 	/* paddle shrink and expand block */
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		paddleshrink_xpm, &paddleshrink, &paddleshrinkM, &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(paddleshrink)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		paddleexpand_xpm, &paddleexpand, &paddleexpandM, &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(paddleexpand)");
+	paddleshrink 	= GetSprite("blocks/padshrk");
+	paddleexpand 	= GetSprite("blocks/padexpn");
 
 	/* Frames for the roaming block */
+	roamer[0] 		= GetSprite("blocks/roamer");
+	roamer[1] 		= GetSprite("blocks/roamerL");
+	roamer[2] 		= GetSprite("blocks/roamerR");
+	roamer[3] 		= GetSprite("blocks/roamerU");
+	roamer[4] 		= GetSprite("blocks/roamerD");
 
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		roamer_xpm, &roamer[0], &roamerM[0], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(roamer)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		roamerL_xpm, &roamer[1], &roamerM[1], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(roamer1)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		roamerR_xpm, &roamer[2], &roamerM[2], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(roamer2)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		roamerU_xpm, &roamer[3], &roamerM[3], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(roamer3)");
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		roamerD_xpm, &roamer[4], &roamerM[4], &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(roamer4)");
-
-	/* Clock pixmap */
-
-	XpmErrorStatus = XpmCreatePixmapFromData(display, window, 
-		clock_xpm, &timeblock, &timeblockM, &attributes);
-	HandleXPMError(display, XpmErrorStatus, "InitialiseBlocks(timeblock)");
-
-	/* Free the xpm pixmap attributes */
-	XpmFreeAttributes(&attributes);
+	/* Clock sprite */
+	timeblock 		= GetSprite("blocks/clock");
 
 	/* IF A NEW BLOCK IS ADDED CHECK OUT THIS FUNCTION */
 	SetupBlockInfo();
 }
+#endif
 
 void SetupBlockInfo(void)
 {
@@ -792,15 +548,15 @@ void PlaySoundForBlock(int type)
 	switch (type)
 	{
 		case BOMB_BLK:		
-			playSoundFile("bomb", 50);
+			playSound(SND_BOMB, 50);
 			break;
 
 		case BULLET_BLK:
-			playSoundFile("ammo", 30);
+			playSound(SND_AMMO, 30);
 			break;
 
 		case MAXAMMO_BLK:
-			playSoundFile("ammo", 70);
+			playSound(SND_AMMO, 70);
 			break;
 
 		case RED_BLK:
@@ -812,65 +568,65 @@ void PlaySoundForBlock(int type)
 		case COUNTER_BLK:
 		case RANDOM_BLK:
 		case DROP_BLK:
-			playSoundFile("touch", 99);
+			playSound(SND_TOUCH, 99);
 			break;
 
 		case ROAMER_BLK:
-			playSoundFile("ouch", 99);
+			playSound(SND_OUCH, 99);
 			break;
 
 		case EXTRABALL_BLK:	
-			playSoundFile("ddloo", 99);
+			playSound(SND_DDLOO, 99);
 			break;
 
 		case MGUN_BLK:	
-			playSoundFile("mgun", 99);
+			playSound(SND_MGUN, 99);
 			break;
 
 		case WALLOFF_BLK:	
-			playSoundFile("wallsoff", 99);
+			playSound(SND_WALLSOFF, 99);
 			break;
 
 		case BONUSX2_BLK:	
 		case BONUSX4_BLK:	
 		case BONUS_BLK:	
-			playSoundFile("gate", 99);
+			playSound(SND_GATE, 99);
 			break;			
 			
 		case REVERSE_BLK:	
-			playSoundFile("warp", 99);
+			playSound(SND_WARP, 99);
 			break;
 
 		case PAD_SHRINK_BLK:
-			playSoundFile("wzzz2", 99);
+			playSound(SND_WZZZ2, 99);
 			break;
 
 		case PAD_EXPAND_BLK:
-			playSoundFile("wzzz", 99);
+			playSound(SND_WZZZ, 99);
 			break;
 
 		case MULTIBALL_BLK:
-			playSoundFile("spring", 80);
+			playSound(SND_SPRING, 80);
 			break;
 
 		case TIMER_BLK:
-			playSoundFile("bonus", 50);
+			playSound(SND_BONUS, 50);
 			break;
 
 		case STICKY_BLK:
-			playSoundFile("sticky", 90);
+			playSound(SND_STICKY, 90);
 			break;
 
 		case DEATH_BLK:	
-			playSoundFile("evillaugh", 99);
+			playSound(SND_EVILLAUGH, 99);
 			break;
 
 		case BLACK_BLK:		
-			playSoundFile("metal", 99);
+			playSound(SND_METAL, 99);
 			break;
 
 		case HYPERSPACE_BLK:
-			playSoundFile("hypspc", 99);
+			playSound(SND_HYPSPC, 99);
 			break;
 
 		case KILL_BLK:
@@ -893,59 +649,49 @@ void ExplodeBlockType(Display *display, Window window, int x, int y,
 	switch (type)
 	{
 		case BOMB_BLK:		/* Draw the bomb block explosion slide */
-			RenderShape(display, window, exbombblock[slide], 
-				exbombblockM[slide], x, y, 30, 30, True);
+			DrawSprite(exbombblock[slide], x, y);
 			break;
 
 		case MULTIBALL_BLK:
 		case RED_BLK:		/* Draw a red block explosion slide */
-			RenderShape(display, window, exredblock[slide], 
-				exredblockM[slide], x, y, 40, 20, True);
+			DrawSprite(exredblock[slide], x, y);
 			break;
 
 		case GREEN_BLK:		/* Draw a green block explosion slide */
 		case DROP_BLK:		/* Draw a drop block explosion slide */
-			RenderShape(display, window, exgreenblock[slide], 
-				exgreenblockM[slide], x, y, 40, 20, True);
+			DrawSprite(exgreenblock[slide], x, y);
 			break;
 
 		case BLUE_BLK:		/* Draw a blue block explosion slide */
-			RenderShape(display, window, exblueblock[slide], 
-				exblueblockM[slide], x, y, 40, 20, True);
+			DrawSprite(exblueblock[slide], x, y);
 			break;
 
 		case TAN_BLK:		/* Draw a tan block explosion slide */
-			RenderShape(display, window, extanblock[slide], 
-				extanblockM[slide], x, y, 40, 20, True);
+			DrawSprite(extanblock[slide], x, y);
 			break;
 
 		case PURPLE_BLK:	/* Draw a purple block explosion slide */
-			RenderShape(display, window, expurpleblock[slide], 
-				expurpleblockM[slide], x, y, 40, 20, True);
+			DrawSprite(expurpleblock[slide], x, y);
 			break;
 
 		case BULLET_BLK:	/* Draw a bullet block explosion slide */
 		case YELLOW_BLK:	/* Draw a yellow block explosion slide */
-			RenderShape(display, window, exyellowblock[slide], 
-				exyellowblockM[slide], x, y, 40, 20, True);
+			DrawSprite(exyellowblock[slide], x, y);
 			break;
 
 		case COUNTER_BLK:	/* Draw a counter block explosion slide */
-			RenderShape(display, window, excounterblock[slide], 
-				excounterblockM[slide], x, y, 40, 20, True);
+			DrawSprite(excounterblock[slide], x, y);
 			break;
 
 		case BONUS_BLK:		/* Draw a bonus coin block explosion slide */
 		case BONUSX4_BLK:	/* Draw a bonus x2 oin block explosion slide */
 		case BONUSX2_BLK:	/* Draw a bonus x4 coin block explosion slide */
 		case TIMER_BLK:		/* Draw a timer clock block explosion slide */
-			RenderShape(display, window, exx2bonus[slide], 
-				exx2bonusM[slide], x, y, 27, 27, True);
+			DrawSprite(exx2bonus[slide], x, y);
 			break;
 
 		case DEATH_BLK:		/* Draw a pirate death block explosion slide */
-			RenderShape(display, window, exdeath[slide], 
-				exdeathM[slide], x, y, 30, 30, True);
+			DrawSprite(exdeath[slide], x, y);
 			break;
 
 		case BLACK_BLK:		
@@ -1006,24 +752,22 @@ void ExplodeAllOfOneType(Display *display, Window window, int type)
 	 * passed to blow up ASAP. He he he.
 	 */
 
-    struct aBlock *blockP;
-	int r, c;
+	BITBOARD board;
+	unsigned long long bits;
+	int w, cell;
 
-	/* Check all blocks looking for a type we want */
-	for (r = 0; r < MAX_ROW; r++)
+	if (type < 0 || type >= MAX_BLOCKS) return;
+
+	/* Copy as exploding blocks can change the boards under us */
+	board = typeBits[type];
+
+	/* Every block of this type blows to bits */
+	for (w = 0; w < GRID_WORDS; w++)
 	{
-		for (c = 0; c < MAX_COL; c++)
+		for (bits = board.word[w]; bits != 0; bits &= bits - 1)
 		{
-			/* Pointer to the block we want */
-			blockP = &blocks[r][c];
-
-			/* Don't bother me if the block is not occupied */
-			if (blockP->occupied == True) 
-			{
-				/* Ok if it is the type then blow it to bits */
-				if (blockP->blockType == type)
-					SetBlockUpForExplosion(r, c, frame + 1);
-			}
+			cell = (w << 6) + __builtin_ctzll(bits);
+			SetBlockUpForExplosion(cell / MAX_COL, cell % MAX_COL, frame + 1);
 		}
 	}
 }
@@ -1036,42 +780,21 @@ void SetExplodeAllType(Display *display, Window window, int type)
 	 * it will draw the dynamite on it and adjust the flags appropriately.
 	 */
 
-	struct loc
-	{
-		int r, c;
-	} locations[MAX_ROW * MAX_COL];
-
     struct aBlock *blockP;
 	int r, c, count, theBlock;
 
-	/* Check all blocks looking for a type we want */
-	for (count = 0, r = 0; r < MAX_ROW; r++)
-	{
-		for (c = 0; c < MAX_COL; c++)
-		{
-			/* Pointer to the block we want */
-			blockP = &blocks[r][c];
+	if (type < 0 || type >= MAX_BLOCKS) return;
 
-			/* Don't bother me if the block is not occupied */
-			if (blockP->occupied == True) 
-			{
-				if (blockP->blockType == type)
-				{
-					locations[count].r = r;
-					locations[count].c = c;
-					count++;
-				}
-			}
-		}
-	}
+	/* How many blocks of this type are there */
+	count = CountBits(&typeBits[type]);
 
 	/* Are there any blocks to choose from? */
 	if (count > 0)
 	{
 		/* Choose a random block from our blocks found */
-		theBlock = rand() % count;
-		r = locations[theBlock].r;
-		c = locations[theBlock].c;
+		theBlock = FindNthBit(&typeBits[type], GameRandom(RNG_BLOCKS) % count);
+		r = theBlock / MAX_COL;
+		c = theBlock % MAX_COL;
 		blockP = &blocks[r][c];
 
 		/* Could be a good candiate for a dynamite */
@@ -1091,25 +814,21 @@ void AddSpecialBlock(Display *display, Window window, int *row, int *col,
     int r, c;
     struct aBlock *blockP;
 
-    /* Give me a new random block position */
-    r = (rand() % (MAX_ROW - 7)) + 1;
-    c = rand() % MAX_COL;
-
-    /* Pointer to the correct block we need - speed things up */
-    blockP = &blocks[r][c];
-
     /* 
-	 * Add a special in this block only if it isn't occupied and
-     * it isn't exploding.
+	 * Give me a random block position that isn't occupied and isn't
+     * exploding to add a special in.
      */
-    if ((blockP->occupied == False) && (blockP->explodeStartFrame == 0))
+    if (PickRandomFreeBlock(1, MAX_ROW - 7, 0, MAX_COL - 1, &r, &c) == True)
     {
+    	/* Pointer to the correct block we need - speed things up */
+    	blockP = &blocks[r][c];
+
         AddNewBlock(display, window, r, c, type, kill_shots, True);
 		bonusBlock = True;
 
         /* Setup the block structure for new block */
-        blockP->nextFrame       = frame + 1;
-        blockP->lastFrame       = frame + BONUS_LENGTH;
+        ScheduleBlockTimer(r, c, TIMER_ANIMATE, frame + 1);
+        ScheduleBlockTimer(r, c, TIMER_EXPIRE, frame + BONUS_LENGTH);
         blockP->bonusSlide      = 0;
         blockP->specialPopup    = True;
 
@@ -1125,23 +844,21 @@ void AddBonusBlock(Display *display, Window window, int *row, int *col,
 	int r, c;
 	struct aBlock *blockP;
 
-	/* Give me a new random block position */
-    r = (rand() % (MAX_ROW - 7)) + 1;
-	c = rand() % MAX_COL;
-
-	/* Pointer to the correct block we need - speed things up */
-	blockP = &blocks[r][c];
-
-	/* Add a bonus coin in this block only if it isn't occupied and 
-	 * it isn't exploding.
+	/* Give me a random block position that isn't occupied and isn't 
+	 * exploding to add a bonus coin in.
 	 */
-	if ((blockP->occupied == False) && (blockP->explodeStartFrame == 0))
+	if (PickRandomFreeBlock(1, MAX_ROW - 7, 0, MAX_COL - 1, &r, &c) == True)
 	{
+		/* Pointer to the correct block we need - speed things up */
+		blockP = &blocks[r][c];
+
 		AddNewBlock(display, window, r, c, type, 0, True);
 		bonusBlock = True;
 
-		/* Setup the block structure for new block */
-		blockP->nextFrame 		= frame + BONUS_DELAY;
+		/* Setup the block structure for new block - the coin only looks at
+		 * lastFrame when it turns so it needs no expiry timer.
+		 */
+		ScheduleBlockTimer(r, c, TIMER_ANIMATE, frame + BONUS_DELAY);
 		blockP->lastFrame 		= frame + BONUS_LENGTH;
 		blockP->bonusSlide 		= 3;
         blockP->specialPopup    = True;
@@ -1160,7 +877,7 @@ int GetRandomType(int blankBlock)
 	 * function in file.c
 	 */
 
-	switch (rand() % 8)
+	switch (GameRandom(RNG_BLOCKS) % 8)
 	{
 		case 0:
 			return RED_BLK;
@@ -1220,56 +937,49 @@ void HandlePendingSpecials(Display *display, Window window, int type,
 }
 
 
-void HandlePendingBonuses(Display *display, Window window, int type, 
+static void HandlePendingBonuses(Display *display, Window window, int type, 
 	int r, int c)
 {
+	/* Called when the animation timer of a bonus coin goes off */
 	struct aBlock *blockP;
 
 	blockP = &blocks[r][c];
 
-	if (blockP->nextFrame == frame) 
+	if (frame <= blockP->lastFrame)
 	{
-		if (frame <= blockP->lastFrame)
-		{
-			DEBUG("turning bonus coin block.")
+		DEBUG("turning bonus coin block.")
 
-			/* Advance to the next frame of animation */
-			DrawTheBlock(display, window, 
-				blockP->x, blockP->y, 
-				type, blockP->bonusSlide, r, c);
+		/* Advance to the next frame of animation */
+		DrawTheBlock(display, window, 
+			blockP->x, blockP->y, 
+			type, blockP->bonusSlide, r, c);
 
-				blockP->nextFrame = frame + BONUS_DELAY;
-				blockP->bonusSlide--;
+		ScheduleBlockTimer(r, c, TIMER_ANIMATE, frame + BONUS_DELAY);
+		blockP->bonusSlide--;
 
-				if (blockP->bonusSlide < 0)
-					blockP->bonusSlide = 3;
-		}
-		else
-		{
-			/* Kill off bonus block */
-			bonusBlock = False;
-			XClearArea(display, window, 
-				blockP->x, blockP->y,
-				blockP->width, blockP->height, 
-				False);
-			ClearBlock(r, c);
-			DEBUG("Clearing bonus block.")
-		}
+		if (blockP->bonusSlide < 0)
+			blockP->bonusSlide = 3;
+	}
+	else
+	{
+		/* Kill off bonus block */
+		bonusBlock = False;
+		XClearArea(display, window, 
+			blockP->x, blockP->y,
+			blockP->width, blockP->height, 
+			False);
+		ClearBlock(r, c);
+		DEBUG("Clearing bonus block.")
 	}
 }
 
 static int CheckAdjacentBlocks(Display *display, Window window, int r, int c)
 {
 	/* True - yes go ahead moved down one block - false no don't */
-	struct aBlock *blockP;
 	int row, col, i;
 
-	if (r < 0 || r >= MAX_ROW) return False;
-	if (c < 0 || c >= MAX_COL) return False;
-
-	blockP = &blocks[r][c];
-
-	if ((blockP->occupied == True) || (blockP->explodeStartFrame != 0))
+	/* Off the grid, occupied or exploding */
+	if (IsBlockFree(r, c) == False)
 		return False;
 
 	if ((r+1) >= (MAX_ROW - 2)) return False;
@@ -1295,413 +1005,397 @@ static int CheckAdjacentBlocks(Display *display, Window window, int r, int c)
 
 void HandlePendingAnimations(Display *display, Window window)
 {
-	int r, c, d, r1 = 0, c1 = 0;
-	struct aBlock *blockP;
+	int cell;
 
-	/* Cycle through all rows and columns and update any animations that
-	 * need to be done every frame. ie: bonus etc
+	/* Only visit the blocks that have an animation or expiry timer due
+	 * this frame. ie: bonus etc
 	 */
-	for (r = 0; r < MAX_ROW; r++)
-	{
-		for (c = 0; c < MAX_COL; c++)
-		{
-			blockP = &blocks[r][c];
-
-			/* Only bother if the block is occupied! */
-			if (blockP->occupied == True) 
-			{
-				switch (blockP->blockType)
-				{
-					case PAD_SHRINK_BLK:
-						HandlePendingSpecials(display, window, 
-							PAD_SHRINK_BLK, r, c);
-						break;
-
-					case PAD_EXPAND_BLK:	
-						HandlePendingSpecials(display, window, 
-							PAD_EXPAND_BLK, r, c);
-						break;
-
-					case MULTIBALL_BLK:	
-						HandlePendingSpecials(display, window, 
-							MULTIBALL_BLK, r, c);
-						break;
+	CollectDueTimers(TIMER_ANIMATE);
+	CollectDueTimers(TIMER_EXPIRE);
 
-					case REVERSE_BLK:
-						HandlePendingSpecials(display, window, 
-							REVERSE_BLK, r, c);
-						break;
+	for (cell = NextDueCell(TIMER_ANIMATE, TIMER_EXPIRE, 0); cell >= 0; 
+		cell = NextDueCell(TIMER_ANIMATE, TIMER_EXPIRE, cell + 1))
+	{
+		RunBlockTimers(display, window, cell / MAX_COL, cell % MAX_COL,
+			TakeDueTimer(TIMER_ANIMATE, cell), 
+			TakeDueTimer(TIMER_EXPIRE, cell));
+	}
+}
 
-					case MGUN_BLK:	
-						HandlePendingSpecials(display, window, 
-							MGUN_BLK, r, c);
-						break;
+static void RunBlockTimers(Display *display, Window window, int r, int c,
+	int animDue, int expireDue)
+{
+	/*
+	 * Do whatever the block at r, c has to do now that its animation
+	 * timer (animDue) and/or its expiry timer (expireDue) has gone off.
+	 */
 
-					case WALLOFF_BLK:	
-						HandlePendingSpecials(display, window, 
-							WALLOFF_BLK, r, c);
-						break;
+	int d, r1 = 0, c1 = 0;
+	struct aBlock *blockP;
 
-					case BONUS_BLK:	/* bonus coin symbol */
-						HandlePendingBonuses(display, window, BONUS_BLK, r, c);
-						break;
+	blockP = &blocks[r][c];
 
-					case BONUSX2_BLK:	/* Bonus x2 coin symbol */
-						HandlePendingBonuses(display, window, BONUSX2_BLK, r,c);
-						break;
+	/* Only bother if the block is occupied! */
+	if (blockP->occupied != True) 
+		return;
 
-					case BONUSX4_BLK:	/* Bonus x4 coin symbol */
-						HandlePendingBonuses(display, window, BONUSX4_BLK, r,c);
-						break;
+	switch (blockP->blockType)
+	{
+		case PAD_SHRINK_BLK:
+		case PAD_EXPAND_BLK:	
+		case MULTIBALL_BLK:	
+		case REVERSE_BLK:
+		case MGUN_BLK:	
+		case WALLOFF_BLK:	
+			if (expireDue == True)
+				HandlePendingSpecials(display, window, 
+					blockP->blockType, r, c);
+			break;
 
-					case DEATH_BLK:	/* Death block animation */
-						if (blockP->nextFrame == frame) 
-						{
-							/* Advance to the next frame of animation */
-							DrawTheBlock(display, window, 
-								blockP->x, blockP->y, 
-								DEATH_BLK, blockP->bonusSlide, r, c);
-
-							blockP->nextFrame = frame + DEATH_DELAY1;
-							blockP->bonusSlide++;
-
-							/* Have the delay bit between winks */
-							if (blockP->bonusSlide > 4)
-							{
-								blockP->bonusSlide = 0;
-								blockP->nextFrame = frame + DEATH_DELAY2;
-								DrawTheBlock(display, window, 
-									blockP->x, blockP->y, 
-									DEATH_BLK, blockP->bonusSlide, r, c);
-							}
-						}
+		case BONUS_BLK:		/* bonus coin symbol */
+		case BONUSX2_BLK:	/* Bonus x2 coin symbol */
+		case BONUSX4_BLK:	/* Bonus x4 coin symbol */
+			if (animDue == True)
+				HandlePendingBonuses(display, window, 
+					blockP->blockType, r, c);
+			break;
 
-						HandlePendingSpecials(display, window, DEATH_BLK, r, c);
-						break;
+		case DEATH_BLK:	/* Death block animation */
+			if (animDue == True) 
+			{
+				/* Advance to the next frame of animation */
+				DrawTheBlock(display, window, 
+					blockP->x, blockP->y, 
+					DEATH_BLK, blockP->bonusSlide, r, c);
 
-					case EXTRABALL_BLK:	/* extra ball block animation */
-						if (blockP->nextFrame == frame) 
-						{
-							/* Advance to the next frame of animation */
-							DrawTheBlock(display, window, 
-								blockP->x, blockP->y, 
-								EXTRABALL_BLK, blockP->bonusSlide, r, c);
+				ScheduleBlockTimer(r, c, TIMER_ANIMATE, frame + DEATH_DELAY1);
+				blockP->bonusSlide++;
 
-							blockP->nextFrame = frame + EXTRABALL_DELAY;
-							blockP->bonusSlide++;
+				/* Have the delay bit between winks */
+				if (blockP->bonusSlide > 4)
+				{
+					blockP->bonusSlide = 0;
+					ScheduleBlockTimer(r, c, TIMER_ANIMATE, 
+						frame + DEATH_DELAY2);
+					DrawTheBlock(display, window, 
+						blockP->x, blockP->y, 
+						DEATH_BLK, blockP->bonusSlide, r, c);
+				}
+			}
 
-							/* Have the delay bit between flashes */
-							if (blockP->bonusSlide > 1)
-								blockP->bonusSlide = 0;
-						}
+			if (expireDue == True)
+				HandlePendingSpecials(display, window, DEATH_BLK, r, c);
+			break;
 
-						HandlePendingSpecials(display, window, 
-							EXTRABALL_BLK, r, c);
-						break;
+		case EXTRABALL_BLK:	/* extra ball block animation */
+			if (animDue == True) 
+			{
+				/* Advance to the next frame of animation */
+				DrawTheBlock(display, window, 
+					blockP->x, blockP->y, 
+					EXTRABALL_BLK, blockP->bonusSlide, r, c);
+
+				ScheduleBlockTimer(r, c, TIMER_ANIMATE, 
+					frame + EXTRABALL_DELAY);
+				blockP->bonusSlide++;
+
+				/* Have the delay bit between flashes */
+				if (blockP->bonusSlide > 1)
+					blockP->bonusSlide = 0;
+			}
 
-					case BLACK_BLK:
-						if (blockP->nextFrame == frame) 
-						{
-							/* Clear the red bit in wall block */
-							DrawTheBlock(display, window, 
-								blockP->x, blockP->y, 
-								BLACK_BLK, 0, r, c);
+			if (expireDue == True)
+				HandlePendingSpecials(display, window, EXTRABALL_BLK, r, c);
+			break;
 
-							blockP->nextFrame = frame - 1;
-						}
-						break;
+		case BLACK_BLK:
+			if (animDue == True) 
+			{
+				/* Clear the red bit in wall block */
+				DrawTheBlock(display, window, 
+					blockP->x, blockP->y, 
+					BLACK_BLK, 0, r, c);
 
-					case ROAMER_BLK:	/* Roamer block animation */
-						if (blockP->nextFrame == frame) 
-						{
-							/* Advance to the next frame of animation */
-							DrawTheBlock(display, window, 
-								blockP->x, blockP->y, 
-								ROAMER_BLK, blockP->bonusSlide, r, c);
+				/* Next hit is a fresh one - see UpdateABall() */
+				blockP->nextFrame = frame - 1;
+			}
+			break;
 
-							blockP->nextFrame = frame + 
-								(rand() % ROAM_EYES_DELAY) + 50;
-							blockP->bonusSlide = rand() % 5;
+		case ROAMER_BLK:	/* Roamer block animation */
+			if (animDue == True) 
+			{
+				/* Advance to the next frame of animation */
+				DrawTheBlock(display, window, 
+					blockP->x, blockP->y, 
+					ROAMER_BLK, blockP->bonusSlide, r, c);
+
+				ScheduleBlockTimer(r, c, TIMER_ANIMATE, 
+					frame + (GameRandom(RNG_BLOCKS) % ROAM_EYES_DELAY) + 50);
+				blockP->bonusSlide = GameRandom(RNG_BLOCKS) % 5;
+			}
 
-						} else if (blockP->lastFrame == frame) 
-						{
-							/* Work out which way to move block if we can */
-							d = blockP->bonusSlide + 1; /* 1 - 4 */
-							switch (d)
-							{
-								case 1: r1 = 0; c1 = -1; break;
-								case 2: r1 = 0; c1 = 1; break;
-								case 3: r1 = -1; c1 = 0; break;
-								case 4: r1 = 1; c1 = 0; break;
-							}
-
-							/* check if we can move the roamer to next block */
-							if (CheckAdjacentBlocks(display, window, 
-								r+r1, c+c1))
-							{
-								/* Ok add a new block one space down */
-								AddNewBlock(display, window, r+r1, c+c1, 
-									ROAMER_BLK, 0, True);
-								blockP = &blocks[r+r1][c+c1];
-								blockP->nextFrame = frame + 
-									(rand() % ROAM_EYES_DELAY) + 50;
-
-								/* Erase the old block */
-								blockP = &blocks[r][c];
-								XClearArea(display, window, 
-									blockP->x, blockP->y,
-									blockP->width, blockP->height, False);
-								ClearBlock(r, c);
-							}
-							else
-							{
-								/* Ok - cannot go so just wait for a while */
-								blockP->lastFrame = frame + 
-									(rand() % ROAM_DELAY) + 300;
-							}
-						}
-						break;
+			if (expireDue == True) 
+			{
+				/* Work out which way to move block if we can */
+				d = blockP->bonusSlide + 1; /* 1 - 4 */
+				switch (d)
+				{
+					case 1: r1 = 0; c1 = -1; break;
+					case 2: r1 = 0; c1 = 1; break;
+					case 3: r1 = -1; c1 = 0; break;
+					case 4: r1 = 1; c1 = 0; break;
 				}
 
-				/* If it is a random block then change? */
-				if (blockP->random == True)
+				/* check if we can move the roamer to next block */
+				if (CheckAdjacentBlocks(display, window, r+r1, c+c1))
 				{
-					if (blockP->nextFrame == frame) 
-					{
-						/* Change the block to a new block block. We should
-						 * be allright in just changing the blocktype etc.
-						 * as the blocks are all the same .
-						 */
-						blockP->blockType = GetRandomType(False);
-						blockP->bonusSlide = 0;
-						blockP->explodeAll = False;
-
-						DrawTheBlock(display, window, 
-							blockP->x, blockP->y, 
-							blockP->blockType, blockP->bonusSlide, r, c);
-
-						blockP->nextFrame = 
-							frame + (rand() % RANDOM_DELAY) + 300;
-					}	
-				}	/* random */
-
-				/* Handle the dropping blocks */
-				if (blockP->drop == True)
+					/* Ok add a new block one space down */
+					AddNewBlock(display, window, r+r1, c+c1, 
+						ROAMER_BLK, 0, True);
+					ScheduleBlockTimer(r+r1, c+c1, TIMER_ANIMATE,
+						frame + (GameRandom(RNG_BLOCKS) % ROAM_EYES_DELAY) + 50);
+
+					/* Erase the old block */
+					XClearArea(display, window, 
+						blockP->x, blockP->y,
+						blockP->width, blockP->height, False);
+					ClearBlock(r, c);
+				}
+				else
 				{
-					/* Time to drop down one notch? */
-					if (blockP->nextFrame == frame) 
-					{
-						/* Can the drop block move down */
-						if (CheckAdjacentBlocks(display, window, r+1, c))
-						{
-							/* Ok add a new block one space down */
-							AddNewBlock(display, window, r+1, c, 
-								DROP_BLK, 0, True);
-    						blockP = &blocks[r+1][c];
-							blockP->nextFrame = frame + 
-								(rand() % DROP_DELAY) + 200;
-
-							/* Erase the old block */
-    						blockP = &blocks[r][c];
-							XClearArea(display, window, 
-								blockP->x, blockP->y,
-								blockP->width, blockP->height, False);
-							ClearBlock(r, c);
-						}
-						else
-						{
-							/* Ok - cannot go down so just wait for a while */
-    						blockP = &blocks[r][c];
-							blockP->nextFrame = frame + DROP_DELAY;
-						}
-					}	
-				}	/* droppers */
-
+					/* Ok - cannot go so just wait for a while */
+					ScheduleBlockTimer(r, c, TIMER_EXPIRE, 
+						frame + (GameRandom(RNG_BLOCKS) % ROAM_DELAY) + 300);
+				}
 			}
-		}
+			break;
 	}
-}
 
-void ExplodeBlocksPending(Display *display, Window window)
-{
-	int r, c, x, y, type, i;
-	struct aBlock *blockP;
-	char str[50];
+	/* If it is a random block then change? */
+	if (blockP->random == True && animDue == True)
+	{
+		/* Change the block to a new block block. We should
+		 * be allright in just changing the blocktype etc.
+		 * as the blocks are all the same .
+		 */
+		ChangeBlockType(r, c, GetRandomType(False));
+		blockP->bonusSlide = 0;
+		blockP->explodeAll = False;
 
-	/* If none are exploding then bug out */
-	if (blocksExploding == 0) return;
+		DrawTheBlock(display, window, 
+			blockP->x, blockP->y, 
+			blockP->blockType, blockP->bonusSlide, r, c);
 
-	/* Cycle through all blocks exploding pending animation blocks */
-	for (r = 0; r < MAX_ROW; r++)
+		ScheduleBlockTimer(r, c, TIMER_ANIMATE, 
+			frame + (GameRandom(RNG_BLOCKS) % RANDOM_DELAY) + 300);
+	}	/* random */
+
+	/* Handle the dropping blocks - time to drop down one notch? */
+	if (blockP->drop == True && animDue == True)
 	{
-		for (c = 0; c < MAX_COL; c++)
+		/* Can the drop block move down */
+		if (CheckAdjacentBlocks(display, window, r+1, c))
 		{
-			/* Get the pointer to the block we need */
-			blockP = &blocks[r][c];
+			/* Ok add a new block one space down */
+			AddNewBlock(display, window, r+1, c, DROP_BLK, 0, True);
+			ScheduleBlockTimer(r+1, c, TIMER_ANIMATE, 
+				frame + (GameRandom(RNG_BLOCKS) % DROP_DELAY) + 200);
+
+			/* Erase the old block */
+			XClearArea(display, window, 
+				blockP->x, blockP->y,
+				blockP->width, blockP->height, False);
+			ClearBlock(r, c);
+		}
+		else
+		{
+			/* Ok - cannot go down so just wait for a while */
+			ScheduleBlockTimer(r, c, TIMER_ANIMATE, frame + DROP_DELAY);
+		}
+	}	/* droppers */
+}
+
+void ExplodeBlocksPending(Display *display, Window window)
+{
+	int r, c, x, y, type, i, cell;
+	struct aBlock *blockP;
+	char str[50];
+
+	/* If none are exploding then bug out */
+	if (blocksExploding == 0) return;
+
+	/* Only visit the blocks whose next explosion slide is due */
+	CollectDueTimers(TIMER_EXPLODE);
+
+	for (cell = NextDueCell(TIMER_EXPLODE, TIMER_EXPLODE, 0); cell >= 0; 
+		cell = NextDueCell(TIMER_EXPLODE, TIMER_EXPLODE, cell + 1))
+	{
+		TakeDueTimer(TIMER_EXPLODE, cell);
+		r = cell / MAX_COL;
+		c = cell % MAX_COL;
+
+		/* Get the pointer to the block we need */
+		blockP = &blocks[r][c];
+
+		/* Will be non-zero if animation is required */
+		if (blockP->explodeStartFrame)
+		{
+			x = blockP->x;
+			y = blockP->y;
+			type = blockP->blockType;
 
-			/* Will be non-zero if animation is required */
-			if (blockP->explodeStartFrame)
+			/* Switch on slide of animation */
+			switch (blockP->explodeSlide)
 			{
-				/* Is it time to explode this frame */
-				if (blockP->explodeNextFrame == frame) 
-				{
-					x = blockP->x;
-					y = blockP->y;
-					type = blockP->blockType;
-
-					/* Switch on slide of animation */
-					switch (blockP->explodeSlide)
-					{
-						case 1:	/* First frame of animation */
-							ExplodeBlockType(display, window, x, y, r, c, 
-								type, 0);
-							blockP->explodeNextFrame =
-								blockP->explodeStartFrame;
-
-							/* Explode all of one type if set */
-							if (blockP->explodeAll == True)
-								ExplodeAllOfOneType(display, window, type);
-							break;
+				case 1:	/* First frame of animation */
+					ExplodeBlockType(display, window, x, y, r, c, 
+						type, 0);
+					blockP->explodeNextFrame =
+						blockP->explodeStartFrame;
+
+					/* Explode all of one type if set */
+					if (blockP->explodeAll == True)
+						ExplodeAllOfOneType(display, window, type);
+					break;
 	
-						case 2:	/* Second frame of animation */
-							ExplodeBlockType(display, window, x, y, r, c, 
-								type, 1);
-							break;
+				case 2:	/* Second frame of animation */
+					ExplodeBlockType(display, window, x, y, r, c, 
+						type, 1);
+					break;
 	
-						case 3:	/* Third frame of animation */
-							ExplodeBlockType(display, window, x, y, r, c, 
-								type, 2);
-							break;
+				case 3:	/* Third frame of animation */
+					ExplodeBlockType(display, window, x, y, r, c, 
+						type, 2);
+					break;
 	
-						case 4:	/* Last frame of animation  - clear */
-							XClearArea(display, window, x, y, 
-								blockP->width, 
-								blockP->height, False);
-							break;
-					}
+				case 4:	/* Last frame of animation  - clear */
+					XClearArea(display, window, x, y, 
+						blockP->width, 
+						blockP->height, False);
+					break;
+			}
 	
-					/* procede to next frame in animation */
-					blockP->explodeSlide++;
-					blockP->explodeNextFrame += EXPLODE_DELAY;
+			/* procede to next frame in animation */
+			blockP->explodeSlide++;
+			ScheduleBlockTimer(r, c, TIMER_EXPLODE, 
+				blockP->explodeNextFrame + EXPLODE_DELAY);
 	
-					/* last frame so clean up animation and block */
-					if (blockP->explodeSlide > 4)
-					{
-						blocksExploding--;
-						blockP->occupied = 0;
-						blockP->exploding = False;
+			/* last frame so clean up animation and block */
+			if (blockP->explodeSlide > 4)
+			{
+				blocksExploding--;
+				blockP->occupied = 0;
+				blockP->exploding = False;
+
+				AddToScore((u_long) blockP->hitPoints);
+				DisplayScore(display, scoreWindow, score);
+
+				switch (blockP->blockType)
+				{
+					case BLACK_BLK:
+					case PAD_SHRINK_BLK:
+					case PAD_EXPAND_BLK:
+						break;
+
+					case BOMB_BLK:
+						/* Explode all the ones around it */
+						SetBlockUpForExplosion(r+1, c, 
+							frame + EXPLODE_DELAY);
+						SetBlockUpForExplosion(r, c+1, 
+							frame + EXPLODE_DELAY);
+						SetBlockUpForExplosion(r-1, c, 
+							frame + EXPLODE_DELAY);
+						SetBlockUpForExplosion(r, c-1, 
+							frame + EXPLODE_DELAY);
+						SetBlockUpForExplosion(r-1, c-1, 
+							frame + EXPLODE_DELAY);
+						SetBlockUpForExplosion(r-1, c+1, 
+							frame + EXPLODE_DELAY);
+						SetBlockUpForExplosion(r+1, c-1, 
+							frame + EXPLODE_DELAY);
+						SetBlockUpForExplosion(r+1, c+1, 
+							frame + EXPLODE_DELAY);
+
+						/* Special effect where screen shakes 
+						 * during explosion 
+						 */
+						SetSfxEndFrame(frame + 70);
+						changeSfxMode(SFX_SHAKE);
+						break;
+
+					case TIMER_BLK:
+						AddToLevelTimeBonus(display, timeWindow, 
+							EXTRA_TIME);
+						SetCurrentMessage(display, messWindow, 
+							"- Extra Time = 20 seconds -", True);
+						break;
+
+					case BULLET_BLK:
+						SetCurrentMessage(display, messWindow, 
+							"More ammunition, cool!", True);
+						for (i=0; i < NUMBER_OF_BULLETS_NEW_LEVEL; i++)
+							AddABullet(display);
+						break;
+
+					case MAXAMMO_BLK:
+						SetCurrentMessage(display, messWindow, 
+							"Unlimited bullets!", True);
+						SetUnlimitedBullets(True);
+						SetNumberBullets(MAX_BULLETS+1);
+						DisplayLevelInfo(display, levelWindow, level);
+						break;
 
-						AddToScore((u_long) blockP->hitPoints);
-						DisplayScore(display, scoreWindow, score);
+					case BONUS_BLK:
+						IncNumberBonus();
+
+						if (GetNumberBonus() <= MAX_BONUS)
+							sprintf(str, 
+								"- Bonus #%d -", GetNumberBonus());
+						else
+							sprintf(str, "<<< Super Bonus >>>");
 
-						switch (blockP->blockType)
+						SetCurrentMessage(display, messWindow, str, 
+							True);
+						bonusBlock = False;
+
+						/* Turn on killer mode after 10 bonuses */
+						if (GetNumberBonus() == 10)
 						{
-							case BLACK_BLK:
-							case PAD_SHRINK_BLK:
-							case PAD_EXPAND_BLK:
-								break;
-
-							case BOMB_BLK:
-								/* Explode all the ones around it */
-								SetBlockUpForExplosion(r+1, c, 
-									frame + EXPLODE_DELAY);
-								SetBlockUpForExplosion(r, c+1, 
-									frame + EXPLODE_DELAY);
-								SetBlockUpForExplosion(r-1, c, 
-									frame + EXPLODE_DELAY);
-								SetBlockUpForExplosion(r, c-1, 
-									frame + EXPLODE_DELAY);
-								SetBlockUpForExplosion(r-1, c-1, 
-									frame + EXPLODE_DELAY);
-								SetBlockUpForExplosion(r-1, c+1, 
-									frame + EXPLODE_DELAY);
-								SetBlockUpForExplosion(r+1, c-1, 
-									frame + EXPLODE_DELAY);
-								SetBlockUpForExplosion(r+1, c+1, 
-									frame + EXPLODE_DELAY);
-
-								/* Special effect where screen shakes 
-								 * during explosion 
-								 */
-								SetSfxEndFrame(frame + 70);
-								changeSfxMode(SFX_SHAKE);
-								break;
-
-							case TIMER_BLK:
-								AddToLevelTimeBonus(display, timeWindow, 
-									EXTRA_TIME);
-								SetCurrentMessage(display, messWindow, 
-									"- Extra Time = 20 seconds -", True);
-								break;
-
-							case BULLET_BLK:
-								SetCurrentMessage(display, messWindow, 
-									"More ammunition, cool!", True);
-								for (i=0; i < NUMBER_OF_BULLETS_NEW_LEVEL; i++)
-									AddABullet(display);
-								break;
-
-							case MAXAMMO_BLK:
-								SetCurrentMessage(display, messWindow, 
-									"Unlimited bullets!", True);
-								SetUnlimitedBullets(True);
-								SetNumberBullets(MAX_BULLETS+1);
-								DisplayLevelInfo(display, levelWindow, level);
-								break;
-
-							case BONUS_BLK:
-								IncNumberBonus();
-
-								if (GetNumberBonus() <= MAX_BONUS)
-									sprintf(str, 
-										"- Bonus #%d -", GetNumberBonus());
-								else
-									sprintf(str, "<<< Super Bonus >>>");
-
-								SetCurrentMessage(display, messWindow, str, 
-									True);
-								bonusBlock = False;
-
-								/* Turn on killer mode after 10 bonuses */
-								if (GetNumberBonus() == 10)
-								{
-									/* Turn on killer mode */
-									ToggleKiller(display, True);
-									DrawSpecials(display);
-
-									SetCurrentMessage(display, messWindow, 
-										"- Killer Mode -", True);
-								}
-								break;
-
-							case BONUSX2_BLK:
-								Togglex2Bonus(display, True);
-								Togglex4Bonus(display, False);
-								DrawSpecials(display);
-
-								bonusBlock = False;
-								SetCurrentMessage(display, messWindow, 
-									"- x2 Bonus -", True);
-								break;
-
-							case BONUSX4_BLK:
-								Togglex2Bonus(display, False);
-								Togglex4Bonus(display, True);
-								DrawSpecials(display);
-
-								bonusBlock = False;
-								SetCurrentMessage(display, messWindow, 
-									"- x4 Bonus -", True);
-								break;
-
-							default :
-								break;
+							/* Turn on killer mode */
+							ToggleKiller(display, True);
+							DrawSpecials(display);
+
+							SetCurrentMessage(display, messWindow, 
+								"- Killer Mode -", True);
 						}
+						break;
 
-						/* Reset to a non exploding block */
-						ClearBlock(r, c);
-					}
+					case BONUSX2_BLK:
+						Togglex2Bonus(display, True);
+						Togglex4Bonus(display, False);
+						DrawSpecials(display);
+
+						bonusBlock = False;
+						SetCurrentMessage(display, messWindow, 
+							"- x2 Bonus -", True);
+						break;
+
+					case BONUSX4_BLK:
+						Togglex2Bonus(display, False);
+						Togglex4Bonus(display, True);
+						DrawSpecials(display);
+
+						bonusBlock = False;
+						SetCurrentMessage(display, messWindow, 
+							"- x4 Bonus -", True);
+						break;
+
+					default :
+						break;
 				}
+
+				/* Reset to a non exploding block */
+				ClearBlock(r, c);
 			}
 		}
 	}
@@ -1711,12 +1405,30 @@ void DrawTheBlock(Display *display, Window window, int x, int y,
 	int blockType, int slide, int r, int c)
 {
 	struct aBlock *blockP;
+	BITBOARD animated;
 	char tmp[10];
-	int w, h, x1, y1, len;
+	int w, h, x1, y1, len, cell;
 
 	/* Get the pointer to the block we need */
 	blockP = &blocks[r][c];
 
+	/* Remember what the cell shows now and have the block layer redraw it */
+	if (layerDrawing == False && r >= 0 && r < MAX_ROW && c >= 0 && c < MAX_COL)
+	{
+		/* The dynamite is drawn over the block, see RebuildBlockLayer() */
+		if (blockType != DYNAMITE_BLK)
+		{
+			blockP->drawnType 	= blockType;
+			blockP->drawnSlide 	= slide;
+		}
+
+		/* Animated cells are not in the layer, DrawAnimatedBlocks() does them */
+		cell = GRID_CELL(r, c);
+		GetAnimatedCells(&animated);
+		if ((animated.word[BIT_WORD(cell)] & BIT_MASK(cell)) == 0)
+			layerDirty.word[BIT_WORD(cell)] |= BIT_MASK(cell);
+	}
+
 	switch(blockType)
 	{
 		case DYNAMITE_BLK:	/* dynamite block block */
@@ -1724,28 +1436,23 @@ void DrawTheBlock(Display *display, Window window, int x, int y,
 			 * This is not a block type but an image that overlays a block
 			 * when it becomes an explode all block.
 			 */
-			RenderShape(display, window, dynamite,
-				dynamiteM, x, y, 29, 15, False);
+			DrawSprite(dynamite, x, y);
 			break;
 
 		case TIMER_BLK:		/* extra time clock block */
-			RenderShape(display, window, timeblock,
-				timeblockM, x, y, 21, 21, False);
+			DrawSprite(timeblock, x, y);
 			break;
 
 		case PAD_SHRINK_BLK:	/* Paddle shrink block */
-			RenderShape(display, window, paddleshrink,
-				paddleshrinkM, x, y, 40, 15, False);
+			DrawSprite(paddleshrink, x, y);
 			break;
 
 		case PAD_EXPAND_BLK:	/* Paddle expand block */
-			RenderShape(display, window, paddleexpand,
-				paddleexpandM, x, y, 40, 15, False);
+			DrawSprite(paddleexpand, x, y);
 			break;
 
 		case BULLET_BLK:	/* Draw a bullet shape */
-			RenderShape(display, window, yellowblock, yellowblockM, 
-				x, y, 40, 20, False);
+			DrawSprite(yellowblock, x, y);
 			DrawTheBullet(display, window, x+6, y+10);
 			DrawTheBullet(display, window, x+15, y+10);
 			DrawTheBullet(display, window, x+24, y+10);
@@ -1753,23 +1460,19 @@ void DrawTheBlock(Display *display, Window window, int x, int y,
 			break;
 
 		case MAXAMMO_BLK:
-			RenderShape(display, window, unlimitammo, unlimitammoM, 
-				x, y, 40, 20, False);
+			DrawSprite(unlimitammo, x, y);
 			break;
 
 		case MULTIBALL_BLK:	/* Draw multiple ball block */
-			RenderShape(display, window, multiball, multiballM, 
-				x, y, 40, 20, False);
+			DrawSprite(multiball, x, y);
 			break;
 
 		case STICKY_BLK:	/* Draw sticky block */
-			RenderShape(display, window, sticky, stickyM, 
-				x, y, 32, 27, False);
+			DrawSprite(sticky, x, y);
 			break;
 
 		case RANDOM_BLK:	/* Draw a red block shape for random */
-			RenderShape(display, window, redblock, redblockM, 
-				x, y, 40, 20, False);
+			DrawSprite(redblock, x, y);
 			strcpy(tmp, "- R -");
 			len = strlen(tmp);
 			w 	= XTextWidth(dataFont, tmp, len);
@@ -1780,28 +1483,23 @@ void DrawTheBlock(Display *display, Window window, int x, int y,
 			break;
 
 		case RED_BLK:	/* Draw a red block shape */
-			RenderShape(display, window, redblock, redblockM, 
-				x, y, 40, 20, False);
+			DrawSprite(redblock, x, y);
 			break;
 
 		case BLACK_BLK:		/* Draw a solid wall block */	
-			RenderShape(display, window, blackblock, blackblockM, 
-				x, y, 50, 30, False);
+			DrawSprite(blackblock, x, y);
 			break;
 
 		case BLACKHIT_BLK:		/* Draw a solid wall block hit */	
-			RenderShape(display, window, blackhit, blackhitM, 
-				x, y, 50, 30, False);
+			DrawSprite(blackhit, x, y);
 			break;
 
 		case GREEN_BLK:		/* Draw a green block */
-			RenderShape(display, window, greenblock, greenblockM, 
-				x, y, 40, 20, False);
+			DrawSprite(greenblock, x, y);
 			break;
 
 		case DROP_BLK:		/* Draw a drop block same as green block */
-			RenderShape(display, window, greenblock, greenblockM, 
-				x, y, 40, 20, False);
+			DrawSprite(greenblock, x, y);
 			sprintf(tmp, "%d", blockP->hitPoints);	
 			len = strlen(tmp);
 			w 	= XTextWidth(dataFont, tmp, len);
@@ -1812,83 +1510,67 @@ void DrawTheBlock(Display *display, Window window, int x, int y,
 			break;
 
 		case BLUE_BLK:		/* Draw a blue block */
-			RenderShape(display, window, blueblock, blueblockM, 
-				x, y, 40, 20, False);
+			DrawSprite(blueblock, x, y);
 			break;
 
 		case YELLOW_BLK:	/* Draw a yellow block */
-			RenderShape(display, window, yellowblock, yellowblockM, 
-				x, y, 40, 20, False);
+			DrawSprite(yellowblock, x, y);
 			break;
 
 		case TAN_BLK:		/* Draw a tan block */
-			RenderShape(display, window, tanblock, tanblockM, 
-				x, y, 40, 20, False);
+			DrawSprite(tanblock, x, y);
 			break;
 
 		case PURPLE_BLK:	/* Draw a purple block */
-			RenderShape(display, window, purpleblock, purpleblockM, 
-				x, y, 40, 20, False);
+			DrawSprite(purpleblock, x, y);
 			break;
 
 		case ROAMER_BLK:	/* Draw a frame of roaming dude block */
-			RenderShape(display, window, roamer[slide], 
-				roamerM[slide], x, y, 25, 27, False);
+			DrawSprite(roamer[slide], x, y);
 			break;
 
 		case COUNTER_BLK:	/* Draw a frame of counter block */
-			RenderShape(display, window, counterblock[slide], 
-				counterblockM[slide], x, y, 40, 20, False);
+			DrawSprite(counterblock[slide], x, y);
 			break;
 
 		case BONUSX2_BLK:	/* Draw a bonus x2 coin block */
-			RenderShape(display, window, x2bonus[slide], 
-				x2bonusM[slide], x, y, 27, 27, False);
+			DrawSprite(x2bonus[slide], x, y);
 			break;
 
 		case BONUSX4_BLK:	/* Draw a bonus x4 coin block */
-			RenderShape(display, window, x4bonus[slide], 
-				x4bonusM[slide], x, y, 27, 27, False);
+			DrawSprite(x4bonus[slide], x, y);
 			break;
 
 		case BONUS_BLK:	/* Draw a bonus coin block */
-			RenderShape(display, window, Bonus[slide], 
-				BonusM[slide], x, y, 27, 27, False);
+			DrawSprite(Bonus[slide], x, y);
 			break;
 
 		case BOMB_BLK:		/* Draw a bomb block */
-			RenderShape(display, window, bombblock, bombblockM, 
-				x, y, 30, 30, False);
+			DrawSprite(bombblock, x, y);
 			break;
 
 		case DEATH_BLK:		/* Draw the pirate death block */
-			RenderShape(display, window, death[slide], deathM[slide], 
-				x, y, 30, 30, False);
+			DrawSprite(death[slide], x, y);
 			break;
 
 		case REVERSE_BLK:	/* Draw the reverse block */
-			RenderShape(display, window, revblock, revblockM, 
-				x, y, 33, 16, False);
+			DrawSprite(revblock, x, y);
 			break;
 
 		case EXTRABALL_BLK:	/* Draw the extra ball block */
-			RenderShape(display, window, extraball[slide], extraballM[slide], 
-				x, y, 30, 19, False);
+			DrawSprite(extraball[slide], x, y);
 			break;
 
 		case HYPERSPACE_BLK:	/* Draw the hyperspace block */
-			RenderShape(display, window, hyperblock, hyperblockM, 
-				x, y, 31, 31, False);
+			DrawSprite(hyperblock, x, y);
 			break;
 
 		case MGUN_BLK:	/* Draw the machine gun block */
-			RenderShape(display, window, mgunblock, mgunblockM, 
-				x, y, 35, 15, False);
+			DrawSprite(mgunblock, x, y);
 			break;
 
 		case WALLOFF_BLK:	/* Draw the wall off block */
-			RenderShape(display, window, walloffblock, walloffblockM, 
-				x, y, 27, 23, False);
+			DrawSprite(walloffblock, x, y);
 			break;
 	}
 }
@@ -1914,8 +1596,8 @@ static void SetBlockUpForExplosion(int row, int col, int frame)
 
 		/* Some special variables used for timing */
 		blockP->explodeStartFrame 	= frame;
-		blockP->explodeNextFrame 	= frame;
 		blockP->explodeSlide 		= 1;
+		ScheduleBlockTimer(row, col, TIMER_EXPLODE, frame);
 		blockP->exploding 			= True;
 
 		/* If it was poped up then reset bonus or special flag */
@@ -1923,6 +1605,8 @@ static void SetBlockUpForExplosion(int row, int col, int frame)
 
 		/* If it is a dropper then make sure it wont keep dropping */
 		if (blockP->drop == True) blockP->drop = False;
+
+		SyncBlockCell(row, col);
 	}
 }
 
@@ -1962,149 +1646,16 @@ void DrawBlock(Display *display, Window window, int row, int col, int blockType)
 
 void FreeBlockPixmaps(Display *display)
 {
-	int i;
-
-	/* Free all region info that may be in the blocks array */
+	/* Reset every block in the blocks array */
 	ClearBlockArray();
 
-	/* Free the memory associated with the block pixmaps */
-	if (redblock)		XFreePixmap(display, redblock);			
-	if (redblockM)		XFreePixmap(display, redblockM);
-	
-	if (blueblock)		XFreePixmap(display, blueblock);		
-	if (blueblockM)		XFreePixmap(display, blueblockM);
-
-	if (greenblock)		XFreePixmap(display, greenblock);		
-	if (greenblockM)	XFreePixmap(display, greenblockM);
-
-	if (tanblock)		XFreePixmap(display, tanblock);			
-	if (tanblockM)		XFreePixmap(display, tanblockM);
-
-	if (yellowblock)	XFreePixmap(display, yellowblock);		
-	if (yellowblockM)	XFreePixmap(display, yellowblockM);
-
-	if (purpleblock)	XFreePixmap(display, purpleblock);		
-	if (purpleblockM)	XFreePixmap(display, purpleblockM);
-
-	if (blackblock)		XFreePixmap(display, blackblock);		
-	if (blackblockM)	XFreePixmap(display, blackblockM);
-
-	if (blackhit)		XFreePixmap(display, blackhit);		
-	if (blackhitM)		XFreePixmap(display, blackhitM);		
-
-	if (bombblock)		XFreePixmap(display, bombblock);		
-	if (bombblockM)		XFreePixmap(display, bombblockM);
-
-	if (revblock)		XFreePixmap(display, revblock);		
-	if (revblockM)		XFreePixmap(display, revblockM);
-
-	if (hyperblock)		XFreePixmap(display, hyperblock);		
-	if (hyperblockM)	XFreePixmap(display, hyperblockM);
-
-	if (mgunblock)		XFreePixmap(display, mgunblock);		
-	if (mgunblockM)		XFreePixmap(display, mgunblockM);
-
-	if (walloffblock)	XFreePixmap(display, walloffblock);		
-	if (walloffblockM)	XFreePixmap(display, walloffblockM);
-
-	if (multiball)		XFreePixmap(display, multiball);		
-	if (multiballM)		XFreePixmap(display, multiballM);
-
-	if (sticky)			XFreePixmap(display, sticky);		
-	if (stickyM)		XFreePixmap(display, stickyM);
-
-	if (unlimitammo)	XFreePixmap(display, unlimitammo);		
-	if (unlimitammoM)	XFreePixmap(display, unlimitammoM);		
-
-	if (paddleexpand)	XFreePixmap(display, paddleexpand);		
-	if (paddleexpandM)	XFreePixmap(display, paddleexpandM);
-
-	if (paddleshrink)	XFreePixmap(display, paddleshrink);		
-	if (paddleshrinkM)	XFreePixmap(display, paddleshrinkM);
-
-	if (timeblock)		XFreePixmap(display, timeblock);		
-	if (timeblockM)		XFreePixmap(display, timeblockM);
-
-	if (dynamite)		XFreePixmap(display, dynamite);
-	if (dynamiteM)		XFreePixmap(display, dynamiteM);
-
-	for (i = 0; i < 5; i++)
-	{
-		/* Free the frames for the roamer block */
-		if (roamer[i])	XFreePixmap(display, roamer[i]); 	
-		if (roamerM[i])	XFreePixmap(display, roamerM[i]);
-	}
-
-	for (i = 0; i < 5; i++)
-	{
-		/* Free the frames for the death block */
-		if (death[i])	XFreePixmap(display, death[i]); 	
-		if (deathM[i])	XFreePixmap(display, deathM[i]);
-	}
-
-	for (i = 0; i < 6; i++)
-	{
-		if (counterblock[i])	XFreePixmap(display, counterblock[i]); 	
-		if (counterblockM[i])	XFreePixmap(display, counterblockM[i]);
-	}
-
-	for (i = 0; i < 4; i++)
-	{
-		if (x2bonus[i])			XFreePixmap(display, x2bonus[i]); 	
-		if (x2bonusM[i])		XFreePixmap(display, x2bonusM[i]);
-
-		if (x4bonus[i])			XFreePixmap(display, x4bonus[i]); 	
-		if (x4bonusM[i])		XFreePixmap(display, x4bonusM[i]);
-
-		if (Bonus[i])			XFreePixmap(display, Bonus[i]); 	
-		if (BonusM[i])			XFreePixmap(display, BonusM[i]);
-	}
-
-	for (i = 0; i < 2; i++)
-	{
-		if (extraball[i])		XFreePixmap(display, extraball[i]); 	
-		if (extraballM[i])		XFreePixmap(display, extraballM[i]);
-	}
-
-	for (i = 0; i < 3; i++)
-	{
-		if (exgreenblock[i])   	XFreePixmap(display, exgreenblock[i]); 	
-		if (exgreenblockM[i])   XFreePixmap(display, exgreenblockM[i]);
-
-		if (exyellowblock[i])   XFreePixmap(display, exyellowblock[i]);
-		if (exyellowblockM[i])  XFreePixmap(display, exyellowblockM[i]);
-
-		if (exredblock[i])     	XFreePixmap(display, exredblock[i]);
-		if (exredblockM[i])     XFreePixmap(display, exredblockM[i]);
-
-		if (exblueblock[i])     XFreePixmap(display, exblueblock[i]);
-		if (exblueblockM[i])    XFreePixmap(display, exblueblockM[i]);
-
-		if (extanblock[i])     	XFreePixmap(display, extanblock[i]);
-		if (extanblockM[i])     XFreePixmap(display, extanblockM[i]);
-
-		if (excounterblock[i])  XFreePixmap(display, excounterblock[i]);
-		if (excounterblockM[i]) XFreePixmap(display, excounterblockM[i]);
-
-		if (exbombblock[i])     XFreePixmap(display, exbombblock[i]);
-		if (exbombblockM[i])    XFreePixmap(display, exbombblockM[i]);
-		
-		if (expurpleblock[i])   XFreePixmap(display, expurpleblock[i]);
-		if (expurpleblockM[i])  XFreePixmap(display, expurpleblockM[i]);
-		
-		if (exx2bonus[i])     	XFreePixmap(display, exx2bonus[i]);
-		if (exx2bonusM[i])     	XFreePixmap(display, exx2bonusM[i]);
-
-		if (exdeath[i])			XFreePixmap(display, exdeath[i]); 	
-		if (exdeathM[i])		XFreePixmap(display, exdeathM[i]);
-	}
+	/* The block sprites live in the atlas and go with it, see FreeAtlas() */
+	FreeBlockLayer();
 }
 
 static void CalculateBlockGeometry(int row, int col)
 {
 	struct aBlock *blockP;
-	XPoint points[4];
-	int halfWidth, halfHeight;
 
 	/* Pointer to the correct block we need - speed things up */
 	blockP = &blocks[row][col];
@@ -2218,78 +1769,19 @@ static void CalculateBlockGeometry(int row, int col)
 	/* Calculate the offset within the block grid */
 	blockP->x = (col * colWidth) + blockP->blockOffsetX;
 	blockP->y = (row * rowHeight) + blockP->blockOffsetY;
-
-	/* Used below */
-	halfWidth = blockP->x + (blockP->width / 2);
-	halfHeight = blockP->y + (blockP->height / 2);
-
-	/* Create the XPoint array for the top region */
-	points[0].x = blockP->x;
-	points[0].y = blockP->y;
-	points[1].x = halfWidth;
-	points[1].y = halfHeight;
-	points[2].x = blockP->x + blockP->width;
-	points[2].y = blockP->y;
-	points[3].x = points[0].x;
-	points[3].y = points[0].y;
-
-	/* Create the top region for the block */
-    blockP->regionTop = XPolygonRegion(points, 4, EvenOddRule);
-
-	/* Create the XPoint array for the bottom region */
-	points[0].x = blockP->x;
-	points[0].y = blockP->y + blockP->height;
-	points[1].x = halfWidth;
-	points[1].y = halfHeight;
-	points[2].x = blockP->x + blockP->width;
-	points[2].y = points[0].y;
-	points[3].x = points[0].x;
-	points[3].y = points[0].y;
-
-	/* Create the bottom region for the block */
-    blockP->regionBottom = XPolygonRegion(points, 4, EvenOddRule);
-
-	/* Create the XPoint array for the left region */
-	points[0].x = blockP->x;
-	points[0].y = blockP->y;
-	points[1].x = halfWidth;
-	points[1].y = halfHeight;
-	points[2].x = blockP->x;
-	points[2].y = blockP->y + blockP->height;
-	points[3].x = points[0].x;
-	points[3].y = points[0].y;
-
-	/* Create the left region for the block */
-    blockP->regionLeft = XPolygonRegion(points, 4, EvenOddRule);
-
-	/* Create the XPoint array for the right region */
-	points[0].x = blockP->x + blockP->width;
-	points[0].y = blockP->y;
-	points[1].x = halfWidth;
-	points[1].y = halfHeight;
-	points[2].x = points[0].x;
-	points[2].y = blockP->y + blockP->height;
-	points[3].x = points[0].x;
-	points[3].y = points[0].y;
-
-	/* Create the right region for the block */
-    blockP->regionRight = XPolygonRegion(points, 4, EvenOddRule);
 }
 
 void EraseVisibleBlock(Display *display, Window window, int row, int col)
 {
 	/* Actually erase the block from the arena */
-	struct aBlock *blockP;
-
-	if (row > MAX_ROW || row < 0) return;
-	if (col > MAX_COL || col < 0) return;
+	int cell;
 
-	/* Erase the old block */
-   	blockP = &blocks[row][col];
+	if (row >= MAX_ROW || row < 0) return;
+	if (col >= MAX_COL || col < 0) return;
 
-	if (blockP->occupied)
-		XClearArea(display, window, blockP->x, blockP->y, blockP->width,
-			blockP->height, False);
+	/* The block layer wipes the cell and draws whatever is left in it */
+	cell = GRID_CELL(row, col);
+	layerDirty.word[BIT_WORD(cell)] |= BIT_MASK(cell);
 }
 
 void AddNewBlock(Display *display, Window window, int row, int col,
@@ -2297,8 +1789,8 @@ void AddNewBlock(Display *display, Window window, int row, int col,
 {
 	struct aBlock *blockP;
 
-	if (row > MAX_ROW || row < 0) return;
-	if (col > MAX_COL || col < 0) return;
+	if (row >= MAX_ROW || row < 0) return;
+	if (col >= MAX_COL || col < 0) return;
 
 	ClearBlock(row, col);
 
@@ -2310,6 +1802,8 @@ void AddNewBlock(Display *display, Window window, int row, int col,
 	blockP->occupied 		= 1;
 	blockP->counterSlide 	= counterSlide;
 	blockP->lastFrame 		= frame + INFINITE_DELAY;
+	blockP->drawnType 		= blockType;
+	blockP->drawnSlide 		= counterSlide;
 
 	/* Handle the special case for a random block */
 	if (blockType == RANDOM_BLK)
@@ -2317,21 +1811,27 @@ void AddNewBlock(Display *display, Window window, int row, int col,
 		/* Setup the random block so it has a next frame and new type */
 		blockP->random 	  = True;
 		blockP->blockType = RED_BLK;
-		blockP->nextFrame = frame + 1;
+		ScheduleBlockTimer(row, col, TIMER_ANIMATE, frame + 1);
 	} else if (blockType == DROP_BLK)
 	{
 		/* Setup for a dropping block */
 		blockP->drop 	  = True;
-		blockP->nextFrame = frame + (rand() % DROP_DELAY) + 200;
+		ScheduleBlockTimer(row, col, TIMER_ANIMATE, 
+			frame + (GameRandom(RNG_BLOCKS) % DROP_DELAY) + 200);
 	} else if (blockType == ROAMER_BLK)
 	{
 		/* Setup for a roaming block */
-		blockP->nextFrame = frame + (rand() % ROAM_EYES_DELAY) + 50;
-		blockP->lastFrame = frame + (rand() % ROAM_DELAY) + 300;
+		ScheduleBlockTimer(row, col, TIMER_ANIMATE, 
+			frame + (GameRandom(RNG_BLOCKS) % ROAM_EYES_DELAY) + 50);
+		ScheduleBlockTimer(row, col, TIMER_EXPIRE, 
+			frame + (GameRandom(RNG_BLOCKS) % ROAM_DELAY) + 300);
 	}
 
 	/* Work out all the block geometry stuff */
 	CalculateBlockGeometry(row, col);
+
+	/* Record the new block in the bitboards */
+	SyncBlockCell(row, col);
 	
 	/* Add the number of points that will be awarded for each block */
 	switch(blockType)
@@ -2382,7 +1882,8 @@ void AddNewBlock(Display *display, Window window, int row, int col,
 			break;
 
 		case EXTRABALL_BLK:
-			blockP->nextFrame = frame + EXTRABALL_DELAY;
+			ScheduleBlockTimer(row, col, TIMER_ANIMATE, 
+				frame + EXTRABALL_DELAY);
 			blockP->hitPoints = 100;
 			break;
 
@@ -2400,7 +1901,7 @@ void AddNewBlock(Display *display, Window window, int row, int col,
 
 		case DEATH_BLK:
 			blockP->hitPoints = 0;
-			blockP->nextFrame = frame + DEATH_DELAY2;
+			ScheduleBlockTimer(row, col, TIMER_ANIMATE, frame + DEATH_DELAY2);
 			break;
 
 		default:
@@ -2468,77 +1969,190 @@ void SkipToNextLevel(Display *display, Window window)
 
 void RedrawAllBlocks(Display *display, Window window)
 {
-    struct aBlock *blockP;
-	int r, c;
+	/* Throw the whole block layer away and draw it from scratch */
+	InvalidateBlockLayer();
+	DrawBlockLayer(display, window);
+}
 
-	for (r = 0; r < MAX_ROW; r++)
+void InvalidateBlockLayer(void)
+{
+	int w;
+
+	/* Every cell is redrawn into the block layer on the next frame */
+	for (w = 0; w < GRID_WORDS; w++)
+		layerDirty.word[w] = ~0ULL;
+}
+
+static void GetAnimatedCells(BITBOARD *board)
+{
+	/*
+	 * The blocks that change by themselves every so often are never put
+	 * in the block layer - they are drawn over it each frame instead.
+	 */
+
+	int w;
+
+	for (w = 0; w < GRID_WORDS; w++)
 	{
-		for (c = 0; c < MAX_COL; c++)
+		board->word[w] = occupiedBits.word[w] & (explodingBits.word[w] |
+			typeBits[BONUS_BLK].word[w] | typeBits[BONUSX2_BLK].word[w] |
+			typeBits[BONUSX4_BLK].word[w] | typeBits[DEATH_BLK].word[w] |
+			typeBits[EXTRABALL_BLK].word[w] | typeBits[ROAMER_BLK].word[w]);
+	}
+}
+
+static void RebuildBlockLayer(Display *display, Window window,
+	BITBOARD *animated)
+{
+#ifndef HEADLESS
+	/*
+	 * Redraw just the dirty cells of the block layer, making the layer the
+	 * first time through. Each cell is wiped back to transparent first and
+	 * then the block that is in it, if it is not an animated one, is drawn
+	 * again.
+	 */
+
+	struct aBlock *blockP;
+	unsigned long long bits;
+	int w, cell, r, c, dirty = False;
+
+	if (blockLayerLoaded == False)
+	{
+		blockLayer = LoadRenderTexture(PLAY_WIDTH, PLAY_HEIGHT);
+		blockLayerLoaded = True;
+		InvalidateBlockLayer();
+	}
+
+	for (w = 0; w < GRID_WORDS; w++)
+		if (layerDirty.word[w] != 0) dirty = True;
+
+	/* Nothing has changed since the last frame */
+	if (dirty == False)
+		return;
+
+	BeginTextureMode(blockLayer);
+	layerDrawing = True;
+
+	for (w = 0; w < GRID_WORDS; w++)
+	{
+		for (bits = layerDirty.word[w]; bits != 0; bits &= bits - 1)
 		{
-			/* Pointer to the block we want */
+			cell = (w << 6) + __builtin_ctzll(bits);
+			if (cell >= GRID_CELLS) break;
+
+			r = cell / MAX_COL;
+			c = cell % MAX_COL;
 			blockP = &blocks[r][c];
 
-			if (blockP->occupied == True)
-				DrawBlock(display, window, r, c, blockP->blockType);
+			BeginScissorMode(c * colWidth, r * rowHeight, colWidth, rowHeight);
+			ClearBackground(BLANK);
+			EndScissorMode();
+
+			if (blockP->occupied == False || 
+				(animated->word[w] & BIT_MASK(cell)) != 0)
+				continue;
+
+			DrawTheBlock(display, window, blockP->x, blockP->y,
+				blockP->drawnType, blockP->drawnSlide, r, c);
+
+			if (blockP->explodeAll == True)
+				DrawTheBlock(display, window, blockP->x, blockP->y,
+					DYNAMITE_BLK, 0, r, c);
 		}
-	}	
+
+		layerDirty.word[w] = 0ULL;
+	}
+
+	layerDrawing = False;
+	EndTextureMode();
+#endif
 }
 
-int StillActiveBlocks(void)
+static void DrawAnimatedBlocks(Display *display, Window window,
+	BITBOARD *animated)
 {
-	/*
-	 * Returns False if level is finished. True otherwise.
-	 */
+	/* Draw the animating blocks over the block layer as they look now */
 
-    struct aBlock *blockP;
-	int r, c;
+	struct aBlock *blockP;
+	unsigned long long bits;
+	int w, cell, r, c;
 
-	/* Check all blocks to see if they still are active */
-	for (r = 0; r < MAX_ROW; r++)
+	layerDrawing = True;
+
+	for (w = 0; w < GRID_WORDS; w++)
 	{
-		for (c = 0; c < MAX_COL; c++)
+		for (bits = animated->word[w]; bits != 0; bits &= bits - 1)
 		{
-			/* Pointer to the block we want */
+			cell = (w << 6) + __builtin_ctzll(bits);
+			r = cell / MAX_COL;
+			c = cell % MAX_COL;
 			blockP = &blocks[r][c];
 
-			/* Don't bother me if the block is not occupied */
-			if (blockP->occupied == True) 
+			if (blockP->exploding == True)
 			{
-				/* 
-				 * Check the type of block as specials are not needed to be
-				 * killed - only some blocks are required to finish a level.
-				 */
-				switch (blockP->blockType)
-				{
-					/* These blocks don't count */
+				/* Slides 2 to 4 show explosion frames 0 to 2 */
+				if (blockP->explodeSlide >= 2 && blockP->explodeSlide <= 4)
+					ExplodeBlockType(display, window, blockP->x, blockP->y,
+						r, c, blockP->blockType, blockP->explodeSlide - 2);
+			}
+			else
+				DrawTheBlock(display, window, blockP->x, blockP->y,
+					blockP->drawnType, blockP->drawnSlide, r, c);
+		}
+	}
 
-					case BLACK_BLK:
-					case BULLET_BLK:
-					case ROAMER_BLK:
-					case BOMB_BLK:
-					case TIMER_BLK:
-					case HYPERSPACE_BLK:
-					case STICKY_BLK:
-					case MULTIBALL_BLK:
-					case MAXAMMO_BLK:
-        			case PAD_SHRINK_BLK:
-					case PAD_EXPAND_BLK:
-					case REVERSE_BLK:
-					case MGUN_BLK:
-					case WALLOFF_BLK:
-					case EXTRABALL_BLK:
-					case DEATH_BLK:
-					case BONUSX2_BLK:
-					case BONUSX4_BLK:
-					case BONUS_BLK:
-						break;
+	layerDrawing = False;
+}
 
-					default:
-						return True;
-				}
-			}
-		} 	/* cols */
-	}	/* rows */
+void DrawBlockLayer(Display *display, Window window)
+{
+	/*
+	 * Draw the whole block field for this frame. The blocks that are
+	 * sitting still come from the block layer in one quad, rebuilt only
+	 * where a cell has changed since the last frame. Bonus coins, death
+	 * blocks, roamers and explosions are drawn on top of it.
+	 */
+
+	BITBOARD animated;
+
+	GetAnimatedCells(&animated);
+	RebuildBlockLayer(display, window, &animated);
+
+#ifndef HEADLESS
+	/* Render textures are stored upside down so flip it back */
+	DrawTextureRec(blockLayer.texture, 
+		(Rectangle) { 0, 0, PLAY_WIDTH, -PLAY_HEIGHT }, 
+		(Vector2) { 0, 0 }, WHITE);
+#endif
+
+	DrawAnimatedBlocks(display, window, &animated);
+}
+
+static void FreeBlockLayer(void)
+{
+#ifndef HEADLESS
+	if (blockLayerLoaded == True)
+		UnloadRenderTexture(blockLayer);
+
+	blockLayerLoaded = False;
+#endif
+}
+
+int StillActiveBlocks(void)
+{
+	/*
+	 * Returns False if level is finished. True otherwise.
+	 */
+
+	int w;
+
+	/* 
+	 * Specials are not needed to be killed - only some blocks are required
+	 * to finish a level. See IsRequiredType().
+	 */
+	for (w = 0; w < GRID_WORDS; w++)
+		if (requiredBits.word[w] != 0)
+			return True;
 
 	/* Only all done when explosions are finished */
 	if (blocksExploding > 1)
@@ -2552,8 +2166,8 @@ void ClearBlock(int row, int col)
 {
     struct aBlock *blockP;
 
-	if (row > MAX_ROW || row < 0) return;
-	if (col > MAX_COL || col < 0) return;
+	if (row >= MAX_ROW || row < 0) return;
+	if (col >= MAX_COL || col < 0) return;
 
 	/* Pointer to the block we want */
 	blockP = &blocks[row][col];
@@ -2562,6 +2176,11 @@ void ClearBlock(int row, int col)
 	if (blockP->exploding && blocksExploding > 0)
 		blocksExploding--;
 
+	/* Take the block off the timer wheel before its frames are reset */
+	CancelBlockTimer(row, col, TIMER_ANIMATE);
+	CancelBlockTimer(row, col, TIMER_EXPIRE);
+	CancelBlockTimer(row, col, TIMER_EXPLODE);
+
 	/* Initialise everything in block */
 	blockP->occupied 			= False;
 	blockP->exploding 			= False;
@@ -2588,48 +2207,358 @@ void ClearBlock(int row, int col)
 	blockP->balldy 				= 0;
 	blockP->specialPopup 		= False;
 	blockP->explodeAll 			= False;
+	blockP->drawnType 			= NONE_BLK;
+	blockP->drawnSlide 			= 0;
+
+	/* Nothing in this cell any more */
+	SyncBlockCell(row, col);
+}
+
+
+void ClearBlockArray(void)
+{
+	int r, c;
+
+	/* Scan through all block entries and erase their contents */
+	for (r = 0; r < MAX_ROW; r++)
+	{
+		for (c = 0; c < MAX_COL; c++)
+		{
+			/* Clear the block thanks */
+			ClearBlock(r, c);
+		}
+	}
+}
+
+static int IsRequiredType(int blockType)
+{
+	/*
+	 * Returns True if blocks of this type must be killed before the level
+	 * is finished.
+	 */
+
+	switch (blockType)
+	{
+		/* These blocks don't count */
+
+		case BLACK_BLK:
+		case BULLET_BLK:
+		case ROAMER_BLK:
+		case BOMB_BLK:
+		case TIMER_BLK:
+		case HYPERSPACE_BLK:
+		case STICKY_BLK:
+		case MULTIBALL_BLK:
+		case MAXAMMO_BLK:
+		case PAD_SHRINK_BLK:
+		case PAD_EXPAND_BLK:
+		case REVERSE_BLK:
+		case MGUN_BLK:
+		case WALLOFF_BLK:
+		case EXTRABALL_BLK:
+		case DEATH_BLK:
+		case BONUSX2_BLK:
+		case BONUSX4_BLK:
+		case BONUS_BLK:
+			return False;
 
-	/* Destroy the top region of the block */
-	if (blockP->regionTop != (Region) NULL)
+		default:
+			return True;
+	}
+}
+
+static void SyncBlockCell(int row, int col)
+{
+	/*
+	 * Bring the bitboards and the hot table into line with the block at
+	 * row, col. Must be called whenever a block is added, cleared, set
+	 * exploding or changes type so the grid queries below never have to
+	 * scan blocks[][] and the collision code never has to touch it.
+	 */
+
+    struct aBlock *blockP;
+	unsigned long long mask;
+	int w, t, cell;
+
+	blockP = &blocks[row][col];
+	cell = GRID_CELL(row, col);
+	w = BIT_WORD(cell);
+	mask = BIT_MASK(cell);
+
+	/* Copy the fields collisions need into the packed arrays */
+	hotBlocks.flags[cell] 	= (blockP->occupied ? BLOCK_OCCUPIED : 0) |
+		(blockP->exploding ? BLOCK_EXPLODING : 0);
+	hotBlocks.type[cell] 	= (signed char) blockP->blockType;
+	hotBlocks.x[cell] 		= (short) blockP->x;
+	hotBlocks.y[cell] 		= (short) blockP->y;
+	hotBlocks.width[cell] 	= (short) blockP->width;
+	hotBlocks.height[cell] 	= (short) blockP->height;
+
+	/* Forget whatever used to be in this cell */
+	occupiedBits.word[w] 	&= ~mask;
+	explodingBits.word[w] 	&= ~mask;
+	requiredBits.word[w] 	&= ~mask;
+	for (t = 0; t < MAX_BLOCKS; t++)
+		typeBits[t].word[w] &= ~mask;
+
+	if (blockP->occupied)
 	{
-		XDestroyRegion(blockP->regionTop);
-		blockP->regionTop = (Region) NULL;
+		occupiedBits.word[w] |= mask;
+
+		if (IsRequiredType(blockP->blockType) == True)
+			requiredBits.word[w] |= mask;
+
+		if (blockP->blockType >= 0 && blockP->blockType < MAX_BLOCKS)
+			typeBits[blockP->blockType].word[w] |= mask;
 	}
 
-	/* Destroy the bottom region of the block */
-	if (blockP->regionBottom != (Region) NULL)
+	if (blockP->exploding)
+		explodingBits.word[w] |= mask;
+
+	/* The cell looks different now so the block layer must redraw it */
+	layerDirty.word[w] |= mask;
+}
+
+static int CountBits(BITBOARD *board)
+{
+	int w, count = 0;
+
+	for (w = 0; w < GRID_WORDS; w++)
+		count += __builtin_popcountll(board->word[w]);
+
+	return count;
+}
+
+static int FindNthBit(BITBOARD *board, int n)
+{
+	/*
+	 * Returns the cell of the n'th set bit counting from 0, or -1 if the 
+	 * board has n bits or less set.
+	 */
+
+	unsigned long long bits;
+	int w, count;
+
+	for (w = 0; w < GRID_WORDS; w++)
 	{
-		XDestroyRegion(blockP->regionBottom);
-		blockP->regionBottom = (Region) NULL;
+		bits = board->word[w];
+		count = __builtin_popcountll(bits);
+
+		/* Skip whole words at a time */
+		if (n >= count)
+		{
+			n -= count;
+			continue;
+		}
+
+		/* Drop the lowest set bits until the one we want is lowest */
+		while (n-- > 0)
+			bits &= bits - 1;
+
+		return (w << 6) + __builtin_ctzll(bits);
 	}
 
-	/* Destroy the left region of the block */
-	if (blockP->regionLeft != (Region) NULL)
+	return -1;
+}
+
+int IsBlockOccupied(int row, int col)
+{
+	int cell;
+
+	/* Nothing is ever off the grid */
+	if (row < 0 || row >= MAX_ROW) return False;
+	if (col < 0 || col >= MAX_COL) return False;
+
+	cell = GRID_CELL(row, col);
+	return (occupiedBits.word[BIT_WORD(cell)] & BIT_MASK(cell)) ? True : False;
+}
+
+int IsBlockFree(int row, int col)
+{
+	int cell;
+
+	/* No room off the grid */
+	if (row < 0 || row >= MAX_ROW) return False;
+	if (col < 0 || col >= MAX_COL) return False;
+
+	/* Neither occupied nor still blowing up */
+	cell = GRID_CELL(row, col);
+	return ((occupiedBits.word[BIT_WORD(cell)] | 
+		explodingBits.word[BIT_WORD(cell)]) & BIT_MASK(cell)) ? False : True;
+}
+
+int PickRandomFreeBlock(int firstRow, int lastRow, int firstCol, int lastCol,
+	int *row, int *col)
+{
+	/*
+	 * Choose a cell at random from all the free cells within the rows
+	 * and columns given, inclusive. Returns False if there are none.
+	 */
+
+	BITBOARD free;
+	int r, c, w, cell, count;
+
+	/* Cells in the area asked for */
+	memset(&free, 0, sizeof(free));
+	for (r = (firstRow < 0) ? 0 : firstRow; r <= lastRow && r < MAX_ROW; r++)
 	{
-		XDestroyRegion(blockP->regionLeft);
-		blockP->regionLeft = (Region) NULL;
+		for (c = (firstCol < 0) ? 0 : firstCol; c <= lastCol && c < MAX_COL; c++)
+		{
+			cell = GRID_CELL(r, c);
+			free.word[BIT_WORD(cell)] |= BIT_MASK(cell);
+		}
 	}
 
-	/* Destroy the right region of the block */
-	if (blockP->regionRight != (Region) NULL)
+	/* Less the ones with a block in them or blowing up */
+	for (w = 0; w < GRID_WORDS; w++)
+		free.word[w] &= ~(occupiedBits.word[w] | explodingBits.word[w]);
+
+	if ((count = CountBits(&free)) == 0)
+		return False;
+
+	cell = FindNthBit(&free, GameRandom(RNG_BLOCKS) % count);
+	*row = cell / MAX_COL;
+	*col = cell % MAX_COL;
+
+	return True;
+}
+
+void ChangeBlockType(int row, int col, int blockType)
+{
+	/* Change the type of a block in place, eg: random blocks */
+	blocks[row][col].blockType = blockType;
+	blocks[row][col].drawnType = blockType;
+	SyncBlockCell(row, col);
+}
+
+static int *TimerDeadline(struct aBlock *blockP, int timer)
+{
+	/* The frame each timer goes off on is kept in the block itself */
+	switch (timer)
 	{
-		XDestroyRegion(blockP->regionRight);
-		blockP->regionRight = (Region) NULL;
+		case TIMER_EXPIRE:	return &blockP->lastFrame;
+		case TIMER_EXPLODE:	return &blockP->explodeNextFrame;
+		default:			return &blockP->nextFrame;
 	}
 }
 
+void ScheduleBlockTimer(int row, int col, int timer, int when)
+{
+	/*
+	 * Set one of the timers of the block at row, col to go off on frame
+	 * when, replacing any time it was already set for. Always use this
+	 * rather than writing nextFrame, lastFrame or explodeNextFrame by hand
+	 * or the wheel will never see the new time.
+	 */
 
-void ClearBlockArray(void)
+	int cell;
+
+	if (row < 0 || row >= MAX_ROW) return;
+	if (col < 0 || col >= MAX_COL) return;
+
+	CancelBlockTimer(row, col, timer);
+	*TimerDeadline(&blocks[row][col], timer) = when;
+
+	cell = GRID_CELL(row, col);
+
+	/* Wheel has already gone past that frame so it is due right away */
+	if (when <= wheelFrame[timer])
+		dueBits[timer].word[BIT_WORD(cell)] |= BIT_MASK(cell);
+	else
+		timerWheel[timer][when & WHEEL_MASK].word[BIT_WORD(cell)] |= 
+			BIT_MASK(cell);
+}
+
+void CancelBlockTimer(int row, int col, int timer)
 {
-	int r, c;
+	/* Stop one of the timers of the block at row, col from going off */
+	int cell, when;
 
-	/* Scan through all block entries and erase their contents */
-	for (r = 0; r < MAX_ROW; r++)
+	if (row < 0 || row >= MAX_ROW) return;
+	if (col < 0 || col >= MAX_COL) return;
+
+	cell = GRID_CELL(row, col);
+	when = *TimerDeadline(&blocks[row][col], timer);
+
+	timerWheel[timer][when & WHEEL_MASK].word[BIT_WORD(cell)] &= 
+		~BIT_MASK(cell);
+	dueBits[timer].word[BIT_WORD(cell)] &= ~BIT_MASK(cell);
+}
+
+static void CollectDueTimers(int timer)
+{
+	/*
+	 * Turn the wheel up to the current frame and move every timer that
+	 * has gone off into dueBits. Timers a lap or more away stay put.
+	 * Frames missed while the game was not running (paused etc) are
+	 * caught up, a whole lap of the wheel at most.
+	 */
+
+	BITBOARD *slot;
+	unsigned long long bits;
+	int f, first, w, cell;
+
+	first = wheelFrame[timer] + 1;
+	if (frame - first >= WHEEL_SLOTS)
+		first = frame - WHEEL_SLOTS + 1;
+
+	for (f = first; f <= frame; f++)
 	{
-		for (c = 0; c < MAX_COL; c++)
+		slot = &timerWheel[timer][f & WHEEL_MASK];
+
+		for (w = 0; w < GRID_WORDS; w++)
 		{
-			/* Clear the block thanks */
-			ClearBlock(r, c);
+			for (bits = slot->word[w]; bits != 0; bits &= bits - 1)
+			{
+				cell = (w << 6) + __builtin_ctzll(bits);
+
+				if (*TimerDeadline(&blocks[cell / MAX_COL][cell % MAX_COL],
+					timer) <= frame)
+				{
+					slot->word[w] 			&= ~BIT_MASK(cell);
+					dueBits[timer].word[w] 	|= BIT_MASK(cell);
+				}
+			}
 		}
 	}
+
+	wheelFrame[timer] = frame;
+}
+
+static int TakeDueTimer(int timer, int cell)
+{
+	/* Returns True and clears it if the timer for cell is due */
+	int w = BIT_WORD(cell);
+
+	if ((dueBits[timer].word[w] & BIT_MASK(cell)) == 0)
+		return False;
+
+	dueBits[timer].word[w] &= ~BIT_MASK(cell);
+	return True;
+}
+
+static int NextDueCell(int timer1, int timer2, int first)
+{
+	/*
+	 * Returns the first cell from first on with either timer due, or -1.
+	 * Timers that go off while the cells are being handled are picked up
+	 * if they are further on, just as the old row by row scan did.
+	 */
+
+	unsigned long long bits;
+	int w;
+
+	for (w = BIT_WORD(first); w < GRID_WORDS; w++)
+	{
+		bits = dueBits[timer1].word[w] | dueBits[timer2].word[w];
+
+		/* Ignore the cells before first in its own word */
+		if (w == BIT_WORD(first))
+			bits &= ~0ULL << (first & 63);
+
+		if (bits != 0)
+			return (w << 6) + __builtin_ctzll(bits);
+	}
+
+	return -1;
 }
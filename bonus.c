@@ -339,7 +339,7 @@ static void DoBonuses(Display *display, Window window)
 	if (secs == 0)
 	{
 		/* Play the sound for the super bonus */
-		//if (noSound == False) playSoundFile("Doh4", 80);
+		//if (noSound == False) playSound(SND_DOH4, 80);
 		/*
 		strcpy(string, "Bonus coins void - Timer ran out!");
 		DrawShadowCentredText(display, window, textFont, 
@@ -362,7 +362,7 @@ static void DoBonuses(Display *display, Window window)
 		if (numBonus == 0)
 		{
 			/* Play the sound for the super bonus */
-			//if (noSound == False) playSoundFile("Doh1", 80);
+			//if (noSound == False) playSound(SND_DOH1, 80);
 
 			/* No bonus coins - so tell user */
 			//strcpy(string, "Sorry, no bonus coins collected.");
@@ -381,7 +381,7 @@ static void DoBonuses(Display *display, Window window)
 		if (numBonus > MAX_BONUS)
 		{
 			/* Play the sound for the super bonus */
-			//if (noSound == False) playSoundFile("supbons", 80);
+			//if (noSound == False) playSound(SND_SUPBONS, 80);
 
 			/* More than 10 coins collected - super bonus reward */
 			//sprintf(string, "Super Bonus - %ld",
@@ -415,7 +415,7 @@ static void DoBonuses(Display *display, Window window)
 
 	/* Play the sound for the bonus */
 	//if (noSound == False)
-		//playSoundFile("bonus", 50);
+		//playSound(SND_BONUS, 50);
 
 	/* Increment the score by the value of the bonus */
 	//bonusScore += ComputeScore(BONUS_COIN_SCORE);
@@ -472,7 +472,7 @@ static void DoLevel(Display *display, Window window)
 			//string, ypos, yellow, TOTAL_WIDTH);
 
 		/* Play the sound for the super bonus */
-		//if (noSound == False) playSoundFile("Doh2", 80);
+		//if (noSound == False) playSound(SND_DOH2, 80);
 	}
 
 	/* Next section setup */
@@ -501,7 +501,7 @@ static void DoBullets(Display *display, Window window)
 				//string, ypos, blue, TOTAL_WIDTH);
 
 			/* Play the sound for the super bonus */
-			//if (noSound == False) playSoundFile("Doh3", 80);
+			//if (noSound == False) playSound(SND_DOH3, 80);
 			
 			//SetGameSpeed(SLOW_SPEED);
 
@@ -524,7 +524,7 @@ static void DoBullets(Display *display, Window window)
 
 	/* Play the sound for the bullets */
 	if (noSound == False) 
-		//playSoundFile("key", 50);
+		//playSound(SND_KEY, 50);
 
 	/* Increment the score by the value of the bullet bonus */
 	//bonusScore += ComputeScore(BULLET_SCORE);
@@ -572,7 +572,7 @@ static void DoTimeBonus(Display *display, Window window)
 			//string, ypos, yellow, TOTAL_WIDTH);
 
 		/* Play the sound for the super bonus */
-		if (noSound == False);//playSoundFile("Doh4", 80);
+		if (noSound == False);//playSound(SND_DOH4, 80);
 	}
 
 	/* Next section setup */
@@ -640,7 +640,7 @@ static void DoEndText(Display *display, Window window)
 		//string, ypos, yellow, TOTAL_WIDTH);
 	//XFlush(display);
 
-	if (noSound == False);// playSoundFile("applause", 80);
+	if (noSound == False);// playSound(SND_APPLAUSE, 80);
 
 	//SetBonusWait(BONUS_FINISH, frame + LINE_DELAY * 2);
 }
@@ -238,7 +238,7 @@ static void DoFinish(/*Display*/int *display, /*/Window*/int  window)
    // mode = MODE_KEYS;
 
 	/*/if (noSound == False)
-		playSoundFile("whizzo", 50);
+		playSound(SND_WHIZZO, 50);
 */}
 
 void Demonstration(/*/Display*/int *display,/*/ Window*/int window)
@@ -62,6 +62,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stddef.h>
+#include <unistd.h>
 //#include <X11/Xlib.h>	//Replace this with RayLib
 //#include <X11/Xutil.h>	//Replace this with RayLib
 //#include <X11/Xos.h>	//Replace this with RayLib
@@ -77,6 +78,8 @@
 #include "intro.h"
 #include "main.h"
 #include "misc.h"
+#include "hud.h"
+#include "assets.h"
 
 #include "bitmaps/floppy.xpm"
 #include "bitmaps/question.xpm"
@@ -189,6 +192,9 @@ char *UserInputDialogueMessage(Display *display, char *message, int type,
 	validation 		= entryValidation;
 	mode 			= MODE_DIALOGUE;
 
+	/* The game loop is held up so load the icons here */
+	UseModeAssets(display, mode);
+
 	/* Null the current input string */
 	strcpy(currentInput, "");
 
@@ -264,8 +270,10 @@ static void ShowUserInputDialogue(Display *display)
  */
 static void RemoveUserInputDialogue(Display *display)
 {
+	/* The game loop is held up so run the fade here at about 60Hz */
 	while (WindowFadeEffect(display, inputWindow, 
-		DIALOGUE_WIDTH, DIALOGUE_HEIGHT));
+		DIALOGUE_WIDTH, DIALOGUE_HEIGHT))
+		usleep(16000);
 
 	DEBUG("RemoveUserInputDialogue() unmapping dialogue.");
 
@@ -394,12 +402,12 @@ static void validateDialogueKeys(Display *display, KeySym keysym, char *str)
 		}
 
 		/* Play a bit of sound */
-   		if (noSound == False) playSoundFile("click", 70);
+   		if (noSound == False) playSound(SND_CLICK, 70);
 	}
 	else
 	{
 		/* Play a bit of sound */
-   		if (noSound == False) playSoundFile("tone", 40);
+   		if (noSound == False) playSound(SND_TONE, 40);
 	}
 }
 
@@ -447,7 +455,7 @@ void handleDialogueKeys(Display *display, XEvent event)
 				redrawCurrentInput(display);
 
 				/* Play a bit of sound */
-   				if (noSound == False) playSoundFile("key", 70);
+   				if (noSound == False) playSound(SND_KEY, 70);
 			}
 			break;
 
@@ -475,6 +483,9 @@ static void handleDialogueEventLoop(Display *display)
 
     pending = 0;
 
+	/* The game loop is held up so show any message set for the dialogue */
+	FlushHud(display);
+	FlushSounds();
 	ProcessDialogue(display);
 	XFlush(display);
     XNextEvent(display, &event);
@@ -513,6 +524,9 @@ static void handleDialogueEventLoop(Display *display)
         }
 
 		ProcessDialogue(display);
+
+		/* The game loop is not running to start the key clicks */
+		FlushSounds();
 	}
 }
 
@@ -517,7 +517,7 @@ static void DoFinish(Display *display, Window window)
     	KeyPressMask | KeyReleaseMask | ButtonPressMask |
         ButtonReleaseMask | ExposureMask | StructureNotifyMask);
 
-    if (noSound == False) playSoundFile("evillaugh", 50);
+    if (noSound == False) playSound(SND_EVILLAUGH, 50);
 
     SetGameSpeed(FAST_SPEED);
 }
@@ -569,7 +569,7 @@ void HandleButtonMotion(Display *display, XEvent event)
 				oldCol = col; oldRow = row;
 				modified = True;
 
-    			if (noSound == False) playSoundFile("bonus", 20);
+    			if (noSound == False) playSound(SND_BONUS, 20);
 			}
             break;
 
@@ -581,7 +581,7 @@ void HandleButtonMotion(Display *display, XEvent event)
 				oldCol = col; oldRow = row;
 				modified = True;
 
-    			if (noSound == False) playSoundFile("bonus", 20);
+    			if (noSound == False) playSound(SND_BONUS, 20);
 			}
             break;
 
@@ -656,7 +656,7 @@ void HandleEditorMouseButtons(Display *display, XEvent event, int Down)
 				oldCol = col; oldRow = row;
 				modified = True;
 
-    			if (noSound == False) playSoundFile("bonus", 20);
+    			if (noSound == False) playSound(SND_BONUS, 20);
                 break;
 
             case Button2:
@@ -667,7 +667,7 @@ void HandleEditorMouseButtons(Display *display, XEvent event, int Down)
 				oldCol = col; oldRow = row;
 				modified = True;
 
-    			if (noSound == False) playSoundFile("bonus", 20);
+    			if (noSound == False) playSound(SND_BONUS, 20);
                 break;
 
             case Button3:
@@ -796,7 +796,7 @@ static void FlipBoardHorizontal(Display *display)
     register int r, c;
 	int temp[MAX_ROW_EDIT][2];
 
-    if (noSound == False) playSoundFile("wzzz", 50);
+    if (noSound == False) playSound(SND_WZZZ, 50);
 
 	/* Change all random blocks to RANDOM_BLKS for editor */
 	HandleRandomBlocks(display);
@@ -839,7 +839,7 @@ static void ScrollBoardHorizontal(Display *display)
 	int temp[MAX_ROW_EDIT][2];
 	int temp2[MAX_ROW_EDIT][2];
 
-    if (noSound == False) playSoundFile("sticky", 50);
+    if (noSound == False) playSound(SND_STICKY, 50);
 
 	/* Change all random blocks to RANDOM_BLKS for editor */
 	HandleRandomBlocks(display);
@@ -894,7 +894,7 @@ static void FlipBoardVertical(Display *display)
     register int r, c;
 	int temp[MAX_COL_EDIT][2];
 
-    if (noSound == False) playSoundFile("wzzz2", 50);
+    if (noSound == False) playSound(SND_WZZZ2, 50);
 
 	/* Change all random blocks to RANDOM_BLKS for editor */
 	HandleRandomBlocks(display);
@@ -940,7 +940,7 @@ static void ScrollBoardVertical(Display *display)
 	int temp[MAX_COL_EDIT][2];
 	int temp2[MAX_COL_EDIT][2];
 
-    if (noSound == False) playSoundFile("sticky", 50);
+    if (noSound == False) playSound(SND_STICKY, 50);
 
 	/* Change all random blocks to RANDOM_BLKS for editor */
 	HandleRandomBlocks(display);
@@ -999,7 +999,7 @@ static void HandleRandomBlocks(Display *display)
 		for (c = 0; c < MAX_COL_EDIT; c++)
 		{
 			if (blocks[r][c].random)
-				blocks[r][c].blockType = RANDOM_BLK;
+				ChangeBlockType(r, c, RANDOM_BLK);
 		}
 	}
 }
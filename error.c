@@ -119,6 +119,7 @@ void WarningMessage(char *message)
  * @param char *texture_name The name of the texture (printed in error message)
  *
  */
+#ifndef HEADLESS
 void HandleXPMError(Texture2D texture, char* texture_name)
 {
 	Display* display;// Fake variable needed to compile to object code
@@ -130,3 +131,5 @@ void HandleXPMError(Texture2D texture, char* texture_name)
 		ShutDown(display, 1, "Fatal error.");
 	}
 }
+#endif
+
@@ -85,6 +85,7 @@
 #include "include/ball.h"
 #include "include/special.h"
 #include "include/eyedude.h"
+#include "include/rng.h"
 #include "include/faketypes.h"
 
 /*
@@ -108,8 +109,10 @@ static Pixmap eyesLeft[6], eyesLeftM[6];
 static Pixmap eyesRight[6], eyesRightM[6];
 static Pixmap eyesDead, eyesDeadM;
 static int	x, y, oldx, oldy, s, direction, inc, turn;
+static int	shownSlide, shownDirection;
 static eyeDudeStates eyeDudeState;
 
+#ifndef HEADLESS
 void InitialiseEyeDudes(Display *display, Window window, Colormap colormap)
 {
     XpmAttributes   attributes;
@@ -173,6 +176,7 @@ void InitialiseEyeDudes(Display *display, Window window, Colormap colormap)
 
 	XpmFreeAttributes(&attributes);
 }
+#endif
 
 void FreeEyeDudes(Display *display)
 {
@@ -191,7 +195,7 @@ void FreeEyeDudes(Display *display)
 	if (eyesDeadM)	XFreePixmap(display, eyesDeadM);
 }
 
-static void DrawTheEyeDude(Display *display, Window window, int x, int y, 
+void DrawTheEyeDude(Display *display, Window window, int x, int y, 
 	int slide, int direction)
 {
 	/* Draw the eyedude pixmap into the window */
@@ -217,7 +221,7 @@ static void DrawTheEyeDude(Display *display, Window window, int x, int y,
 	}
 }
 
-static void EraseTheEyeDude(Display *display, Window window, int x, int y)
+void EraseTheEyeDude(Display *display, Window window, int x, int y)
 {
 	/* Erase the eye dude pixmap from the window */
     XClearArea(display, window, x - EYEDUDE_WC, y - EYEDUDE_HC, 
@@ -253,11 +257,11 @@ static void ResetEyeDude(Display *display, Window window)
 		return;
 	}
 
-	if ((rand() % 100) < 30)
+	if ((GameRandom(RNG_EYEDUDE) % 100) < 30)
 		turn = True;
 
 	/* Setup initial positions based on direction given */
-	switch (rand() % 2)
+	switch (GameRandom(RNG_EYEDUDE) % 2)
 	{
 		case 1: /* Walk left */
 			x = oldx = PLAY_WIDTH + EYEDUDE_WC;
@@ -278,7 +282,7 @@ static void ResetEyeDude(Display *display, Window window)
 
 	ChangeEyeDudeMode(EYEDUDE_WALK);
 
-	if (noSound == False) playSoundFile("hithere", 100);
+	if (noSound == False) playSound(SND_HITHERE, 100);
 }
 
 static int CheckEyeDudeClearPath(Display *display, Window window)
@@ -289,7 +293,7 @@ static int CheckEyeDudeClearPath(Display *display, Window window)
 	for (col = 0; col < MAX_COL; col++)
 	{
 		/* Check if the block is occupied and if so then return false */
-		if (blocks[0][col].occupied == True)
+		if (IsBlockOccupied(0, col) == True)
 			return False;
 	}
 
@@ -303,14 +307,19 @@ void GetEyeDudePosition(int *x, int *y)
 	*y = oldy;
 }
 
+void GetEyeDudeFrame(int *slide, int *dir)
+{
+	*slide 	= shownSlide;
+	*dir 	= shownDirection;
+}
+
 static void HandleEyeDudeWalk(Display *display, Window window)
 {
 	/* Update the eyedude that may be moving */
 	if ((frame % EYEDUDE_FRAME_RATE) == 0)
 	{
-		/* Erase and draw our new dude */
-		EraseTheEyeDude(display, window, oldx, oldy);
-		DrawTheEyeDude(display, window, x, y, s, direction);
+		/* Step our dude, the game snapshot draws him there */
+		shownSlide = s; shownDirection = direction;
 		oldx = x; oldy = y;
 
 		/* Update the frame of animation for dude */
@@ -376,7 +385,7 @@ void HandleEyeDudeMode(Display *display, Window window)
             AddToScore((u_long) EYEDUDE_HIT_BONUS);
             DisplayScore(display, scoreWindow, score);
 
-            if (noSound == False) playSoundFile("supbons", 80);
+            if (noSound == False) playSound(SND_SUPBONS, 80);
 			break;
 
 		case EYEDUDE_TURN:
@@ -17,6 +17,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stddef.h>
+#include <string.h>
 #include <time.h>
 
 //#include <X11/Xlib.h>
@@ -41,8 +42,9 @@
 #include "sfx.h"
 #include "blocks.h"
 #include "eyedude.h"
+#include "pack.h"
 
-#include "include\file.h"
+#include "file.h"
 
 /**
  * @def BUF_SIZE
@@ -277,6 +279,34 @@ int SaveCurrentGame(Display *display, Window window)
 }
 
 
+/**
+ * @brief Opens a level file, from the asset pack if it has the level
+ *
+ * Only the installed levels are packed, and never while editing so that
+ * a level saved from the editor is read back from its file.
+ *
+ * @param char *levelName Path of the level file
+ * @return The open level, or NULL if it cannot be opened
+ */
+static FILE *OpenLevelFile(char *levelName)
+{
+	char name[1024];
+	size_t len = strlen(LEVEL_INSTALL_DIR);
+	FILE *levelFile;
+
+	if (mode != MODE_EDIT && getenv("XBOING_LEVELS_DIR") == NULL &&
+		strncmp(levelName, LEVEL_INSTALL_DIR "/", len + 1) == 0)
+	{
+		/* Packed under its name in the source tree */
+		snprintf(name, sizeof(name), "levels/%s", levelName + len + 1);
+
+		if ((levelFile = OpenPackedLevel(name)) != NULL)
+			return levelFile;
+	}
+
+	return fopen(levelName, "r");
+}
+
 int ReadNextLevel(Display *display, Window window, char *levelName, int draw)
 {
     FILE *levelFile;
@@ -296,7 +326,7 @@ int ReadNextLevel(Display *display, Window window, char *levelName, int draw)
     ResetNumberBonus();
 
     /* Open the new level data file for reading */
-    if ((levelFile = fopen(levelName, "r")) == NULL)
+    if ((levelFile = OpenLevelFile(levelName)) == NULL)
     {
 		/* Cannot open the level data file */
 		perror(levelName);
@@ -71,6 +71,7 @@
 #include "include/ball.h"
 #include "include/special.h"
 #include "include/eyedude.h"
+#include "include/simclock.h"
 
 #include "include/gun.h"
 
@@ -99,8 +100,7 @@
 
 #define BULLET_FRAME_RATE	3
 
-/* Should be the same */
-#define MAX_MOVING_BULLETS	40	
+/* Should be the same as MAX_MOVING_BULLETS */
 #define MAX_TINKS			40	
 
 #define TINK_DELAY			100	
@@ -118,7 +118,6 @@ static int	StartABullet(Display *display, Window window, int xpos);
 static void ClearBullet(int i);
 static void DrawTheTink(Display *display, Window window, int x, int y);
 static void EraseTheTink(Display *display, Window window, int x, int y);
-static void DrawBullet(Display *display, Window window, int i);
 static int CheckForBulletCollision(Display *display, Window window, 
 	int x, int y);
 static int CheckBallBulletCollision(Display *display, Window window, 
@@ -148,6 +147,7 @@ static Pixmap bulletPixmap, bulletMask;
 static Pixmap tinkPixmap, tinkMask;
 static int numBullets, unlimitedBullets;
 
+#ifndef HEADLESS
 void InitialiseBullet(Display *display, Window window, Colormap colormap)
 {
     XpmAttributes   attributes;
@@ -173,6 +173,7 @@ void InitialiseBullet(Display *display, Window window, Colormap colormap)
 	ClearTinks();
 	ClearBullets();
 }
+#endif
 
 static void CheckTinks(Display *display, Window window)
 {
@@ -215,7 +216,7 @@ static void AddTink(Display *display, Window window, int xpos)
 			/* Draw the new found tink! */
 			DrawTheTink(display, window, xpos, 2);
 
-			if (noSound == False) playSoundFile("shoot", 80);
+			if (noSound == False) playSound(SND_SHOOT, 80);
 
 			return;
 		}
@@ -290,7 +291,7 @@ static void UpdateBullet(Display *display, Window window)
 						ClearBallNow(display, window, j);
 
 						/* Play the lovel ahhh pop sound for ball shot */
-						if (noSound == False) playSoundFile("ballshot", 50);
+						if (noSound == False) playSound(SND_BALLSHOT, 50);
 						break;
 					}
 				}
@@ -330,7 +331,7 @@ static void UpdateBullet(Display *display, Window window)
 					bullets[i].xpos, bullets[i].oldypos);
 
 				/* Switch on the type of block hit */
-				switch (blockP->blockType)
+				switch (GetBlockType(row, col))
 				{
 					case COUNTER_BLK:
 						if (blockP->counterSlide == 0)
@@ -384,8 +385,6 @@ static void UpdateBullet(Display *display, Window window)
 				/* Free the bullet up for another */
 				ClearBullet(i);
 			}
-			else
-				DrawBullet(display, window, i);
 
 			/* Keep track of old position */
 			bullets[i].oldypos = bullets[i].ypos;
@@ -505,13 +504,13 @@ void shootBullet(Display *display, Window window)
 			DeleteABullet(display);
 
 			/* Play a shooting sound */
-			if (noSound == False) playSoundFile("shotgun", 50);
+			if (noSound == False) playSound(SND_SHOTGUN, 50);
 		}
 	}
 	else if (GetNumberBullets() == 0)
 	{
 		/* Play an trigger clicking sound */
-		if (noSound == False) playSoundFile("click", 99);
+		if (noSound == False) playSound(SND_CLICK, 99);
 	}
 }
 
@@ -543,16 +542,6 @@ void DrawTheBullet(Display *display, Window window, int x, int y)
 		x - BULLET_WC, y - BULLET_HC, BULLET_WIDTH, BULLET_HEIGHT, False);
 }
 
-static void DrawBullet(Display *display, Window window, int i)
-{
-	/* Clear the window of the bullet in the old position */
-	XClearArea(display, window, bullets[i].xpos - BULLET_WC, 
-		bullets[i].oldypos - BULLET_HC, BULLET_WIDTH, BULLET_HEIGHT, False);
-
-	/* Now draw the new bullet in the new position */
-	DrawTheBullet(display, window, bullets[i].xpos, bullets[i].ypos);
-}
-
 static int CheckEyeDudeBulletCollision(Display *display, Window window, 
 	int bx, int by)
 {
@@ -595,24 +584,21 @@ static int CheckForBulletCollision(Display *display, Window window,
 	int x, int y)
 {
     /* Check for bullet to block collision */
-    int row, col;
-    struct aBlock *blockP;
+    int row, col, bx, by, bw, bh;
 
     /* Get the row and col for block where bullet is */
     X2COL(col, x);
     Y2ROW(row, y);
 
-    blockP = &blocks[row][col];
-
     /* If blocks is occupied then check for collision */
-    if (blockP->occupied == 1 && blockP->exploding == False)
+    if (IsBlockSolid(row, col) == True)
     {
+		GetBlockRect(row, col, &bx, &by, &bw, &bh);
+
         /* Check if x adjusted for bullet width is in block region */
-        if (((x + BULLET_WC) > blockP->x) &&
-          ((x - BULLET_WC) < (blockP->x + blockP->width)))
+        if (((x + BULLET_WC) > bx) && ((x - BULLET_WC) < (bx + bw)))
         {
-            if (((y + BULLET_HC) > blockP->y) &&
-              ((y - BULLET_HC) < (blockP->y + blockP->height)))
+            if (((y + BULLET_HC) > by) && ((y - BULLET_HC) < (by + bh)))
             {
                 /* Collision */
                 return True;
@@ -645,6 +631,28 @@ static int ResetBulletStart(Display *display, Window window)
 	return status;
 }
 
+int GetBulletRenderPosition(int i, int *x, int *y)
+{
+	float alpha;
+
+	/* Nothing to draw if this bullet is not moving */
+	if (i < 0 || i >= MAX_MOVING_BULLETS || bullets[i].xpos == -1)
+		return False;
+
+	/* 
+	 * Bullets move in a straight line every BULLET_FRAME_RATE frames so
+	 * blend from the last step to this one across that whole interval.
+	 */
+	alpha = ((float) (frame % BULLET_FRAME_RATE) + SimAlpha()) / 
+		(float) BULLET_FRAME_RATE;
+
+	*x = bullets[i].xpos;
+	*y = bullets[i].ypos - bullets[i].dy + 
+		(int) ((float) bullets[i].dy * alpha);
+
+	return True;
+}
+
 void HandleBulletMode(Display *display, Window window)
 {
 	/* Update all the bullets that may be moving */
@@ -0,0 +1,390 @@
+/*
+ * XBoing - An X11 blockout style computer game
+ *
+ * (c) Copyright 1993, 1994, 1995, Justin C. Kibell, All Rights Reserved
+ *
+ * The X Consortium, and any party obtaining a copy of these files from
+ * the X Consortium, directly or indirectly, is granted, free of charge, a
+ * full and unrestricted irrevocable, world-wide, paid up, royalty-free,
+ * nonexclusive right and license to deal in this software and
+ * documentation files (the "Software"), including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons who receive
+ * copies from any such party to do so.  This license includes without
+ * limitation a license to do the foregoing actions under any patents of
+ * the party supplying this software to the X Consortium.
+ *
+ * In no event shall the author be liable to any party for direct, indirect,
+ * special, incidental, or consequential damages arising out of the use of
+ * this software and its documentation, even if the author has been advised
+ * of the possibility of such damage.
+ *
+ * The author specifically disclaims any warranties, including, but not limited
+ * to, the implied warranties of merchantability and fitness for a particular
+ * purpose.  The software provided hereunder is on an "AS IS" basis, and the
+ * author has no obligation to provide maintenance, support, updates,
+ * enhancements, or modifications.
+ */
+
+/*
+ * =========================================================================
+ *
+ * Render-free backend for the headless simulation build.
+ *
+ * Every routine in here stands in for one in a module that is not linked
+ * into xboing-sim (misc.c, stage.c, mess.c, sfx.c, paddle.c, atlas.c,
+ * bonus.c, highscore.c, intro.c, dialogue.c and init.c). Drawing, window and
+ * texture calls do nothing; the few that carry game state (paddle size
+ * and position, bonus count) keep just enough to let the core run.
+ *
+ * =========================================================================
+ */
+
+/*
+ *  Include file dependencies:
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "include/faketypes.h"
+#include "include/ball.h"
+#include "include/blocks.h"
+#include "include/stage.h"
+#include "include/error.h"
+#include "include/simclock.h"
+#include "include/headless.h"
+#include "include/atlas.h"
+
+/*
+ *  Internal macro definitions:
+ */
+
+/*
+ *  Internal type declarations:
+ */
+
+/*
+ *  Internal variable declarations:
+ */
+
+/* Normally owned by init.c */
+int 			red, tann, yellow, green, white, black, blue, purple, reds[7],
+				greens[7];
+GC 				gc, gcxor, gcand, gcor, gcsfx, gccopy;
+static XFontStruct 	noFont;			/* Text is measured but never drawn */
+XFontStruct 	*titleFont = &noFont, *copyFont = &noFont, *textFont = &noFont,
+				*dataFont = &noFont;
+Colormap 		colormap;
+int				noicon;
+int				noSound = True, debug = False;
+
+/* Normally owned by stage.c */
+Window mainWindow, scoreWindow, levelWindow, playWindow, bufferWindow;
+Window messWindow, specialWindow, timeWindow, inputWindow;
+Window blockWindow, typeWindow;
+
+/* Normally owned by paddle.c */
+int 			paddlePos = PLAY_WIDTH / 2;
+int 			currentPaddleSize = PADDLE_HUGE;
+int 			reverseOn = False;
+static float 	paddleFraction = 0.0;	/* Key moves not a whole pixel yet */
+
+/* Normally owned by bonus.c */
+static int 		numBonus = 0;
+
+
+/*
+ *  X primitives used directly by the game core
+ */
+
+int XClearArea(Display *display, Window window, int x, int y,
+	unsigned int w, unsigned int h, int exposures)
+{
+	return 0;
+}
+
+int XClearWindow(Display *display, Window window)
+{
+	return 0;
+}
+
+int XSetWindowBorder(Display *display, Window window, unsigned long pixel)
+{
+	return 0;
+}
+
+int XFreePixmap(Display *display, Pixmap pixmap)
+{
+	return 0;
+}
+
+int XFlush(Display *display)
+{
+	return 0;
+}
+
+int XTextWidth(XFontStruct *font, const char *string, int count)
+{
+	return 0;
+}
+
+
+/*
+ *  misc.c
+ */
+
+void DrawText(Display *display, Window window, int x, int y,
+	XFontStruct *font, int colour, char *text, int numChar)
+{
+}
+
+void DrawShadowText(Display *display, Window window, XFontStruct *font,
+	char *string, int x, int y, int colour)
+{
+}
+
+void RenderShape(Display *display, Window window, Pixmap pixmap,
+	Pixmap mask, int x, int y, int w, int h, int clear)
+{
+}
+
+char *GetHomeDir(void)
+{
+	char *home;
+
+	/* Save files still work headless so honour $HOME */
+	if ((home = getenv("HOME")) == NULL)
+		return ".";
+
+	return home;
+}
+
+int ObtainMousePosition(Display *display, Window window, int *x, int *y)
+{
+	/* No pointer to poll - the simulator drives the paddle itself */
+	return False;
+}
+
+
+/*
+ *  atlas.c
+ */
+
+int GetSprite(char *name)
+{
+	/* Nothing is ever drawn so any handle will do */
+	return SPRITE_NONE;
+}
+
+void DrawSprite(int sprite, int x, int y)
+{
+}
+
+int GetSpriteWidth(int sprite)
+{
+	return 0;
+}
+
+int GetSpriteHeight(int sprite)
+{
+	return 0;
+}
+
+
+/*
+ *  stage.c / mess.c / sfx.c
+ */
+
+void DrawStageBackground(Display *display, Window window, int stageType,
+	int clear)
+{
+}
+
+void SetCurrentMessage(Display *display, Window window,
+	char *newMessage, int clear)
+{
+}
+
+void DrawMessage(Display *display, Window window, char *message, int clear,
+	int ci)
+{
+}
+
+void changeSfxMode(int newMode)
+{
+}
+
+void SetSfxEndFrame(int endFrame)
+{
+}
+
+
+/*
+ *  paddle.c
+ */
+
+int GetPaddleSize(void)
+{
+	/* Same pixel widths as the paddle images */
+	switch (currentPaddleSize)
+	{
+		case PADDLE_SMALL:	return 40;
+		case PADDLE_MEDIUM:	return 50;
+		case PADDLE_HUGE:
+		default:			return 70;
+	}
+}
+
+void ResetPaddleStart(Display *display, Window window)
+{
+	paddlePos = PLAY_WIDTH / 2;
+	paddleFraction = 0.0;
+}
+
+void ChangePaddleSize(Display *display, Window window, int type)
+{
+	/* Step the paddle one size up or down */
+	if (type == PAD_SHRINK_BLK && currentPaddleSize > PADDLE_SMALL)
+		currentPaddleSize--;
+	else if (type == PAD_EXPAND_BLK && currentPaddleSize < PADDLE_HUGE)
+		currentPaddleSize++;
+}
+
+void MovePaddle(Display *display, Window window, int direction, int size,
+	int xpos)
+{
+	int half = GetPaddleSize() / 2;
+	float distance = SIM_PADDLE_VEL * SimTickSeconds();
+	int step;
+
+	/* Replayed input moves the paddle the way the pointer or keys did */
+	switch (direction)
+	{
+		case PADDLE_LEFT:
+			paddleFraction -= (reverseOn == True) ? -distance : distance;
+			break;
+
+		case PADDLE_RIGHT:
+			paddleFraction += (reverseOn == True) ? -distance : distance;
+			break;
+
+		case PADDLE_NONE:
+		default:
+			paddlePos = (reverseOn == True) ? PLAY_WIDTH - xpos : xpos;
+			paddleFraction = 0.0;
+			break;
+	}
+
+	/* Move by whole pixels and keep the rest for the next tick */
+	step = (int) paddleFraction;
+	paddlePos += step;
+	paddleFraction -= step;
+
+	/* Keep the paddle inside the play area */
+	if (paddlePos < half || paddlePos > PLAY_WIDTH - half)
+		paddleFraction = 0.0;
+	if (paddlePos < half) 				paddlePos = half;
+	if (paddlePos > PLAY_WIDTH - half) 	paddlePos = PLAY_WIDTH - half;
+}
+
+void ToggleReverse(Display *display)
+{
+	reverseOn = !reverseOn;
+}
+
+void SetReverseOff(void)
+{
+	reverseOn = False;
+}
+
+/**
+ * @brief Moves the headless paddle directly under the lowest falling ball
+ */
+void HeadlessTrackBall(void)
+{
+	int i, target = -1, lowest = -1;
+	int half = GetPaddleSize() / 2;
+
+	/* Chase whichever active ball is closest to the paddle line */
+	for (i = 0; i < MAX_BALLS; i++)
+	{
+		if (balls[i].active == True && balls[i].dy > 0 &&
+			balls[i].bally > lowest)
+		{
+			lowest = balls[i].bally;
+			target = balls[i].ballx;
+		}
+	}
+
+	if (target == -1)
+		return;
+
+	/* Keep the paddle inside the play area */
+	if (target < half) 				target = half;
+	if (target > PLAY_WIDTH - half) target = PLAY_WIDTH - half;
+
+	paddleDx  = target - paddlePos;
+	paddlePos = target;
+	paddleFraction = 0.0;
+}
+
+
+/*
+ *  bonus.c / highscore.c / intro.c / dialogue.c / init.c
+ */
+
+void SetupBonusScreen(Display *display, Window window)
+{
+}
+
+void IncNumberBonus(void)
+{
+	numBonus++;
+}
+
+int GetNumberBonus(void)
+{
+	return numBonus;
+}
+
+void ResetNumberBonus(void)
+{
+	numBonus = 0;
+}
+
+int GetHighScoreRanking(u_long score)
+{
+	/* Never a boing master so no words of wisdom are asked for */
+	return -1;
+}
+
+int CheckAndAddScoreToHighScore(u_long score, u_long level, time_t gameTime,
+	int type, char *message)
+{
+	return False;
+}
+
+void ResetHighScore(int type)
+{
+}
+
+void ResetIntroduction(void)
+{
+}
+
+char *UserInputDialogueMessage(Display *display, char *message, int type,
+	int entryValidation)
+{
+	return "";
+}
+
+void ShutDown(Display *display, int exitCode, char *message)
+{
+	/* No windows or pixmaps to free - just report and leave */
+	if (exitCode != 0)
+		ErrorMessage(message);
+
+	exit(exitCode);
+}
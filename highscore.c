@@ -164,6 +164,13 @@ char *GetNickName(void)
 }
 
 void SetUpHighScore(Display *display, Window window, Colormap colormap)
+{
+	/* Setup the high score table - the title is loaded on first showing */
+	InitialiseHighScores();
+	ResetHighScore(GLOBAL);
+}
+
+void SetUpHighScoreTitle(Display *display, Window window, Colormap colormap)
 {
 	XpmAttributes   attributes;
 	int             XpmErrorStatus;
@@ -178,10 +185,6 @@ void SetUpHighScore(Display *display, Window window, Colormap colormap)
 
     /* Free the xpm pixmap attributes */
 	XpmFreeAttributes(&attributes);
-
-	/* Setup the high score table */
-	InitialiseHighScores();
-	ResetHighScore(GLOBAL);
 }
 
 static void DoTitle(Display *display, Window window)
@@ -511,7 +514,7 @@ static void DoFinish(Display *display, Window window)
 	ResetPreviewLevel();
 
 	if (noSound == False)
-		playSoundFile("gate", 50);
+		playSound(SND_GATE, 50);
 
 	SetGameSpeed(FAST_SPEED);
 }
@@ -539,7 +542,7 @@ void HighScore(Display *display, Window window)
 			if (getSpecialEffects(display) == True)
 			{
 				DoHighScores(display, bufferWindow);
-				while (WindowBlindEffect(display, window));
+				changeSfxMode(SFX_BLIND);
 			}
 			else
 				DoHighScores(display, window);
@@ -0,0 +1,401 @@
+/*
+ * XBoing - An X11 blockout style computer game
+ *
+ * (c) Copyright 1993, 1994, 1995, Justin C. Kibell, All Rights Reserved
+ *
+ * The X Consortium, and any party obtaining a copy of these files from
+ * the X Consortium, directly or indirectly, is granted, free of charge, a
+ * full and unrestricted irrevocable, world-wide, paid up, royalty-free,
+ * nonexclusive right and license to deal in this software and
+ * documentation files (the "Software"), including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons who receive
+ * copies from any such party to do so.  This license includes without
+ * limitation a license to do the foregoing actions under any patents of
+ * the party supplying this software to the X Consortium.
+ *
+ * In no event shall the author be liable to any party for direct, indirect,
+ * special, incidental, or consequential damages arising out of the use of
+ * this software and its documentation, even if the author has been advised
+ * of the possibility of such damage.
+ *
+ * The author specifically disclaims any warranties, including, but not limited
+ * to, the implied warranties of merchantability and fitness for a particular
+ * purpose.  The software provided hereunder is on an "AS IS" basis, and the
+ * author has no obligation to provide maintenance, support, updates,
+ * enhancements, or modifications.
+ */
+
+/*
+ * =========================================================================
+ *
+ * HUD panels. Each SetHud...() call only records what its panel should
+ * show and marks the panel; FlushHud() compares that against what the
+ * panel shows now and redraws just the difference, once a frame.
+ *
+ * The score and level panels live in their own render textures. Their
+ * digits are kept one cell each, so a change of score wipes and redraws
+ * only the cells whose digit moved, and the lives only when they change.
+ * The time bonus, message and specials panels are drawn with the X core
+ * fonts, which cannot go into a texture, so they are redrawn in their own
+ * windows and only when the text or its colour is different.
+ *
+ * =========================================================================
+ */
+
+/*
+ *  Include file dependencies:
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "include/faketypes.h"
+#include "include/stage.h"
+#include "include/level.h"
+#include "include/mess.h"
+#include "include/special.h"
+#include "include/atlas.h"
+
+#include "include/hud.h"
+
+/*
+ *  Internal macro definitions:
+ */
+
+/* Where the panels sit in the main window, as CreateAllWindows() has them */
+#define SCORE_X			(MAIN_WIDTH / 2)
+#define SCORE_Y			10
+#define SCORE_WIDTH		224
+#define SCORE_HEIGHT	42
+#define LEVEL_X			(SCORE_X + SCORE_WIDTH + 25)
+#define LEVEL_Y			5
+#define LEVEL_WIDTH		(PLAY_WIDTH + SCORE_X - 20 - SCORE_WIDTH)
+#define LEVEL_HEIGHT	52
+
+/* Digit cells, right aligned on the given edge as DrawOutNumber() does */
+#define DIGIT_STEP		32
+#define DIGIT_HEIGHT	40
+#define SCORE_RIGHT		SCORE_WIDTH
+#define LEVEL_RIGHT		260
+#define LEVEL_DIGIT_Y	5
+
+/* Life icons run leftwards from LIFE_RIGHT, one every LIFE_STEP */
+#define LIFE_RIGHT		163
+#define LIFE_Y			9
+#define LIFE_STEP		30
+#define LIFE_WIDTH		25
+#define LIFE_HEIGHT		24
+#define LIFE_LEFT		(LIFE_RIGHT - (HUD_MAX_LIVES - 1) * LIFE_STEP)
+
+/* Digit cell values besides 0-9 */
+#define CELL_BLANK		-1
+#define CELL_UNKNOWN	-2
+
+#define PANEL_BIT(p)	(1 << (p))
+
+/*
+ *  Internal type declarations:
+ */
+
+static void ForgetHudLayers(void);
+static void SplitDigits(u_long value, int *cells, int numCells);
+static void RedrawDigits(int *want, int *shown, int numCells, int right,
+	int y);
+static void FlushScorePanel(void);
+static void FlushLevelPanel(void);
+static void DrawHudLayers(void);
+
+/*
+ *  Internal variable declarations:
+ */
+
+/* Panels that have been told something since the last flush */
+static int 		hudDirty;
+
+/* What each panel has been told to show, and what it shows now */
+static int 		wantScore[HUD_SCORE_DIGITS], shownScore[HUD_SCORE_DIGITS];
+static int 		wantLevel[HUD_LEVEL_DIGITS], shownLevel[HUD_LEVEL_DIGITS];
+static int 		wantLives, shownLives;
+static int 		wantTime, shownTime;
+static char 	wantMessage[1024], shownMessage[1024];
+static int 		wantColour, shownColour;
+static int 		wantSpecials, shownSpecials;
+
+static int 		digitSprites[10];
+static int 		lifeSprite;
+
+#ifndef HEADLESS
+static RenderTexture2D	scoreLayer, levelLayer;
+static int				hudLayersLoaded = False;
+#endif
+
+
+void InitialiseHud(void)
+{
+	char name[24];
+	int i;
+
+	for (i = 0; i < 10; i++)
+	{
+		sprintf(name, "digits/digit%d", i);
+		digitSprites[i] = GetSprite(name);
+	}
+
+	lifeSprite = GetSprite("balls/life");
+
+	SplitDigits(0L, wantScore, HUD_SCORE_DIGITS);
+	SplitDigits(0L, wantLevel, HUD_LEVEL_DIGITS);
+	wantLives 		= 0;
+	wantTime 		= 0;
+	wantMessage[0] 	= '\0';
+	wantColour 		= 0;
+	wantSpecials 	= 0;
+
+	InvalidateHud();
+}
+
+void FreeHud(void)
+{
+#ifndef HEADLESS
+	if (hudLayersLoaded == True)
+	{
+		UnloadRenderTexture(scoreLayer);
+		UnloadRenderTexture(levelLayer);
+	}
+
+	hudLayersLoaded = False;
+#endif
+}
+
+void InvalidateHud(void)
+{
+	ForgetHudLayers();
+
+	/* Nothing matches these so every panel is drawn afresh */
+	shownTime 		= -1;
+	shownColour 	= -1;
+	shownSpecials 	= -1;
+
+	hudDirty = PANEL_BIT(HUD_PANELS) - 1;
+}
+
+void SetHudScore(u_long score)
+{
+	SplitDigits(score, wantScore, HUD_SCORE_DIGITS);
+	hudDirty |= PANEL_BIT(HUD_SCORE);
+}
+
+void SetHudLevel(u_long level)
+{
+	SplitDigits(level, wantLevel, HUD_LEVEL_DIGITS);
+	hudDirty |= PANEL_BIT(HUD_LEVEL);
+}
+
+void SetHudLives(int lives)
+{
+	if (lives > HUD_MAX_LIVES) lives = HUD_MAX_LIVES;
+	if (lives < 0) lives = 0;
+
+	wantLives = lives;
+	hudDirty |= PANEL_BIT(HUD_LEVEL);
+}
+
+void SetHudTime(int seconds)
+{
+	wantTime = seconds;
+	hudDirty |= PANEL_BIT(HUD_TIME);
+}
+
+void SetHudMessage(char *message, int colour)
+{
+	strncpy(wantMessage, message, sizeof(wantMessage) - 1);
+	wantMessage[sizeof(wantMessage) - 1] = '\0';
+	wantColour = colour;
+	hudDirty |= PANEL_BIT(HUD_MESSAGE);
+}
+
+void SetHudSpecials(int lit)
+{
+	wantSpecials = lit;
+	hudDirty |= PANEL_BIT(HUD_SPECIALS);
+}
+
+void FlushHud(Display *display)
+{
+	/*
+	 * Bring every panel that was told something this frame up to date.
+	 * However many times a panel was set it is compared and drawn once,
+	 * and not at all if it ends up showing what it showed before.
+	 */
+
+	if (hudDirty & PANEL_BIT(HUD_SCORE))
+		FlushScorePanel();
+
+	if (hudDirty & PANEL_BIT(HUD_LEVEL))
+		FlushLevelPanel();
+
+	if ((hudDirty & PANEL_BIT(HUD_TIME)) && wantTime != shownTime)
+	{
+		DrawLevelTimeBonus(display, timeWindow, wantTime);
+		shownTime = wantTime;
+	}
+
+	if ((hudDirty & PANEL_BIT(HUD_MESSAGE)) && (wantColour != shownColour ||
+		strcmp(wantMessage, shownMessage) != 0))
+	{
+		DrawMessage(display, messWindow, wantMessage, True, wantColour);
+		strcpy(shownMessage, wantMessage);
+		shownColour = wantColour;
+	}
+
+	if ((hudDirty & PANEL_BIT(HUD_SPECIALS)) && wantSpecials != shownSpecials)
+	{
+		RenderSpecials(display, wantSpecials);
+		shownSpecials = wantSpecials;
+	}
+
+	hudDirty = 0;
+
+	DrawHudLayers();
+}
+
+static void ForgetHudLayers(void)
+{
+	int i;
+
+	/* No digit is an unknown cell so the whole layer is drawn again */
+	for (i = 0; i < HUD_SCORE_DIGITS; i++)
+		shownScore[i] = CELL_UNKNOWN;
+	for (i = 0; i < HUD_LEVEL_DIGITS; i++)
+		shownLevel[i] = CELL_UNKNOWN;
+
+	shownLives = -1;
+}
+
+static void SplitDigits(u_long value, int *cells, int numCells)
+{
+	int i;
+
+	/* Rightmost cell first, blank past the top digit but zero shows 0 */
+	for (i = 0; i < numCells; i++)
+	{
+		if (i > 0 && value == 0L)
+			cells[i] = CELL_BLANK;
+		else
+		{
+			cells[i] = (int) (value % 10);
+			value /= 10;
+		}
+	}
+}
+
+static void RedrawDigits(int *want, int *shown, int numCells, int right,
+	int y)
+{
+	int i, x;
+
+	/* Wipe and draw again just the cells whose digit is different */
+	for (i = 0; i < numCells; i++)
+	{
+		if (want[i] == shown[i])
+			continue;
+
+		x = right - (i + 1) * DIGIT_STEP;
+
+#ifndef HEADLESS
+		BeginScissorMode(x, y, DIGIT_STEP, DIGIT_HEIGHT);
+		ClearBackground(BLANK);
+		EndScissorMode();
+#endif
+
+		if (want[i] != CELL_BLANK)
+			DrawSprite(digitSprites[want[i]], x, y);
+
+		shown[i] = want[i];
+	}
+}
+
+static void FlushScorePanel(void)
+{
+#ifndef HEADLESS
+	if (hudLayersLoaded == False)
+		return;
+
+	BeginTextureMode(scoreLayer);
+#endif
+
+	RedrawDigits(wantScore, shownScore, HUD_SCORE_DIGITS, SCORE_RIGHT, 0);
+
+#ifndef HEADLESS
+	EndTextureMode();
+#endif
+}
+
+static void FlushLevelPanel(void)
+{
+	int i;
+
+#ifndef HEADLESS
+	if (hudLayersLoaded == False)
+		return;
+
+	BeginTextureMode(levelLayer);
+#endif
+
+	RedrawDigits(wantLevel, shownLevel, HUD_LEVEL_DIGITS, LEVEL_RIGHT,
+		LEVEL_DIGIT_Y);
+
+	if (wantLives != shownLives)
+	{
+#ifndef HEADLESS
+		BeginScissorMode(LIFE_LEFT, LIFE_Y, 
+			LIFE_RIGHT + LIFE_WIDTH - LIFE_LEFT, LIFE_HEIGHT);
+		ClearBackground(BLANK);
+		EndScissorMode();
+#endif
+
+		for (i = 0; i < wantLives; i++)
+			DrawSprite(lifeSprite, LIFE_RIGHT - (i * LIFE_STEP), LIFE_Y);
+
+		shownLives = wantLives;
+	}
+
+#ifndef HEADLESS
+	EndTextureMode();
+#endif
+}
+
+static void DrawHudLayers(void)
+{
+#ifndef HEADLESS
+	/* The layers are made the first time through, once there is a window */
+	if (hudLayersLoaded == False)
+	{
+		scoreLayer = LoadRenderTexture(SCORE_WIDTH, SCORE_HEIGHT);
+		levelLayer = LoadRenderTexture(LEVEL_WIDTH, LEVEL_HEIGHT);
+		hudLayersLoaded = True;
+
+		/* Start them off clear and draw whatever they should show */
+		BeginTextureMode(scoreLayer);
+		ClearBackground(BLANK);
+		EndTextureMode();
+		BeginTextureMode(levelLayer);
+		ClearBackground(BLANK);
+		EndTextureMode();
+
+		ForgetHudLayers();
+		FlushScorePanel();
+		FlushLevelPanel();
+	}
+
+	/* Render textures are stored upside down so flip them back */
+	DrawTextureRec(scoreLayer.texture, 
+		(Rectangle) { 0, 0, SCORE_WIDTH, -SCORE_HEIGHT }, 
+		(Vector2) { SCORE_X, SCORE_Y }, WHITE);
+	DrawTextureRec(levelLayer.texture, 
+		(Rectangle) { 0, 0, LEVEL_WIDTH, -LEVEL_HEIGHT }, 
+		(Vector2) { LEVEL_X, LEVEL_Y }, WHITE);
+#endif
+}
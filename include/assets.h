@@ -0,0 +1,111 @@
+#ifndef _ASSETS_H_
+#define _ASSETS_H_
+
+/*
+ * XBoing - An X11 blockout style computer game
+ *
+ * (c) Copyright 1993, 1994, 1995, Justin C. Kibell, All Rights Reserved
+ *
+ * The X Consortium, and any party obtaining a copy of these files from
+ * the X Consortium, directly or indirectly, is granted, free of charge, a
+ * full and unrestricted irrevocable, world-wide, paid up, royalty-free,
+ * nonexclusive right and license to deal in this software and
+ * documentation files (the "Software"), including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons who receive
+ * copies from any such party to do so.  This license includes without
+ * limitation a license to do the foregoing actions under any patents of
+ * the party supplying this software to the X Consortium.
+ *
+ * In no event shall the author be liable to any party for direct, indirect,
+ * special, incidental, or consequential damages arising out of the use of
+ * this software and its documentation, even if the author has been advised
+ * of the possibility of such damage.
+ *
+ * The author specifically disclaims any warranties, including, but not limited
+ * to, the implied warranties of merchantability and fitness for a particular
+ * purpose.  The software provided hereunder is on an "AS IS" basis, and the
+ * author has no obligation to provide maintenance, support, updates,
+ * enhancements, or modifications.
+ */
+
+/*
+ * =========================================================================
+ *
+ * Mode scoped assets - the pixmaps that only some modes draw: the presents
+ * flag and letters, the earth, the intro title, the sparkle stars, the
+ * keys screen mouse and arrows, the high score title and the dialogue
+ * icons.
+ *
+ * Nothing in a group is loaded until a mode that needs it is first
+ * entered. handleGameStates() tells UseModeAssets() the mode every frame;
+ * on a change the new mode takes a reference on each group it needs
+ * before the old mode lets go of its own, so a group both use is never
+ * reloaded. A group nobody holds stays resident while everything loaded
+ * fits the budget and the least recently used go first when it does not.
+ * Playing a replay goes straight to the game and loads none of them.
+ *
+ * The budget is ASSET_BUDGET_KB unless XBOING_ASSET_BUDGET gives another
+ * size in kilobytes; 0 frees every group as soon as it is let go.
+ *
+ * =========================================================================
+ */
+
+/*
+ *  Dependencies on other include files:
+ */
+
+#include "faketypes.h"
+
+/*
+ *  Constants and macros:
+ */
+
+/* Asset groups */
+#define ASSETS_PRESENTS		0
+#define ASSETS_EARTH		1
+#define ASSETS_TITLE		2
+#define ASSETS_SPARKLES		3
+#define ASSETS_KEYS			4
+#define ASSETS_HIGHSCORE	5
+#define ASSETS_DIALOGUE		6
+#define NUM_ASSET_GROUPS	7
+
+/* Kilobytes of unused groups that may be kept loaded */
+#define ASSET_BUDGET_KB		1024
+
+/*
+ *  Type declarations:
+ */
+
+/*
+ *  Function prototypes:
+ */
+
+/**
+ * @brief Sets the budget; nothing is loaded until a mode needs it
+ *
+ * @param display The X11 display
+ * @param colormap Colour map the pixmaps are made with
+ */
+void InitialiseAssets(Display *display, Colormap colormap);
+
+/**
+ * @brief Makes sure everything the mode draws is loaded
+ *
+ * Cheap when the mode has not changed since the last call. On a change
+ * the groups of the old mode are let go and evicted if over budget.
+ *
+ * @param display The X11 display
+ * @param newMode Mode about to run or be redrawn
+ */
+void UseModeAssets(Display *display, int newMode);
+
+/**
+ * @brief Frees every group still loaded, whoever holds it
+ *
+ * @param display The X11 display
+ */
+void FreeAllAssets(Display *display);
+
+#endif
@@ -0,0 +1,142 @@
+#ifndef _ATLAS_H_
+#define _ATLAS_H_
+
+/*
+ * XBoing - An X11 blockout style computer game
+ *
+ * (c) Copyright 1993, 1994, 1995, Justin C. Kibell, All Rights Reserved
+ *
+ * The X Consortium, and any party obtaining a copy of these files from
+ * the X Consortium, directly or indirectly, is granted, free of charge, a
+ * full and unrestricted irrevocable, world-wide, paid up, royalty-free,
+ * nonexclusive right and license to deal in this software and
+ * documentation files (the "Software"), including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons who receive
+ * copies from any such party to do so.  This license includes without
+ * limitation a license to do the foregoing actions under any patents of
+ * the party supplying this software to the X Consortium.
+ *
+ * In no event shall the author be liable to any party for direct, indirect,
+ * special, incidental, or consequential damages arising out of the use of
+ * this software and its documentation, even if the author has been advised
+ * of the possibility of such damage.
+ *
+ * The author specifically disclaims any warranties, including, but not limited
+ * to, the implied warranties of merchantability and fitness for a particular
+ * purpose.  The software provided hereunder is on an "AS IS" basis, and the
+ * author has no obligation to provide maintenance, support, updates,
+ * enhancements, or modifications.
+ */
+
+/*
+ * =========================================================================
+ *
+ * Sprite atlas. Every small sprite the game draws - blocks and their
+ * explosions, balls, guides, digits, devil eyes, paddles and bullets - is
+ * packed into a few large atlas textures when the game starts, so drawing
+ * a frame binds the same texture over and over instead of switching
+ * between a hundred small ones.
+ *
+ * Sprites are asked for by name once, at initialise time, with GetSprite()
+ * and are drawn with the handle it returns:
+ *
+ *		redblock = GetSprite("blocks/redblk");
+ *		...
+ *		DrawSprite(redblock, x, y);
+ *
+ * The name is the image file under bitmaps/ without the .png extension.
+ *
+ * =========================================================================
+ */
+
+/*
+ *  Dependencies on other include files:
+ */
+
+/* The headless build has no raylib, see headless.c for its atlas */
+#ifndef HEADLESS
+#include <raylib.h>
+#endif
+
+/*
+ *  Constants and macros:
+ */
+
+/* Size of each atlas page in pixels - all the sprites fit in one today */
+#define ATLAS_SIZE			512
+#define ATLAS_MAX_PAGES		4
+
+/* Gap left around each sprite so filtering never bleeds a neighbour in */
+#define ATLAS_PADDING		1
+
+/* Handle returned for a sprite that is not in the atlas */
+#define SPRITE_NONE			-1
+
+/*
+ *  Type declarations:
+ */
+
+/*
+ *  Function prototypes:
+ */
+
+/**
+ * @brief Queues every sprite image to be decoded by the loader threads
+ *
+ * Optional - InitialiseAtlas() queues them itself if this was not called.
+ */
+void QueueAtlasImages(void);
+
+/**
+ * @brief Loads every sprite image and packs them into the atlas textures
+ *
+ * @return True if all the sprites were loaded and packed, False if not
+ */
+int InitialiseAtlas(void);
+
+/**
+ * @brief Unloads the atlas textures, every sprite handle becomes invalid
+ */
+void FreeAtlas(void);
+
+/**
+ * @brief Looks up a sprite by name
+ *
+ * @param name Image path under bitmaps/ without the extension
+ *
+ * @return The sprite handle, or SPRITE_NONE if there is no such sprite
+ */
+int GetSprite(char *name);
+
+/**
+ * @brief Draws a sprite with its top left corner at x, y
+ *
+ * @param sprite Handle from GetSprite(), SPRITE_NONE draws nothing
+ * @param x Left edge in screen pixels
+ * @param y Top edge in screen pixels
+ */
+void DrawSprite(int sprite, int x, int y);
+
+#ifndef HEADLESS
+/**
+ * @brief Returns where a sprite lives in its atlas page
+ *
+ * @param sprite Handle from GetSprite()
+ *
+ * @return The source rectangle, all zero for SPRITE_NONE
+ */
+Rectangle GetSpriteRect(int sprite);
+#endif
+
+/**
+ * @brief Returns the width of a sprite in pixels
+ */
+int GetSpriteWidth(int sprite);
+
+/**
+ * @brief Returns the height of a sprite in pixels
+ */
+int GetSpriteHeight(int sprite);
+
+#endif
@@ -62,6 +62,7 @@
 
 // TODO: Remove instances of X11-associated data types
 #include "faketypes.h"
+#include "sounds.h"
 
 // #include <X11/Xlib.h>
 
@@ -107,6 +108,17 @@ void FreeAudioSystem(void);
 void playSoundFile(char *filename, int volume);
 
 
+/**
+ * Start a sound effect by its id straight away. The game calls
+ * playSound() instead, which goes through FlushSounds().
+ *
+ * @param int id The SND_ id of the sound, see sounds.h.
+ * @param int volume The volume level.
+ * 
+ */
+void startSound(int id, int volume);
+
+
 /**
  * Process audio device events
  *
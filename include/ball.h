@@ -89,6 +89,13 @@
 
 #define PADDLE_BALL_FRAME_TILT  5000
 
+/* Ball to block collision modes */
+#define COLLIDE_STEP		0
+#define COLLIDE_SWEPT		1
+
+/* Most bounces a swept ball may make in one frame */
+#define MAX_SWEPT_BOUNCES	4
+
 
 /*
  *  Type declarations:
@@ -117,6 +124,8 @@ typedef struct ball
     int             oldy;			/* Old y coord of ball centre */
     int             ballx;			/* Current x coord of ball centre */
     int             bally;			/* Current y coord of ball centre */
+    int             prevx;			/* x coord before the last move */
+    int             prevy;			/* y coord before the last move */
     int             dx;				/* Change in x axis increment */
     int             dy;				/* Change in y axis increment */
     int             slide;			/* Current pixmap visible */
@@ -134,9 +143,11 @@ void InitialiseBall(Display *display, Window window, Colormap colormap);
 void FreeBall(Display *display);
 void RedrawBall(Display *display, Window window);
 void DrawTheBall(Display *display, Window window, int x, int y, int slide);
+void EraseTheBall(Display *display, Window window, int x, int y);
 void DrawTheBallBirth(Display *display, Window window, int x, int y, int slide);
 void KillBallNow(Display *display, Window window, int i);
 void GetBallPosition(int *ballX, int *ballY, int i);
+void GetBallRenderPosition(int *ballX, int *ballY, int i);
 void ResetBallStart(Display *display, Window window);
 int GetBallMode(int i);
 void ChangeBallMode(enum BallStates newMode, int i);
@@ -152,6 +163,10 @@ int GetAnActiveBall(void);
 int ActivateWaitingBall(Display *display, Window window);
 int GetNumberOfActiveBalls(void);
 void DoBoardTilt(Display *display, int i);
+void SetBallCollisionMode(int mode);
+int GetBallCollisionMode(void);
+void GetBallStats(unsigned long *updates, unsigned long *queries);
+void ResetBallStats(void);
 
 extern BALL balls[MAX_BALLS];
 extern int speedLevel;
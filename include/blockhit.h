@@ -0,0 +1,149 @@
+#ifndef _BLOCKHIT_H_
+#define _BLOCKHIT_H_
+
+/*
+ * XBoing - An X11 blockout style computer game
+ *
+ * (c) Copyright 1993, 1994, 1995, Justin C. Kibell, All Rights Reserved
+ *
+ * The X Consortium, and any party obtaining a copy of these files from
+ * the X Consortium, directly or indirectly, is granted, free of charge, a
+ * full and unrestricted irrevocable, world-wide, paid up, royalty-free,
+ * nonexclusive right and license to deal in this software and
+ * documentation files (the "Software"), including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons who receive
+ * copies from any such party to do so.  This license includes without
+ * limitation a license to do the foregoing actions under any patents of
+ * the party supplying this software to the X Consortium.
+ *
+ * In no event shall the author be liable to any party for direct, indirect,
+ * special, incidental, or consequential damages arising out of the use of
+ * this software and its documentation, even if the author has been advised
+ * of the possibility of such damage.
+ *
+ * The author specifically disclaims any warranties, including, but not limited
+ * to, the implied warranties of merchantability and fitness for a particular
+ * purpose.  The software provided hereunder is on an "AS IS" basis, and the
+ * author has no obligation to provide maintenance, support, updates,
+ * enhancements, or modifications.
+ */
+
+/*
+ * =========================================================================
+ *
+ * Ball to block region test.
+ *
+ * Each block is split by its two diagonals into four triangles - top,
+ * bottom, left and right. BlockRegionHit() says which of them a rectangle
+ * (the ball) touches. It gives the same answer, pixel for pixel, as
+ * building the four triangles with XPolygonRegion() and asking
+ * XRectInRegion(), but uses only the block geometry that is already
+ * stored in the block, so nothing is allocated and nothing has to be
+ * freed when the block goes away.
+ *
+ * The triangles follow the X polygon fill rules: a pixel belongs to a
+ * triangle when its coordinate lies on or to the right of the left edge
+ * and strictly to the left of the right edge of a scanline, for the
+ * scanlines from the top vertex down to, but not including, the bottom.
+ *
+ * =========================================================================
+ */
+
+/*
+ *  Dependencies on other include files:
+ */
+
+/*
+ *  Constants and macros:
+ */
+
+#define REGION_NONE		0
+#define REGION_TOP		1
+#define REGION_BOTTOM	2
+#define REGION_LEFT		4
+#define REGION_RIGHT	8
+
+/* Integer ceiling of n / d for d > 0 */
+#define CEIL_DIV(n, d)	(((n) >= 0) ? (((n) + (d) - 1) / (d)) : -((-(n)) / (d)))
+
+/*
+ *  Function prototypes:
+ */
+
+/**
+ * @brief Finds which triangles of a block a rectangle overlaps
+ *
+ * @param bx The x coordinate of the block
+ * @param by The y coordinate of the block
+ * @param bw The width of the block
+ * @param bh The height of the block
+ * @param rx The x coordinate of the rectangle
+ * @param ry The y coordinate of the rectangle
+ * @param rw The width of the rectangle
+ * @param rh The height of the rectangle
+ * @return int REGION_TOP | REGION_BOTTOM | REGION_LEFT | REGION_RIGHT mask
+ */
+static inline int BlockRegionHit(int bx, int by, int bw, int bh,
+	int rx, int ry, int rw, int rh)
+{
+	int cx = bx + bw / 2;			/* Centre vertex, as the X code had it */
+	int cy = by + bh / 2;
+	int wl = cx - bx;				/* Width left and right of the centre */
+	int wr = bx + bw - cx;
+	int ht = cy - by;				/* Height above and below the centre */
+	int hb = by + bh - cy;
+	int x1 = rx + rw - 1;			/* Last pixel column and row of rect */
+	int y1 = ry + rh - 1;
+	int mask = REGION_NONE;
+	int py, l, r;
+
+	/* Nowhere near the block at all */
+	if (x1 < bx || rx >= bx + bw || y1 < by || ry >= by + bh)
+		return REGION_NONE;
+
+	/* Top triangle is widest on its first row - test the highest row */
+	py = (ry > by) ? ry : by;
+	if (py < cy)
+	{
+		l = bx + CEIL_DIV((py - by) * wl, ht);
+		r = bx + bw + CEIL_DIV(-(py - by) * wr, ht) - 1;
+		if (l <= r && rx <= r && x1 >= l)
+			mask |= REGION_TOP;
+	}
+
+	/* Bottom triangle is widest on its last row - test the lowest row */
+	py = (y1 < by + bh - 1) ? y1 : by + bh - 1;
+	if (py >= cy)
+	{
+		l = bx + CEIL_DIV((by + bh - py) * wl, hb);
+		r = bx + bw + CEIL_DIV(-(by + bh - py) * wr, hb) - 1;
+		if (l <= r && rx <= r && x1 >= l)
+			mask |= REGION_BOTTOM;
+	}
+
+	/* Left and right are widest on the centre row - test the nearest */
+	py = (cy < ry) ? ry : (cy > y1) ? y1 : cy;
+	if (py < by) 			py = by;
+	if (py > by + bh - 1) 	py = by + bh - 1;
+
+	if (py < cy)
+	{
+		r = bx + CEIL_DIV((py - by) * wl, ht) - 1;
+		l = bx + bw + CEIL_DIV(-(py - by) * wr, ht);
+	}
+	else
+	{
+		r = bx + CEIL_DIV((by + bh - py) * wl, hb) - 1;
+		l = bx + bw + CEIL_DIV(-(by + bh - py) * wr, hb);
+	}
+
+	if (r >= bx && rx <= r)
+		mask |= REGION_LEFT;
+	if (l < bx + bw && x1 >= l)
+		mask |= REGION_RIGHT;
+
+	return mask;
+}
+
+#endif
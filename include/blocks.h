@@ -52,6 +52,7 @@
 
 // TODO: Remove X11 #include <X11/Xlib.h>
 #include <faketypes.h>
+#include "blockhit.h"
 
 /*
  *  Constants and macros:
@@ -102,17 +103,32 @@
 #define MAX_ROW			18	
 #define MAX_COL			9	
 
+/* Block grid bitboards - one bit per cell, cell = row * MAX_COL + col */
+#define GRID_CELLS		(MAX_ROW * MAX_COL)
+#define GRID_WORDS		((GRID_CELLS + 63) / 64)
+#define GRID_CELL(row, col)	((row) * MAX_COL + (col))
+#define BIT_WORD(cell)	((cell) >> 6)
+#define BIT_MASK(cell)	(1ULL << ((cell) & 63))
+
+/* Flags kept in the hot block table */
+#define BLOCK_OCCUPIED	0x01
+#define BLOCK_EXPLODING	0x02
+
+/* Block timers - each one is a frame number in struct aBlock */
+#define TIMER_ANIMATE	0		/* nextFrame - animation, random, drop */
+#define TIMER_EXPIRE	1		/* lastFrame - special timeout, roamer move */
+#define TIMER_EXPLODE	2		/* explodeNextFrame - explosion slides */
+#define NUM_BLOCK_TIMERS 3
+
+/* Frame keyed timer wheel, must be a power of two */
+#define WHEEL_SLOTS		256
+#define WHEEL_MASK		(WHEEL_SLOTS - 1)
+
 #define BLOCK_WIDTH		40
 #define BLOCK_HEIGHT	20
 
 #define SPACE			7
 
-#define REGION_NONE		0
-#define REGION_TOP		1
-#define REGION_BOTTOM	2
-#define REGION_LEFT		4
-#define REGION_RIGHT	8
-
 #define EXPLODE_DELAY               10
 #define BONUS_DELAY                 150
 #define BONUS_LENGTH                1500
@@ -140,6 +156,22 @@ struct blockInfo
 	int		slide;
 };
 
+/* 
+ * Fields the ball, bullet and eyedude code read every frame, one packed
+ * array per field indexed by GRID_CELL(). Only blocks.c writes it - the
+ * rest of the game reads it through the accessors at the end of this
+ * file. struct aBlock below holds everything else about a block.
+ */
+struct blockHot
+{
+	unsigned char	flags[GRID_CELLS];		/* BLOCK_OCCUPIED etc. */
+	signed char		type[GRID_CELLS];		/* Block type or NONE_BLK */
+	short			x[GRID_CELLS];			/* Position in play area */
+	short			y[GRID_CELLS];
+	short			width[GRID_CELLS];		/* Size of the block image */
+	short			height[GRID_CELLS];
+};
+
 struct aBlock
 {
 	/* General properties of the block */
@@ -158,7 +190,7 @@ struct aBlock
 	int     	nextFrame;
 	int     	lastFrame;
 
-	/* Used for positioning of block in arena */
+	/* Used for positioning of block in arena and ball collision */
 	int			blockOffsetX;
 	int			blockOffsetY;
 	int			x;
@@ -166,16 +198,14 @@ struct aBlock
 	int         width;
 	int         height;
 
-	/* Used for ball collision with block */
-	Region		regionTop;
-	Region		regionBottom;
-	Region		regionLeft;
-	Region		regionRight;
-
 	/* Indexes into animation frames for object */
 	int 		counterSlide;		/* For counter blocks only */
 	int 		bonusSlide;			/* For bonus blocks only */
 
+	/* What the cell last showed, so the block layer can redraw it */
+	int 		drawnType;
+	int 		drawnSlide;
+
 	/* Special types of block flags */
 	int			random;
 	int			drop;
@@ -190,6 +220,11 @@ struct aBlock
 
 typedef struct aBlock **BLOCKPTR;
 
+typedef struct
+{
+	unsigned long long	word[GRID_WORDS];
+} BITBOARD;
+
 /*
  *  Function prototypes:
  */
@@ -200,6 +235,8 @@ void DrawBlock(Display *display, Window window, int row, int col,
 	int blockType);
 void ExplodeBlocksPending(Display *display, Window window);
 void RedrawAllBlocks(Display *display, Window window);
+void DrawBlockLayer(Display *display, Window window);
+void InvalidateBlockLayer(void);
 void DrawTheBlock(Display *display, Window window, int x, int y, 
 	int blockType, int slide, int r, int c);
 void ExplodeBlockType(Display *display, Window window, int x, int y,
@@ -222,13 +259,51 @@ void SetExplodeAllType(Display *display, Window window, int type);
 void EraseVisibleBlock(Display *display, Window window, int row, int col);
 void ClearBlock(int row, int col);
 void SetupBlockInfo(void);
+int IsBlockOccupied(int row, int col);
+int IsBlockFree(int row, int col);
+int PickRandomFreeBlock(int firstRow, int lastRow, int firstCol, int lastCol,
+	int *row, int *col);
+void ChangeBlockType(int row, int col, int blockType);
+void ScheduleBlockTimer(int row, int col, int timer, int when);
+void CancelBlockTimer(int row, int col, int timer);
 
 extern struct aBlock blocks[MAX_ROW][MAX_COL];
 extern int rowHeight;
 extern int colWidth;
 extern int blocksExploding;
-extern Pixmap exyellowblock[3], exyellowblockM[3];
+extern int exyellowblock[3];
 extern struct blockInfo    BlockInfo[MAX_BLOCKS];
+extern struct blockHot		hotBlocks;
+
+/* A block is in the cell and it is not blowing up */
+static inline int IsBlockSolid(int row, int col)
+{
+	return (hotBlocks.flags[GRID_CELL(row, col)] == BLOCK_OCCUPIED);
+}
+
+/* The block in the cell is blowing up */
+static inline int IsBlockExploding(int row, int col)
+{
+	return ((hotBlocks.flags[GRID_CELL(row, col)] & BLOCK_EXPLODING) != 0);
+}
+
+/* Type of the block in the cell or NONE_BLK */
+static inline int GetBlockType(int row, int col)
+{
+	return (int) hotBlocks.type[GRID_CELL(row, col)];
+}
+
+/* Position and size of the block in the cell */
+static inline void GetBlockRect(int row, int col, int *x, int *y, int *w, 
+	int *h)
+{
+	int cell = GRID_CELL(row, col);
+
+	*x = hotBlocks.x[cell];
+	*y = hotBlocks.y[cell];
+	*w = hotBlocks.width[cell];
+	*h = hotBlocks.height[cell];
+}
 
 
 #endif
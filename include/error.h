@@ -84,7 +84,9 @@
  * @param char *texture_name The name of the texture (printed in error message)
  *
  */
+#ifndef HEADLESS
 void HandleXPMError(Texture2D texture, char* texture_name);
+#endif
 
 /**
  * @brief Prints a message to the console in the "Error" format & refers the user to the readme file
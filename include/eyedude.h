@@ -94,6 +94,10 @@ void HandleEyeDudeMode(Display *display, Window window);
 void ChangeEyeDudeMode(eyeDudeStates state);
 eyeDudeStates getEyeDudeMode(void);
 void GetEyeDudePosition(int *x, int *y);
+void GetEyeDudeFrame(int *slide, int *dir);
+void DrawTheEyeDude(Display *display, Window window, int x, int y, 
+	int slide, int direction);
+void EraseTheEyeDude(Display *display, Window window, int x, int y);
 int CheckBallEyeDudeCollision(Display *display, Window window, int j);
 
 #endif
@@ -5,13 +5,15 @@
 
 //#include <raylib.h>
 
+// uid_t comes from the system, a typedef of our own clashes with it
+#include <sys/types.h>
+
 typedef int Display;
 typedef int Window;
 typedef int Colormap;
 typedef unsigned long int u_long;
 typedef int KeySym;
 // typedef int XEvent; // replaced with struct below
-typedef int uid_t;
 typedef int Pixmap;
 
 // Raylib Types
@@ -144,9 +146,6 @@ typedef enum{
 #define Button2  0
 #define Button3  0
 
-#define CURSOR_PLUS   0
-#define CURSOR_POINT  0
-
 typedef struct {
     int button;
     int subwindow;
@@ -211,5 +210,16 @@ typedef struct{
     int backing_store;
 } XSetWindowAttributes;
 
+#ifdef HEADLESS
+// X calls the game core still makes, stubbed out in headless.c
+int XClearArea(Display *display, Window window, int x, int y,
+    unsigned int w, unsigned int h, int exposures);
+int XClearWindow(Display *display, Window window);
+int XSetWindowBorder(Display *display, Window window, unsigned long pixel);
+int XFreePixmap(Display *display, Pixmap pixmap);
+int XFlush(Display *display);
+int XTextWidth(XFontStruct *font, const char *string, int count);
+#endif
+
 
 #endif
@@ -58,6 +58,7 @@
  */
 
 #define MAX_BULLETS         20
+#define MAX_MOVING_BULLETS	40
 
 /*
  *  Type declarations:
@@ -77,6 +78,7 @@ void shootBullet(Display *display, Window window);
 void DrawTheBullet(Display *display, Window window, int x, int y);
 void EraseTheBullet(Display *display, Window window, int x, int y);
 void HandleBulletMode(Display *display, Window window);
+int GetBulletRenderPosition(int i, int *x, int *y);
 void ClearBullets(void);
 void SetUnlimitedBullets(int state);
 
@@ -0,0 +1,80 @@
+#ifndef _HEADLESS_H_
+#define _HEADLESS_H_
+
+/*
+ * XBoing - An X11 blockout style computer game
+ *
+ * (c) Copyright 1993, 1994, 1995, Justin C. Kibell, All Rights Reserved
+ *
+ * The X Consortium, and any party obtaining a copy of these files from
+ * the X Consortium, directly or indirectly, is granted, free of charge, a
+ * full and unrestricted irrevocable, world-wide, paid up, royalty-free,
+ * nonexclusive right and license to deal in this software and
+ * documentation files (the "Software"), including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons who receive
+ * copies from any such party to do so.  This license includes without
+ * limitation a license to do the foregoing actions under any patents of
+ * the party supplying this software to the X Consortium.
+ *
+ * In no event shall the author be liable to any party for direct, indirect,
+ * special, incidental, or consequential damages arising out of the use of
+ * this software and its documentation, even if the author has been advised
+ * of the possibility of such damage.
+ *
+ * The author specifically disclaims any warranties, including, but not limited
+ * to, the implied warranties of merchantability and fitness for a particular
+ * purpose.  The software provided hereunder is on an "AS IS" basis, and the
+ * author has no obligation to provide maintenance, support, updates,
+ * enhancements, or modifications.
+ */
+
+/*
+ * =========================================================================
+ *
+ * Headless simulation build. Compiled in when HEADLESS is defined (see
+ * Makefile.headless). The game core (ball, blocks, gun, eyedude, level,
+ * file, score, special) is linked against headless.c which replaces every
+ * display, window, texture and sound entry point with a no-op.
+ *
+ * =========================================================================
+ */
+
+/*
+ *  Dependencies on other include files:
+ */
+
+#include "faketypes.h"
+#include "paddle.h"
+
+/*
+ *  Constants and macros:
+ */
+
+/* Paddle key speed, as paddle.c */
+#define SIM_PADDLE_VEL	600
+
+/* Default number of frames a level may run before the simulator gives up */
+#define SIM_MAX_FRAMES	50000
+
+/*
+ *  Type declarations:
+ */
+
+/*
+ *  Function prototypes:
+ */
+
+/**
+ * @brief Runs one frame of the game core with no events, drawing or sleep
+ *
+ * @param display Unused in headless builds, may be NULL
+ */
+void SimulateGameFrame(Display *display);
+
+/**
+ * @brief Moves the headless paddle directly under the lowest falling ball
+ */
+void HeadlessTrackBall(void);
+
+#endif
@@ -104,6 +104,7 @@ void SetUpHighScore(Display *display, Window window, Colormap colormap);
 void HighScore(Display *display, Window window);
 void RedrawHighScore(Display *display, Window window);
 void FreeHighScore(Display *display);
+void SetUpHighScoreTitle(Display *display, Window window, Colormap colormap);
 void ResetHighScore(int type);
 int ReadHighScoreTable(int type);
 int WriteHighScoreTable(int type);
@@ -0,0 +1,154 @@
+#ifndef _HUD_H_
+#define _HUD_H_
+
+/*
+ * XBoing - An X11 blockout style computer game
+ *
+ * (c) Copyright 1993, 1994, 1995, Justin C. Kibell, All Rights Reserved
+ *
+ * The X Consortium, and any party obtaining a copy of these files from
+ * the X Consortium, directly or indirectly, is granted, free of charge, a
+ * full and unrestricted irrevocable, world-wide, paid up, royalty-free,
+ * nonexclusive right and license to deal in this software and
+ * documentation files (the "Software"), including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons who receive
+ * copies from any such party to do so.  This license includes without
+ * limitation a license to do the foregoing actions under any patents of
+ * the party supplying this software to the X Consortium.
+ *
+ * In no event shall the author be liable to any party for direct, indirect,
+ * special, incidental, or consequential damages arising out of the use of
+ * this software and its documentation, even if the author has been advised
+ * of the possibility of such damage.
+ *
+ * The author specifically disclaims any warranties, including, but not limited
+ * to, the implied warranties of merchantability and fitness for a particular
+ * purpose.  The software provided hereunder is on an "AS IS" basis, and the
+ * author has no obligation to provide maintenance, support, updates,
+ * enhancements, or modifications.
+ */
+
+/*
+ * =========================================================================
+ *
+ * HUD panels - the score, level, time bonus, message and specials panels
+ * around the play area.
+ *
+ * The game says what a panel should show with the SetHud...() calls as
+ * often as it likes; nothing is drawn until FlushHud() at the end of the
+ * frame, and then only the panels whose shown value has really changed.
+ * Ten paddle hits in one frame redraw the score once, and a score going
+ * from 1290 to 1300 redraws two digits.
+ *
+ * The score and level panels are made of sprites so each is kept in its
+ * own texture and drawn with one quad a frame. The time bonus, message
+ * and specials panels are still X core font text and are redrawn in their
+ * windows, which keep what was drawn, only when they change.
+ *
+ * =========================================================================
+ */
+
+/*
+ *  Dependencies on other include files:
+ */
+
+#include "faketypes.h"
+
+/*
+ *  Constants and macros:
+ */
+
+/* Panels, in the order they are flushed */
+#define HUD_SCORE			0
+#define HUD_LEVEL			1
+#define HUD_TIME			2
+#define HUD_MESSAGE			3
+#define HUD_SPECIALS		4
+#define HUD_PANELS			5
+
+/* Digit cells in the score and level panels, counted from the right */
+#define HUD_SCORE_DIGITS	7
+#define HUD_LEVEL_DIGITS	2
+
+/* Life icons shown in the level panel at most */
+#define HUD_MAX_LIVES		6
+
+/*
+ *  Type declarations:
+ */
+
+/*
+ *  Function prototypes:
+ */
+
+/**
+ * @brief Looks up the HUD sprites and marks every panel as needing a redraw
+ */
+void InitialiseHud(void);
+
+/**
+ * @brief Unloads the panel textures
+ */
+void FreeHud(void);
+
+/**
+ * @brief Forgets what every panel shows so the next flush redraws them all
+ *
+ * Used when the windows have been uncovered and their contents lost.
+ */
+void InvalidateHud(void);
+
+/**
+ * @brief Sets the number shown in the score panel
+ *
+ * @param score Number to show, need not be the player's score
+ */
+void SetHudScore(u_long score);
+
+/**
+ * @brief Sets the level number shown in the level panel
+ *
+ * @param level Level number to show
+ */
+void SetHudLevel(u_long level);
+
+/**
+ * @brief Sets how many life icons the level panel shows
+ *
+ * @param lives Lives to show, only HUD_MAX_LIVES are drawn
+ */
+void SetHudLives(int lives);
+
+/**
+ * @brief Sets the seconds shown in the time bonus panel
+ *
+ * @param seconds Time bonus left
+ */
+void SetHudTime(int seconds);
+
+/**
+ * @brief Sets the text shown in the message panel
+ *
+ * @param message Text to show, copied
+ * @param colour Pixel value to draw it in
+ */
+void SetHudMessage(char *message, int colour);
+
+/**
+ * @brief Sets which specials are lit in the specials panel
+ *
+ * @param lit One bit per special, see DrawSpecials()
+ */
+void SetHudSpecials(int lit);
+
+/**
+ * @brief Redraws the panels that changed this frame and draws the HUD
+ *
+ * Called once a frame whatever the mode, after the game has run.
+ *
+ * @param display The X11 display
+ */
+void FlushHud(Display *display);
+
+#endif
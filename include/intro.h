@@ -80,6 +80,8 @@ void Introduction(Display *display, Window window);
 void RedrawIntroduction(Display *display, Window window);
 void FreeIntroduction(Display *display);
 void ResetIntroduction(void);
+void SetUpSparkles(Display *display, Window window, Colormap colormap);
+void FreeSparkles(Display *display);
 void DoIntroTitle(Display *display, Window window);
 void DrawIntroTitle(Display *display, Window window, int x, int y);
 
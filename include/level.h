@@ -73,6 +73,7 @@
 void InitialiseLevelInfo(Display *display, Window window, Colormap colormap);
 void FreeLevelInfo(Display *display);
 void DisplayLevelInfo(Display *display, Window window, u_long level);
+void DisplayLevelNumber(Display *display, Window window, u_long level);
 void CheckGameRules(Display *display, Window window);
 void DeadBall(Display *display, Window window);
 void DeleteABullet(Display *display);
@@ -86,6 +87,7 @@ char *GetLevelName(void);
 void DecLevelTimeBonus(Display *display, Window window);
 void SetLevelTimeBonus(Display *display, Window window, int seconds);
 int GetLevelTimeBonus(void);
+void DrawLevelTimeBonus(Display *display, Window window, int timebonus);
 void UpdateHighScores(Display *display);
 void AddExtraLife(Display *display);
 void EndTheGame(Display *display, Window window);
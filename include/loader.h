@@ -0,0 +1,128 @@
+#ifndef _LOADER_H_
+#define _LOADER_H_
+
+/*
+ * XBoing - An X11 blockout style computer game
+ *
+ * (c) Copyright 1993, 1994, 1995, Justin C. Kibell, All Rights Reserved
+ *
+ * The X Consortium, and any party obtaining a copy of these files from
+ * the X Consortium, directly or indirectly, is granted, free of charge, a
+ * full and unrestricted irrevocable, world-wide, paid up, royalty-free,
+ * nonexclusive right and license to deal in this software and
+ * documentation files (the "Software"), including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons who receive
+ * copies from any such party to do so.  This license includes without
+ * limitation a license to do the foregoing actions under any patents of
+ * the party supplying this software to the X Consortium.
+ *
+ * In no event shall the author be liable to any party for direct, indirect,
+ * special, incidental, or consequential damages arising out of the use of
+ * this software and its documentation, even if the author has been advised
+ * of the possibility of such damage.
+ *
+ * The author specifically disclaims any warranties, including, but not limited
+ * to, the implied warranties of merchantability and fitness for a particular
+ * purpose.  The software provided hereunder is on an "AS IS" basis, and the
+ * author has no obligation to provide maintenance, support, updates,
+ * enhancements, or modifications.
+ */
+
+/*
+ * =========================================================================
+ *
+ * Start up image loading. Loading is split in two: decoding the image
+ * files, which is pure CPU work and runs on a pool of worker threads, and
+ * uploading the decoded images as textures, which has to be done on the
+ * main thread. Modules queue their images early with QueueImage(), the
+ * pool decodes them all while the display is being set up, and each module
+ * waits with FinishImageDecode() just before it uploads its own.
+ *
+ *		QueueAtlasImages();				(QueueImage() for each sprite)
+ *		StartImageDecode();
+ *		...
+ *		FinishImageDecode();
+ *		BeginLoadTiming("atlas");
+ *		... LoadTextureFromImage() ...
+ *		EndLoadTiming();
+ *
+ * With -debug the time each module took to decode and upload, and the
+ * time to the first frame, are printed once the first frame is drawn.
+ *
+ * =========================================================================
+ */
+
+/*
+ *  Dependencies on other include files:
+ */
+
+#include <raylib.h>
+
+/*
+ *  Constants and macros:
+ */
+
+#define LOADER_MAX_THREADS	8
+#define LOADER_MAX_IMAGES	256
+#define LOADER_MAX_MODULES	16
+
+/*
+ *  Type declarations:
+ */
+
+/*
+ *  Function prototypes:
+ */
+
+/**
+ * @brief Starts the clock that the load times are measured from
+ *
+ * Call first thing, the time to first frame is counted from here.
+ */
+void StartLoadClock(void);
+
+/**
+ * @brief Queues an image to be decoded by the worker threads
+ *
+ * Queued after StartImageDecode() the image is decoded there and then.
+ *
+ * @param module Name of the module loading it, for the timings
+ * @param path Path of the image, loaded with LoadPackedImage()
+ * @param image Where the decoded image goes, data NULL if it failed
+ */
+void QueueImage(char *module, char *path, Image *image);
+
+/**
+ * @brief Starts the worker threads decoding the queued images
+ */
+void StartImageDecode(void);
+
+/**
+ * @brief Waits until every queued image has been decoded
+ *
+ * Safe to call any number of times and before StartImageDecode(), in which
+ * case the images are decoded first.
+ */
+void FinishImageDecode(void);
+
+/**
+ * @brief Starts timing a module's texture uploads
+ *
+ * @param module Name of the module, as given to QueueImage()
+ */
+void BeginLoadTiming(char *module);
+
+/**
+ * @brief Stops timing the module given to BeginLoadTiming()
+ */
+void EndLoadTiming(void);
+
+/**
+ * @brief Prints the load times, once, if debugging is on
+ *
+ * Called after every frame, only the first call prints anything.
+ */
+void ReportLoadTimes(void);
+
+#endif
@@ -156,4 +156,20 @@ void SetCurrentMessage(Display *display, Window window,
  */
 void DisplayCurrentMessage(Display *display, Window window);
 
+/**
+ * @brief Clears the message window and draws a message centred in it.
+ *
+ * @param Display *display Points to the X11 display struct.
+ * @param Window window The message window.
+ * @param char *message The text to draw.
+ * @param int clear Unused, the window is always cleared.
+ * @param int ci The colour to draw the text in.
+ *
+ * @post The message window shows the message. Called by the HUD when the
+ * message has changed, see FlushHud().
+ *
+ */
+void DrawMessage(Display *display, Window window, char *message, int clear,
+	int ci);
+
 #endif
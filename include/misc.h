@@ -202,10 +202,10 @@ int 	ObtainWindowWidthHeight(Display *display, Window window,
 			int *width, int *height);
 
 /**
- * @brief Stops program execution (usleep()) if needed to meet target framerate.
+ * @brief Waits for the server to catch up, then until ms have passed since the call
  * 
  * @param display The display of the current X11 window
- * @param ms The number of miliseconds to wait between each frame
+ * @param ms The number of miliseconds from the call to return after
  */
 void 	sleepSync(Display *display, unsigned long ms);
 
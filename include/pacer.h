@@ -0,0 +1,148 @@
+#ifndef _PACER_H_
+#define _PACER_H_
+
+/*
+ * XBoing - An X11 blockout style computer game
+ *
+ * (c) Copyright 1993, 1994, 1995, Justin C. Kibell, All Rights Reserved
+ *
+ * The X Consortium, and any party obtaining a copy of these files from
+ * the X Consortium, directly or indirectly, is granted, free of charge, a
+ * full and unrestricted irrevocable, world-wide, paid up, royalty-free,
+ * nonexclusive right and license to deal in this software and
+ * documentation files (the "Software"), including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons who receive
+ * copies from any such party to do so.  This license includes without
+ * limitation a license to do the foregoing actions under any patents of
+ * the party supplying this software to the X Consortium.
+ *
+ * In no event shall the author be liable to any party for direct, indirect,
+ * special, incidental, or consequential damages arising out of the use of
+ * this software and its documentation, even if the author has been advised
+ * of the possibility of such damage.
+ *
+ * The author specifically disclaims any warranties, including, but not limited
+ * to, the implied warranties of merchantability and fitness for a particular
+ * purpose.  The software provided hereunder is on an "AS IS" basis, and the
+ * author has no obligation to provide maintenance, support, updates,
+ * enhancements, or modifications.
+ */
+
+/*
+ * =========================================================================
+ *
+ * Frame pacer. Waits for absolute deadlines on the monotonic clock,
+ * sleeping with clock_nanosleep() until PACE_SPIN_USEC before the deadline
+ * and spinning for the rest, so a wait neither drifts nor oversleeps by
+ * the scheduler's slack.
+ *
+ * It also keeps the last PACE_HISTORY samples of three timings: the time
+ * between frames, the time spent running game ticks in a frame and the
+ * time spent in the render pass after them. GetPaceStats()
+ * returns their histogram and percentiles while the game runs and
+ * ReportPaceStats() prints them, with -debug, on exit.
+ *
+ * =========================================================================
+ */
+
+/*
+ *  Dependencies on other include files:
+ */
+
+/*
+ *  Constants and macros:
+ */
+
+/* Timings kept */
+#define PACE_FRAME			0
+#define PACE_SIM			1
+#define PACE_RENDER			2
+#define PACE_SERIES			3
+
+/* Samples kept for each timing, about ten seconds of frames */
+#define PACE_HISTORY		600
+
+/* One millisecond histogram buckets, the last takes everything slower */
+#define PACE_BUCKETS		34
+
+/* How much of the end of a wait is spun instead of slept */
+#define PACE_SPIN_USEC		500L
+
+/* Frames drawn a second when the game ticks slower than this */
+#define PACE_FRAME_RATE		60
+
+/*
+ *  Type declarations:
+ */
+
+typedef struct
+{
+	int 	count;					/* Samples in the history */
+	long 	mean, p50, p95, p99;	/* Microseconds */
+	long 	max;
+	int 	buckets[PACE_BUCKETS];	/* Samples in each millisecond */
+} paceStats;
+
+/*
+ *  Function prototypes:
+ */
+
+/**
+ * @brief Reads the monotonic clock
+ *
+ * @return long Microseconds since an arbitrary fixed point
+ */
+long 	PaceNow(void);
+
+/**
+ * @brief Waits until the monotonic clock reaches the deadline
+ *
+ * @param deadline Time from PaceNow() to wake at, in the past returns now
+ */
+void 	PaceUntil(long deadline);
+
+/**
+ * @brief Starts a frame, recording the time since the last one started
+ */
+void 	BeginPacedFrame(void);
+
+/**
+ * @brief Records the sim and render time the frame took
+ */
+void 	EndPacedFrame(void);
+
+/**
+ * @brief When the frame started by BeginPacedFrame() should be followed
+ * @return long Time from PaceNow() of the next frame at PACE_FRAME_RATE
+ */
+long 	PaceFrameDeadline(void);
+
+/**
+ * @brief Starts timing part of the frame
+ *
+ * @param series PACE_SIM or PACE_RENDER
+ */
+void 	BeginPaceTimer(int series);
+
+/**
+ * @brief Adds the time since BeginPaceTimer() to this frame's total
+ *
+ * @param series PACE_SIM or PACE_RENDER
+ */
+void 	EndPaceTimer(int series);
+
+/**
+ * @brief Returns the histogram and percentiles of one timing
+ *
+ * @param series One of the PACE_ timings
+ * @param stats Filled in from the samples in the history
+ */
+void 	GetPaceStats(int series, paceStats *stats);
+
+/**
+ * @brief Prints the timings if debugging, for use on exit
+ */
+void 	ReportPaceStats(void);
+
+#endif
@@ -0,0 +1,183 @@
+#ifndef _PACK_H_
+#define _PACK_H_
+
+/*
+ * XBoing - An X11 blockout style computer game
+ *
+ * (c) Copyright 1993, 1994, 1995, Justin C. Kibell, All Rights Reserved
+ *
+ * The X Consortium, and any party obtaining a copy of these files from
+ * the X Consortium, directly or indirectly, is granted, free of charge, a
+ * full and unrestricted irrevocable, world-wide, paid up, royalty-free,
+ * nonexclusive right and license to deal in this software and
+ * documentation files (the "Software"), including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons who receive
+ * copies from any such party to do so.  This license includes without
+ * limitation a license to do the foregoing actions under any patents of
+ * the party supplying this software to the X Consortium.
+ *
+ * In no event shall the author be liable to any party for direct, indirect,
+ * special, incidental, or consequential damages arising out of the use of
+ * this software and its documentation, even if the author has been advised
+ * of the possibility of such damage.
+ *
+ * The author specifically disclaims any warranties, including, but not limited
+ * to, the implied warranties of merchantability and fitness for a particular
+ * purpose.  The software provided hereunder is on an "AS IS" basis, and the
+ * author has no obligation to provide maintenance, support, updates,
+ * enhancements, or modifications.
+ */
+
+/*
+ * =========================================================================
+ *
+ * Asset pack. xbpack (see xbpack.c) gathers every sprite, background,
+ * sound and level into one file, already decoded: images as 8 bit RGBA,
+ * sounds as 16 bit native endian PCM and levels as their text. The game
+ * maps the file in at start up and hands the mapped bytes straight to the
+ * texture upload, the sound device or the level parser, so a cold start
+ * opens one file instead of a few hundred.
+ *
+ * Assets are looked up by the path they have in the source tree, such as
+ * "bitmaps/blocks/redblk.png" or "sounds/boing.au". Anything that is not
+ * in the pack, or every asset if there is no pack, is read from its own
+ * file as before.
+ *
+ * The file is a packHeader, then numEntries packEntry records sorted by
+ * name, then the data. Every entry starts on a PACK_ALIGN boundary.
+ *
+ * =========================================================================
+ */
+
+/*
+ *  Dependencies on other include files:
+ */
+
+#include <stdio.h>
+
+/* The headless build has no raylib and no images to load */
+#ifndef HEADLESS
+#include <raylib.h>
+#endif
+
+/*
+ *  Constants and macros:
+ */
+
+/* Pack read when $XBOING_PACK_FILE is not set */
+#ifndef PACK_FILE
+#define PACK_FILE		"xboing.pak"
+#endif
+
+#define PACK_MAGIC		"XBPK"
+#define PACK_VERSION	1
+#define PACK_NAME_LEN	56
+#define PACK_ALIGN		16
+
+/* Entry types */
+#define PACK_IMAGE		1		/* RGBA, width by height */
+#define PACK_SOUND		2		/* 16 bit PCM, width is the rate, height
+								 * the number of channels */
+#define PACK_LEVEL		3		/* Level file text */
+
+/*
+ *  Type declarations:
+ */
+
+typedef struct
+{
+	char			magic[4];
+	unsigned int	version;
+	unsigned int	numEntries;
+	unsigned int	reserved;
+} packHeader;
+
+typedef struct
+{
+	char			name[PACK_NAME_LEN];
+	unsigned int	type;
+	unsigned int	offset;		/* From the start of the file */
+	unsigned int	size;		/* In bytes */
+	unsigned int	width;
+	unsigned int	height;
+	unsigned int	reserved;
+} packEntry;
+
+/*
+ *  Function prototypes:
+ */
+
+/**
+ * @brief Maps the asset pack in, if there is one
+ *
+ * @return True if the pack is mapped, False if the game has to read the
+ * asset files one by one
+ */
+int OpenAssetPack(void);
+
+/**
+ * @brief Unmaps the asset pack, everything got from it becomes invalid
+ */
+void CloseAssetPack(void);
+
+/**
+ * @brief Finds an asset in the pack
+ *
+ * @param name Path of the asset in the source tree
+ * @param type PACK_IMAGE, PACK_SOUND or PACK_LEVEL
+ *
+ * @return The entry, or NULL if there is no pack or it is not in it
+ */
+packEntry *FindPackEntry(char *name, int type);
+
+/**
+ * @brief Returns where an entry's data is mapped
+ *
+ * @param entry From FindPackEntry()
+ *
+ * @return Pointer to the first byte of the data, valid until the pack is
+ * closed
+ */
+unsigned char *GetPackData(packEntry *entry);
+
+/**
+ * @brief Opens a packed level for reading with the stdio calls
+ *
+ * @param name Path of the level in the source tree, e.g. levels/level01.data
+ *
+ * @return A stream reading the mapped text, or NULL if it is not packed
+ */
+FILE *OpenPackedLevel(char *name);
+
+#ifndef HEADLESS
+/**
+ * @brief Loads an image from the pack, or from its file if not packed
+ *
+ * A packed image points at the mapped bytes, so free it with
+ * UnloadPackedImage() and never change it in place.
+ *
+ * @param path Path of the image in the source tree
+ *
+ * @return The image, with data NULL if it could not be loaded
+ */
+Image LoadPackedImage(char *path);
+
+/**
+ * @brief Frees an image from LoadPackedImage()
+ *
+ * @param image The image, nothing is freed if it is mapped from the pack
+ */
+void UnloadPackedImage(Image image);
+
+/**
+ * @brief Loads a texture from the pack, or from its file if not packed
+ *
+ * @param path Path of the image in the source tree
+ *
+ * @return The texture, with id 0 if it could not be loaded
+ */
+Texture2D LoadPackedTexture(char *path);
+#endif
+
+#endif
@@ -55,6 +55,7 @@
 #define SIZE_UP         1
 #define SIZE_DOWN       2
 
+#ifndef HEADLESS
 
 /**
  * @brief Loads paddle images into memory as Raylib Texture2D
@@ -78,6 +79,15 @@ void FreePaddle(void);
 void DrawPaddle(void);
 
 
+/**
+ * @brief Draws the paddle image for a paddle size at a position
+ * 
+ * @param x upper left paddle pixel
+ * @param size paddle size in pixels, as GetPaddleSize()
+ */
+void DrawPaddleAt(int x, int size);
+
+
 /**
  * @brief Moves the paddle horizontally.
  * 
@@ -119,6 +129,14 @@ char *GetPaddleDescription(void);
  */
 int GetPaddlePositionX(void);
 
+
+/**
+ * @brief Returns the paddle position before the last sim tick moved it
+ * 
+ * @return int upper left paddle pixel
+ */
+int GetPaddlePrevPositionX(void);
+
 int GetPaddlePositionY(void);
 
 Rectangle GetPaddleCollisionRec(void);
@@ -158,6 +176,32 @@ void ChangePaddleSize(int changeDirection);
 
 Vector2 GetBallSpawnPointOnPaddle();
 
+#else
+
+#include "faketypes.h"
+
+/*
+ * The game core still moves the paddle through the X interface below,
+ * which headless.c provides for the simulator.
+ */
+#define PADDLE_SMALL	4
+#define PADDLE_MEDIUM	5
+#define PADDLE_HUGE		6
+
+extern int paddlePos;
+extern int currentPaddleSize;
+extern int reverseOn;
+
+void MovePaddle(Display *display, Window window, int direction, int size,
+	int xpos);
+void ResetPaddleStart(Display *display, Window window);
+int GetPaddleSize(void);
+void ChangePaddleSize(Display *display, Window window, int type);
+void ToggleReverse(Display *display);
+void SetReverseOff(void);
+
+#endif
+
 
 // not used in program ??
 // #define PADDLE_HC  		4
@@ -90,6 +90,7 @@ void FreeAllPresents(Display *display);
 void ResetPresents(void);
 void QuickFinish(Display *display, Window window);
 void FreeSomePresents(Display *display);
+void SetUpEarth(Display *display, Window window, Colormap colormap);
 
 extern 	enum PresentStates PresentState;
 extern Pixmap earthPixmap, earthPixmapM;
@@ -0,0 +1,166 @@
+#ifndef _REPLAY_H_
+#define _REPLAY_H_
+
+/*
+ * XBoing - An X11 blockout style computer game
+ *
+ * (c) Copyright 1993, 1994, 1995, Justin C. Kibell, All Rights Reserved
+ *
+ * The X Consortium, and any party obtaining a copy of these files from
+ * the X Consortium, directly or indirectly, is granted, free of charge, a
+ * full and unrestricted irrevocable, world-wide, paid up, royalty-free,
+ * nonexclusive right and license to deal in this software and
+ * documentation files (the "Software"), including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons who receive
+ * copies from any such party to do so.  This license includes without
+ * limitation a license to do the foregoing actions under any patents of
+ * the party supplying this software to the X Consortium.
+ *
+ * In no event shall the author be liable to any party for direct, indirect,
+ * special, incidental, or consequential damages arising out of the use of
+ * this software and its documentation, even if the author has been advised
+ * of the possibility of such damage.
+ *
+ * The author specifically disclaims any warranties, including, but not limited
+ * to, the implied warranties of merchantability and fitness for a particular
+ * purpose.  The software provided hereunder is on an "AS IS" basis, and the
+ * author has no obligation to provide maintenance, support, updates,
+ * enhancements, or modifications.
+ */
+
+/*
+ * =========================================================================
+ *
+ * Input recording and replay. A recording holds the game seed and settings
+ * followed by every key, mouse button and paddle position the player gave
+ * during one game, each tagged with the frame it was acted on. Playing the
+ * records back into the same frames plays the same game again, either in
+ * the window at normal speed or in xboing-sim as fast as it will go.
+ *
+ * =========================================================================
+ */
+
+/*
+ *  Dependencies on other include files:
+ */
+
+/*
+ *  Constants and macros:
+ */
+
+#define REPLAY_NONE			0
+#define REPLAY_RECORD		1
+#define REPLAY_PLAY			2
+
+/* Record types - values are KeySyms, mouse buttons or pointer x */
+#define REPLAY_END			0
+#define REPLAY_KEY_DOWN		1
+#define REPLAY_KEY_UP		2
+#define REPLAY_BUTTON_DOWN	3
+#define REPLAY_BUTTON_UP	4
+#define REPLAY_PADDLE_X		5
+
+/* Paddle x recorded when the pointer could not be read */
+#define REPLAY_NO_PADDLE	-1
+
+#define REPLAY_MAGIC		"XBRP"
+#define REPLAY_VERSION		1
+
+/* X11 KeySym values of the game keys, for playback without Xlib */
+#define REPLAY_XK_LEFT		0xff51
+#define REPLAY_XK_RIGHT		0xff53
+
+/*
+ *  Type declarations:
+ */
+
+typedef struct
+{
+	unsigned long 	seed;			/* Game random seed at the start */
+	int				startLevel;		/* Level the game started on */
+	int 			startFrame;		/* Frame the game started on */
+	int 			warpSpeed;		/* Warp speed 1 - 9 at the start */
+	int 			controlMode;	/* CONTROL_KEYS or CONTROL_MOUSE */
+	int 			collisionMode;	/* COLLIDE_STEP or COLLIDE_SWEPT */
+} replayHeader;
+
+/*
+ *  Function prototypes:
+ */
+
+/**
+ * @brief Opens a file to record the next game into
+ *
+ * @param path File to create, overwritten if it exists
+ * @return int True if the file could be opened, False otherwise
+ */
+int 	StartReplayRecord(char *path);
+
+/**
+ * @brief Loads a recording to be played back as the next game
+ *
+ * @param path File written by StartReplayRecord()
+ * @return int True if the recording is usable, False otherwise
+ */
+int 	StartReplayPlayback(char *path);
+
+/**
+ * @brief Called as a new game is set up, before its first level loads
+ *
+ * Recording reseeds the game and writes the header, playback puts the
+ * seed and settings back the way they were recorded.
+ *
+ * @param when The current frame
+ */
+void 	BeginReplayGame(int when);
+
+/**
+ * @brief Appends one input to the recording
+ *
+ * Does nothing unless a game is being recorded. Paddle positions are only
+ * written when they change.
+ *
+ * @param when The frame the input is acted on
+ * @param type One of the REPLAY_ record types
+ * @param value The KeySym, button or pointer x
+ */
+void 	RecordReplayInput(int when, int type, int value);
+
+/**
+ * @brief Returns the next recorded input due by a frame
+ *
+ * Call until it returns False at the start of each frame. The REPLAY_END
+ * record is returned once and then playback is over.
+ *
+ * @param when The current frame
+ * @param type Returns one of the REPLAY_ record types
+ * @param value Returns the KeySym, button or pointer x
+ * @return int True if an input was returned, False if none are due
+ */
+int 	NextReplayInput(int when, int *type, int *value);
+
+/**
+ * @brief Finishes and closes the recording, or abandons playback
+ *
+ * @param when The current frame
+ */
+void 	EndReplay(int when);
+
+/**
+ * @brief Whether a game is being recorded, played back or neither
+ *
+ * @return int REPLAY_NONE, REPLAY_RECORD or REPLAY_PLAY
+ */
+int 	GetReplayMode(void);
+
+/**
+ * @brief The frame the recorded game started on
+ *
+ * Playback must start the game on this frame for the inputs to line up.
+ *
+ * @return int The start frame, 0 if nothing is being played back
+ */
+int 	GetReplayStartFrame(void);
+
+#endif
@@ -0,0 +1,117 @@
+#ifndef _RNG_H_
+#define _RNG_H_
+
+/*
+ * XBoing - An X11 blockout style computer game
+ *
+ * (c) Copyright 1993, 1994, 1995, Justin C. Kibell, All Rights Reserved
+ *
+ * The X Consortium, and any party obtaining a copy of these files from
+ * the X Consortium, directly or indirectly, is granted, free of charge, a
+ * full and unrestricted irrevocable, world-wide, paid up, royalty-free,
+ * nonexclusive right and license to deal in this software and
+ * documentation files (the "Software"), including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons who receive
+ * copies from any such party to do so.  This license includes without
+ * limitation a license to do the foregoing actions under any patents of
+ * the party supplying this software to the X Consortium.
+ *
+ * In no event shall the author be liable to any party for direct, indirect,
+ * special, incidental, or consequential damages arising out of the use of
+ * this software and its documentation, even if the author has been advised
+ * of the possibility of such damage.
+ *
+ * The author specifically disclaims any warranties, including, but not limited
+ * to, the implied warranties of merchantability and fitness for a particular
+ * purpose.  The software provided hereunder is on an "AS IS" basis, and the
+ * author has no obligation to provide maintenance, support, updates,
+ * enhancements, or modifications.
+ */
+
+/*
+ * =========================================================================
+ *
+ * Seeded random number streams. Every part of the game that makes random
+ * choices has its own stream, all started from one game seed, so the same
+ * seed and the same input always play the same game. Streams are small
+ * PCG32 generators with their state held in an RNG, so a second game can
+ * keep its own set without touching these.
+ *
+ * =========================================================================
+ */
+
+/*
+ *  Dependencies on other include files:
+ */
+
+/*
+ *  Constants and macros:
+ */
+
+/* One stream for each part of the game core */
+#define RNG_BALL			0		/* Ball launch, bounce jitter, teleport */
+#define RNG_BLOCKS			1		/* Random, drop and roamer blocks */
+#define RNG_BONUS			2		/* Bonus and special block spawning */
+#define RNG_EYEDUDE			3		/* Eye dude walks */
+#define RNG_PREVIEW			4		/* Level preview in the intro */
+#define NUM_RNG_STREAMS		5
+
+/* Largest value GameRandom() returns, same as a 31 bit rand() */
+#define GAME_RAND_MAX		0x7fffffff
+
+/*
+ *  Type declarations:
+ */
+
+typedef struct
+{
+	unsigned long long 	state;		/* Current position in the sequence */
+	unsigned long long 	inc;		/* Stream selector, always odd */
+} RNG;
+
+/*
+ *  Function prototypes:
+ */
+
+/**
+ * @brief Starts a generator at the beginning of one stream for a seed
+ *
+ * @param rng The generator to set up
+ * @param seed Any value - the same seed gives the same sequence
+ * @param stream Which of the 2^63 independent sequences to use
+ */
+void 			SeedRng(RNG *rng, unsigned long long seed, 
+					unsigned long long stream);
+
+/**
+ * @brief Returns the next 32 random bits from a generator
+ *
+ * @param rng The generator to advance
+ * @return unsigned int The next value
+ */
+unsigned int 	NextRng(RNG *rng);
+
+/**
+ * @brief Restarts every game stream from a new seed
+ *
+ * @param seed The game seed, as given with -seed
+ */
+void 			SeedGameRandom(unsigned long seed);
+
+/**
+ * @brief The seed the game streams were last started from
+ *
+ * @return unsigned long The game seed
+ */
+unsigned long 	GetGameSeed(void);
+
+/**
+ * @brief Returns the next value from one game stream
+ *
+ * @param stream One of the RNG_ stream numbers
+ * @return int A value from 0 to GAME_RAND_MAX, use like rand()
+ */
+int 			GameRandom(int stream);
+
+#endif
@@ -125,7 +125,7 @@ int WindowShakeEffect(Display *display, Window window);
  * @param Display *display The display of the x11 window
  * @param Window window The X11 window to draw on.
  *
- * @return int False when done.
+ * @return int True while the effect is going, False when the effect is finished.
  *
  */
 int WindowShatterEffect(Display *display, Window window);
@@ -136,6 +136,8 @@ int WindowShatterEffect(Display *display, Window window);
  * @param Display *display The display of the X11 window
  * @param Window window The X11 window to draw on
  *
+ * @return int True while the effect is going, False when the effect is finished.
+ *
  */
 int WindowBlindEffect(Display *display, Window window);
 
@@ -163,6 +165,25 @@ int WindowFadeEffect(Display *display, Window window, int w, int h);
  */
 int WindowStaticEffect(Display *display, Window window, int w, int h);
 
+/**
+ * Sends raylib drawing into the buffer the blind and shatter effects bring
+ * into view, until EndSfxBuffer().
+ *
+ */
+void BeginSfxBuffer(void);
+
+/**
+ * Sends raylib drawing back to the screen after BeginSfxBuffer().
+ *
+ */
+void EndSfxBuffer(void);
+
+/**
+ * Frees the effect shaders and buffer.
+ *
+ */
+void FreeSfx(void);
+
 /**
  * Accessor for useSfx variable (return value)
  *
@@ -0,0 +1,120 @@
+#ifndef _SIMCLOCK_H_
+#define _SIMCLOCK_H_
+
+/*
+ * XBoing - An X11 blockout style computer game
+ *
+ * (c) Copyright 1993, 1994, 1995, Justin C. Kibell, All Rights Reserved
+ *
+ * The X Consortium, and any party obtaining a copy of these files from
+ * the X Consortium, directly or indirectly, is granted, free of charge, a
+ * full and unrestricted irrevocable, world-wide, paid up, royalty-free,
+ * nonexclusive right and license to deal in this software and
+ * documentation files (the "Software"), including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons who receive
+ * copies from any such party to do so.  This license includes without
+ * limitation a license to do the foregoing actions under any patents of
+ * the party supplying this software to the X Consortium.
+ *
+ * In no event shall the author be liable to any party for direct, indirect,
+ * special, incidental, or consequential damages arising out of the use of
+ * this software and its documentation, even if the author has been advised
+ * of the possibility of such damage.
+ *
+ * The author specifically disclaims any warranties, including, but not limited
+ * to, the implied warranties of merchantability and fitness for a particular
+ * purpose.  The software provided hereunder is on an "AS IS" basis, and the
+ * author has no obligation to provide maintenance, support, updates,
+ * enhancements, or modifications.
+ */
+
+/*
+ * =========================================================================
+ *
+ * Fixed timestep simulation clock. The game core always advances in whole
+ * ticks of a fixed length; the event loop asks how many ticks are due for
+ * the wall time that has passed and renders in between using SimAlpha().
+ *
+ * =========================================================================
+ */
+
+/*
+ *  Dependencies on other include files:
+ */
+
+/*
+ *  Constants and macros:
+ */
+
+/* Most ticks run per rendered frame before the backlog is dropped */
+#define SIM_MAX_TICKS_PER_FRAME		8
+
+/* Shortest tick length allowed in milliseconds */
+#define SIM_MIN_TICK_MS				1
+
+/*
+ *  Type declarations:
+ */
+
+/*
+ *  Function prototypes:
+ */
+
+/**
+ * @brief Starts the clock with an empty accumulator
+ *
+ * @param tickMs The length of one simulation tick in milliseconds
+ */
+void 	InitSimClock(long tickMs);
+
+/**
+ * @brief Changes the tick length, keeping any time already accumulated
+ *
+ * @param tickMs The length of one simulation tick in milliseconds
+ */
+void 	SetSimTickLength(long tickMs);
+
+/**
+ * @brief Forgets elapsed time, e.g. after a pause or iconify
+ */
+void 	ResetSimClock(void);
+
+/**
+ * @brief Adds the wall time since the last call and returns the ticks due
+ *
+ * @return int Number of ticks to run now, at most SIM_MAX_TICKS_PER_FRAME
+ */
+int 	SimTicksDue(void);
+
+/**
+ * @brief Fraction of the next tick already elapsed, for interpolation
+ *
+ * @return float Value in [0, 1)
+ */
+float 	SimAlpha(void);
+
+/**
+ * @brief Length of one simulation tick
+ *
+ * @return float Tick length in seconds
+ */
+float 	SimTickSeconds(void);
+
+/**
+ * @brief Time until the next tick is due
+ *
+ * @return long Microseconds until SimTicksDue() will return non zero
+ */
+long 	SimTimeToNextTick(void);
+
+/**
+ * @brief Interpolates a coordinate between the last two ticks
+ *
+ * @param prev The coordinate at the previous tick
+ * @param curr The coordinate at the current tick
+ * @return int The coordinate to draw at
+ */
+int 	SimLerp(int prev, int curr);
+
+#endif
@@ -0,0 +1,103 @@
+#ifndef _SNAPSHOT_H_
+#define _SNAPSHOT_H_
+
+/*
+ * XBoing - An X11 blockout style computer game
+ *
+ * (c) Copyright 1993, 1994, 1995, Justin C. Kibell, All Rights Reserved
+ *
+ * The X Consortium, and any party obtaining a copy of these files from
+ * the X Consortium, directly or indirectly, is granted, free of charge, a
+ * full and unrestricted irrevocable, world-wide, paid up, royalty-free,
+ * nonexclusive right and license to deal in this software and
+ * documentation files (the "Software"), including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons who receive
+ * copies from any such party to do so.  This license includes without
+ * limitation a license to do the foregoing actions under any patents of
+ * the party supplying this software to the X Consortium.
+ *
+ * In no event shall the author be liable to any party for direct, indirect,
+ * special, incidental, or consequential damages arising out of the use of
+ * this software and its documentation, even if the author has been advised
+ * of the possibility of such damage.
+ *
+ * The author specifically disclaims any warranties, including, but not limited
+ * to, the implied warranties of merchantability and fitness for a particular
+ * purpose.  The software provided hereunder is on an "AS IS" basis, and the
+ * author has no obligation to provide maintenance, support, updates,
+ * enhancements, or modifications.
+ */
+
+/*
+ * =========================================================================
+ *
+ * Game state snapshots. Once a frame, after however many game ticks were
+ * due, the render pass copies what the moving objects look like - balls,
+ * bullets, the eye dude and the paddle - into a snapshot, blended between
+ * the last two ticks, and draws from it. Whatever changed since the last
+ * snapshot drawn is erased first, so the objects are erased and drawn
+ * only once a frame.
+ *
+ * The render pass runs on the main thread between ticks, so a snapshot is
+ * a plain copy with no locking.
+ *
+ * Tinks, ball births and the HUD are still drawn when they change by the
+ * sim and hud.c. The blocks come from the block layer, see blocks.c.
+ *
+ * =========================================================================
+ */
+
+/*
+ *  Dependencies on other include files:
+ */
+
+#include "faketypes.h"
+#include "ball.h"
+#include "gun.h"
+
+/*
+ *  Constants and macros:
+ */
+
+/*
+ *  Type declarations:
+ */
+
+typedef struct
+{
+	int 	shown;				/* True if drawn at all */
+	int 	x, y;				/* Centre */
+	int 	slide;				/* Animation frame */
+	int 	direction;			/* Eye dude only, WALK_LEFT etc */
+} snapObject;
+
+typedef struct
+{
+	int 		frame;						/* Tick it was taken after */
+	snapObject 	balls[MAX_BALLS];
+	snapObject 	bullets[MAX_MOVING_BULLETS];
+	snapObject 	eyeDude;
+	int 		paddleX;					/* Left edge, blended */
+	int 		paddleSize;
+} gameSnapshot;
+
+/*
+ *  Function prototypes:
+ */
+
+/**
+ * @brief Takes a snapshot of the moving objects, erases what moved since
+ * the last one drawn and draws it
+ *
+ * @param display The display of the X11 window
+ * @param window The play window
+ */
+void 	RenderSnapshot(Display *display, Window window);
+
+/**
+ * @brief Forgets what was drawn, for when the play window has been cleared
+ */
+void 	ForgetDrawnSnapshot(void);
+
+#endif
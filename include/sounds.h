@@ -0,0 +1,162 @@
+#ifndef _SOUNDS_H_
+#define _SOUNDS_H_
+
+/*
+ * XBoing - An X11 blockout style computer game
+ *
+ * (c) Copyright 1993, 1994, 1995, Justin C. Kibell, All Rights Reserved
+ *
+ * The X Consortium, and any party obtaining a copy of these files from
+ * the X Consortium, directly or indirectly, is granted, free of charge, a
+ * full and unrestricted irrevocable, world-wide, paid up, royalty-free,
+ * nonexclusive right and license to deal in this software and
+ * documentation files (the "Software"), including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons who receive
+ * copies from any such party to do so.  This license includes without
+ * limitation a license to do the foregoing actions under any patents of
+ * the party supplying this software to the X Consortium.
+ *
+ * In no event shall the author be liable to any party for direct, indirect,
+ * special, incidental, or consequential damages arising out of the use of
+ * this software and its documentation, even if the author has been advised
+ * of the possibility of such damage.
+ *
+ * The author specifically disclaims any warranties, including, but not limited
+ * to, the implied warranties of merchantability and fitness for a particular
+ * purpose.  The software provided hereunder is on an "AS IS" basis, and the
+ * author has no obligation to provide maintenance, support, updates,
+ * enhancements, or modifications.
+ */
+
+/*
+ * =========================================================================
+ *
+ * Sound registry. Every sound the game plays has a fixed id, SND_BOING
+ * and so on, which the game passes to playSound() so that starting a
+ * sound does no string handling at all. The audio backend loads its
+ * samples by id when it is set up.
+ *
+ * playSound() does not start the sound straight away. The sounds asked
+ * for are collected and started by FlushSounds() once a frame: a sound
+ * asked for several times in the frame starts once, louder, a sound
+ * started again within its retrigger interval is skipped, and at most
+ * SOUND_FRAME_BUDGET sounds start in one frame. Ten balls hitting the
+ * wall in one frame make one boing.
+ *
+ * Sounds can still be found by name, for playSoundFile(), through a hash
+ * table of the names built the first time it is needed.
+ *
+ * =========================================================================
+ */
+
+/*
+ *  Dependencies on other include files:
+ */
+
+/*
+ *  Constants and macros:
+ */
+
+/* One for each file in sounds/, named after it */
+#define SND_DOH1			0
+#define SND_DOH2			1
+#define SND_DOH3			2
+#define SND_DOH4			3
+#define SND_AMMO			4
+#define SND_APPLAUSE		5
+#define SND_BALL2BALL		6
+#define SND_BALLLOST		7
+#define SND_BALLSHOT		8
+#define SND_BOING			9
+#define SND_BOMB			10
+#define SND_BONUS			11
+#define SND_BUZZER			12
+#define SND_CLICK			13
+#define SND_DDLOO			14
+#define SND_EVILLAUGH		15
+#define SND_GAME_OVER		16
+#define SND_GATE			17
+#define SND_HITHERE			18
+#define SND_HYPSPC			19
+#define SND_INTRO			20
+#define SND_KEY				21
+#define SND_LOOKSBAD		22
+#define SND_METAL			23
+#define SND_MGUN			24
+#define SND_OUCH			25
+#define SND_PADDLE			26
+#define SND_PING			27
+#define SND_SHARK			28
+#define SND_SHOOT			29
+#define SND_SHOTGUN			30
+#define SND_SPRING			31
+#define SND_STAMP			32
+#define SND_STICKY			33
+#define SND_SUPBONS			34
+#define SND_TOGGLE			35
+#define SND_TONE			36
+#define SND_TOUCH			37
+#define SND_WALLSOFF		38
+#define SND_WARP			39
+#define SND_WEEEK			40
+#define SND_WHIZZO			41
+#define SND_WHOOSH			42
+#define SND_WZZZ			43
+#define SND_WZZZ2			44
+#define SND_YOUAGOD			45
+#define NUM_SOUNDS			46
+
+#define SND_NONE			-1
+
+/* Most sounds started in one frame, the loudest win */
+#define SOUND_FRAME_BUDGET	4
+
+/* Power of two, at least twice NUM_SOUNDS */
+#define SOUND_HASH_SIZE		128
+
+/*
+ *  Type declarations:
+ */
+
+/*
+ *  Function prototypes:
+ */
+
+/**
+ * @brief Looks up the id of a sound
+ *
+ * @param name Sound file name without the .au
+ *
+ * @return The SND_ id, or SND_NONE if there is no such sound
+ */
+int 	GetSoundId(char *name);
+
+/**
+ * @brief Returns the name of a sound
+ *
+ * @param id A SND_ id
+ *
+ * @return The sound file name without the .au, or NULL for a bad id
+ */
+char 	*GetSoundName(int id);
+
+/**
+ * @brief Asks for a sound to be played this frame, see FlushSounds()
+ *
+ * @param id A SND_ id
+ * @param volume Volume from 1 to 100, also the sound's priority
+ */
+void 	playSound(int id, int volume);
+
+/**
+ * @brief Starts the sounds asked for since the last flush, once a frame
+ */
+void 	FlushSounds(void);
+
+/**
+ * @brief With -debug prints how many sounds were merged, skipped or cut
+ */
+void 	ReportSoundStats(void);
+
+#endif
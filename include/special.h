@@ -80,6 +80,17 @@
  */
 void DrawSpecials(Display *display);
 
+/**
+ * Draws the specials panel text, lit specials in yellow
+ *
+ * @param Display *display display pointer
+ * @param int lit Bits for the specials to light, made by DrawSpecials()
+ * @return void 
+ * @post the specials window shows the lit specials
+ * 
+ */
+void RenderSpecials(Display *display, int lit);
+
 /**
  * toggles state of fast gun powerup
  *
@@ -165,6 +165,22 @@ void DrawStageBackground(Display *display, Window window, int stageType,
  */
 void SetBackgrounds(Display *display, Colormap colormap);
 
+/**
+ * Queues the background images to be decoded by the loader threads, so
+ * they are ready by the time SetBackgrounds() uploads them.
+ */
+void QueueBackgroundImages(void);
+
+/**
+ * Finds where a window's contents start inside the main window
+ *
+ * @param Window window The play, buffer or input dialogue window
+ * @param int *x Set to the left edge of the contents
+ * @param int *y Set to the top edge of the contents
+ * 
+ */
+void GetWindowOrigin(Window window, int *x, int *y);
+
 /**
  * Makes the devil eyes blink
  *
@@ -0,0 +1,102 @@
+#ifndef _TEXTCACHE_H_
+#define _TEXTCACHE_H_
+
+/*
+ * XBoing - An X11 blockout style computer game
+ *
+ * (c) Copyright 1993, 1994, 1995, Justin C. Kibell, All Rights Reserved
+ *
+ * The X Consortium, and any party obtaining a copy of these files from
+ * the X Consortium, directly or indirectly, is granted, free of charge, a
+ * full and unrestricted irrevocable, world-wide, paid up, royalty-free,
+ * nonexclusive right and license to deal in this software and
+ * documentation files (the "Software"), including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons who receive
+ * copies from any such party to do so.  This license includes without
+ * limitation a license to do the foregoing actions under any patents of
+ * the party supplying this software to the X Consortium.
+ *
+ * In no event shall the author be liable to any party for direct, indirect,
+ * special, incidental, or consequential damages arising out of the use of
+ * this software and its documentation, even if the author has been advised
+ * of the possibility of such damage.
+ *
+ * The author specifically disclaims any warranties, including, but not limited
+ * to, the implied warranties of merchantability and fitness for a particular
+ * purpose.  The software provided hereunder is on an "AS IS" basis, and the
+ * author has no obligation to provide maintenance, support, updates,
+ * enhancements, or modifications.
+ */
+
+/*
+ * =========================================================================
+ *
+ * Text cache - strings drawn with the X core fonts are rendered once into
+ * a pixmap and mask and after that drawn with a single masked copy.
+ *
+ * Entries are keyed on the font, the characters drawn, the colour and
+ * whether the 2 pixel black shadow is wanted. The least recently drawn
+ * are freed when there are more than TEXT_CACHE_ENTRIES of them or they
+ * hold more than TEXT_CACHE_KB of pixmaps. Strings of TEXT_CACHE_LEN
+ * characters or more are not cached and the caller draws them directly.
+ *
+ * =========================================================================
+ */
+
+/*
+ *  Dependencies on other include files:
+ */
+
+#include "faketypes.h"
+
+/*
+ *  Constants and macros:
+ */
+
+#define TEXT_CACHE_ENTRIES	256
+#define TEXT_CACHE_KB		2048
+#define TEXT_CACHE_LEN		128
+#define TEXT_CACHE_BUCKETS	512
+
+/*
+ *  Type declarations:
+ */
+
+/*
+ *  Function prototypes:
+ */
+
+/**
+ * @brief Draws a string from the cache, rendering it on a miss
+ *
+ * @param display The X11 display
+ * @param window Window to draw on
+ * @param font Font to draw with
+ * @param text Characters to draw, need not be terminated
+ * @param len Number of characters of text to draw
+ * @param x Left of the text
+ * @param y Top of the text, the baseline is font->ascent below it
+ * @param colour Pixel value to draw the text in
+ * @param shadow True to put a black copy 2 pixels down and right under it
+ * @return True if drawn, False if the string cannot be cached
+ */
+int DrawCachedText(Display *display, Window window, XFontStruct *font,
+	char *text, int len, int x, int y, int colour, int shadow);
+
+/**
+ * @brief Returns how often DrawCachedText() found its string in the cache
+ *
+ * @param hits Returns the number of draws from a cached pixmap
+ * @param misses Returns the number of draws that had to render the text
+ */
+void GetTextCacheStats(long *hits, long *misses);
+
+/**
+ * @brief Frees every cached pixmap, before the fonts are unloaded
+ *
+ * @param display The X11 display
+ */
+void FreeTextCache(Display *display);
+
+#endif
@@ -84,6 +84,15 @@
 #include "misc.h"
 #include "dialogue.h"
 #include "eyedude.h"
+#include "rng.h"
+#include "replay.h"
+#include "atlas.h"
+#include "hud.h"
+#include "pack.h"
+#include "loader.h"
+#include "assets.h"
+#include "textcache.h"
+#include "pacer.h"
 #include "../patchlevel.h"
 
 #include "init.h"
@@ -349,6 +358,13 @@ void ShutDown(Display *display, int exit_code, char *message)
 {
 	/* This is the last function called when exiting */
 
+	/* Finish off any game being recorded */
+	EndReplay(frame);
+
+	/* With -debug print the frame time histograms and sound counts */
+	ReportPaceStats();
+	ReportSoundStats();
+
 	/* Remove the colour map */
 	if (colormap) XUninstallColormap(display, colormap);
 
@@ -356,12 +372,9 @@ void ShutDown(Display *display, int exit_code, char *message)
 	if (noSound == False)
 		(void) FreeAudioSystem();
 
-	FreeKeyControl(display);		/* Free key control         */
+	FreeAllAssets(display);			/* Free loaded mode assets  */
 	FreeKeyEditControl(display);	/* Free key edit control    */
-	FreeSomePresents(display);		/* Free some from presents  */
-	FreeHighScore(display);			/* Free high score memory 	*/
 	FreeBonus(display);				/* Free bonus memory 		*/
-	FreeIntroduction(display);		/* Free introduction memory */
 	FreeMessageSystem(display);		/* Free message system 		*/
 	FreePaddle(display);			/* Free paddle pixmaps 		*/
 	FreeLevelInfo(display);			/* Free level pixmaps 		*/
@@ -369,8 +382,12 @@ void ShutDown(Display *display, int exit_code, char *message)
 	FreeBlockPixmaps(display);		/* Free all block pixmaps 	*/
 	FreeBall(display);				/* Free the ball animation 	*/
 	FreeBullet(display);			/* Free the bullet          */
-	FreeDialoguePixmaps(display);	/* Free dialogue pixmaps    */
 	FreeEyeDudes(display);			/* Free eye dudes pixmaps   */
+	FreeHud();						/* Free the HUD panels      */
+	FreeSfx();						/* Free the effect shaders  */
+	FreeTextCache(display);			/* Free cached text pixmaps */
+	FreeAtlas();					/* Free the sprite atlas    */
+	CloseAssetPack();				/* Unmap the asset pack     */
 	ReleaseGraphics(display);		/* Free graphics contexts 	*/
 	ReleaseFonts(display);			/* Unload fonts used		*/
 
@@ -466,12 +483,13 @@ static void PrintUsage(void)
     fprintf(stdout, "%s%s",
 		"Usage: XBoing [-version] [-usage] [-help] [-sync] ",
 		"[-display <displayName>]\n"); 
-    fprintf(stdout, "%s%s\n%s%s\n%s\n",
+    fprintf(stdout, "%s%s\n%s%s\n%s\n%s\n",
 		"              [-speed <1-9>] [-scores] [-keys] [-sound] [-setup]",
 		" [-nosfx]",
 		"              [-grab] [-maxvol <1-100>] [-startlevel <1-MAX>]",
 		" [-usedefcmap]",
-		"              [-nickname <name>] [-noicon]");
+		"              [-nickname <name>] [-noicon] [-sweep] [-seed <n>]",
+		"              [-record <file>] [-replay <file>]");
 
 	/* Exit now */
 	ExitProgramNow(0);
@@ -539,7 +557,7 @@ static void PrintHelp(void)
 		VERSION, REVNUM + buildNum, c_string);
 
     fprintf(stdout, "Help: \n");
-    fprintf(stdout, "%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s",
+    fprintf(stdout, "%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s",
         "    -speed <n>              - The game speed, 1 - 9. 9 = fast\n",
         "    -maxvol <n>             - The maximum volume out of 100%.\n",
         "    -startlevel <n>         - The starting level for game.\n",
@@ -556,6 +574,10 @@ static void PrintHelp(void)
         "    -usedefcmap             - Use the default colourmap.\n",
 		"    -nickname <name>        - Use nickname instead of real name.\n",
         "    -noicon                 - Do not create a custom icon.\n",
+        "    -sweep                  - Use swept ball collision detection.\n",
+        "    -seed <n>               - Seed the game random numbers.\n",
+        "    -record <file>          - Record the next game to a file.\n",
+        "    -replay <file>          - Play back a recorded game.\n",
         "    -display <display>      - Set the display for the game.\n");
 
 	/* Exit now */
@@ -648,6 +670,9 @@ static void ParseCommandLine(char **argv, int argc)
 	/* Initialise variables */
 	InitialiseSettings();
 
+	/* A new game every run unless -seed says otherwise */
+	SeedGameRandom((unsigned long) time(NULL));
+
 	for (i = 1; i < argc; i++)
 	{
 		if (argv[i][0] != '-')
@@ -712,6 +737,13 @@ static void ParseCommandLine(char **argv, int argc)
 
 			DEBUG("Keyboard mode activated.")
 
+		} else if (!compareArgument(argv[i], "-sweep", 5))
+		{
+			/* Find ball hits exactly instead of stepping the ball */
+			SetBallCollisionMode(COLLIDE_SWEPT);
+
+			DEBUG("Swept ball collision activated.")
+
 		} else if (!compareArgument(argv[i], "-scores", 6))
 		{
 			/* List all the highscores */
@@ -798,6 +830,34 @@ static void ParseCommandLine(char **argv, int argc)
 				}
 			} else PrintUsage();
 
+		} else if (!compareArgument(argv[i], "-seed", 5))
+		{
+			/* Start the game random streams from a known seed */
+			i++;
+			if (i < argc)
+				SeedGameRandom(strtoul(argv[i], NULL, 10));
+			else PrintUsage();
+
+		} else if (!compareArgument(argv[i], "-record", 7))
+		{
+			/* Record the input of the next game played */
+			i++;
+			if (i < argc)
+			{
+				if (StartReplayRecord(argv[i]) == False)
+					PrintUsage();
+			} else PrintUsage();
+
+		} else if (!compareArgument(argv[i], "-replay", 7))
+		{
+			/* Play a recorded game back instead of the introduction */
+			i++;
+			if (i < argc)
+			{
+				if (StartReplayPlayback(argv[i]) == False)
+					PrintUsage();
+			} else PrintUsage();
+
 		} else if (!compareArgument(argv[i], "-maxvol", 6))
 		{
 			/* Set the maximum volume to use for the game */
@@ -926,6 +986,9 @@ Display *InitialiseGame(char **argv, int argc)
 	static Display *display;
 	char str[80];
 
+	/* Time to the first frame is measured from here */
+	StartLoadClock();
+
 	/* Setup the default speed for game */
 	SetUserSpeed(5);
 
@@ -937,6 +1000,20 @@ Display *InitialiseGame(char **argv, int argc)
 
 	DEBUG("Command line parsed.")
 
+	/* 
+	 * Map the asset pack in if there is one, else assets come from files.
+	 * Done before the audio child is forked so it shares the mapping.
+	 */
+	if (OpenAssetPack() == True)
+		DEBUG("Mapped the asset pack.")
+
+	/* Decode the images on the loader threads while the display is set up */
+	QueueAtlasImages();
+	QueueBackgroundImages();
+	StartImageDecode();
+
+	DEBUG("Started decoding images.")
+
 	/* Open a display connection */
 	if (!(display = XOpenDisplay(displayName)))
 	{
@@ -959,7 +1036,7 @@ Display *InitialiseGame(char **argv, int argc)
 	if (!debug)
 		signal(SIGSEGV, gameCoreDump);
 
-	/* Seed the random number generator */
+	/* Seed rand() for the screen effects, the game uses its own streams */
 	srand(time(NULL));
 
 	/* Obtain the screen number for this display */
@@ -1026,6 +1103,14 @@ Display *InitialiseGame(char **argv, int argc)
 
 	DEBUG("Created GC and fonts.")
 
+	/* Pack every sprite into the atlas before anything looks one up */
+	if (InitialiseAtlas() == False)
+		ShutDown(display, 1, "Cannot create the sprite atlas.");
+
+	DEBUG("Created sprite atlas.")
+
+	InitialiseHud();
+
 	SetBackgrounds(display, colormap);
 
 	DEBUG("Created background pixmaps.")
@@ -1045,21 +1130,23 @@ Display *InitialiseGame(char **argv, int argc)
 	DEBUG("InitialiseLevelInfo done.")
 	InitialisePaddle(display, 			playWindow, 	colormap);
 	DEBUG("InitialisePaddle done.")
-	InitialiseDialoguePixmaps(display,	inputWindow,	colormap);
-	DEBUG("InitialiseDialoguePixmaps done.")
 	InitialiseEyeDudes(display,			playWindow,		colormap);
 	DEBUG("InitialiseEyedudes done.")
 
-	SetUpPresents(display, 				mainWindow, 	colormap);
-	DEBUG("SetUpPresents done.")
-	SetUpKeys(display, 					playWindow, 	colormap);
-	DEBUG("SetUpKeys done.")
+	/* Mode art is loaded on first entry to a mode that draws it */
+	InitialiseAssets(display, 										colormap);
+	DEBUG("InitialiseAssets done.")
+
+	ResetPresents();
+	DEBUG("ResetPresents done.")
+	ResetKeys();
+	DEBUG("ResetKeys done.")
 	SetUpKeysEdit(display, 				playWindow, 	colormap);
 	DEBUG("SetUpKeysEdit done.")
 	ResetInstructions();// [DEOXYGEN] changed from SetUpInstructions
 	DEBUG("ResetInstructions done.")
-	SetUpIntroduction(display, 			playWindow, 	colormap);
-	DEBUG("SetUpIntroduction done.")
+	ResetIntroduction();
+	DEBUG("ResetIntroduction done.")
 	SetUpBonus(display, 				mainWindow, 	colormap);
 	DEBUG("SetUpBonus done.")
 	SetUpHighScore(display, 			playWindow, 	colormap);
@@ -269,7 +269,7 @@ static void DoFinish(Display *display, Window window)
 	mode = MODE_DEMO;
 
     if (noSound == False)
-		playSoundFile("shark", 50);
+		playSound(SND_SHARK, 50);
 }
 
 /**
@@ -297,7 +297,7 @@ void Instructions(Display *display, Window window)
 			if (getSpecialEffects(display) == True)
 			{
 				DoText(display, bufferWindow);
-				while (WindowShatterEffect(display, window));
+				changeSfxMode(SFX_SHATTER);
 			}
 			else
 				DoText(display, window);
@@ -129,7 +129,19 @@ void SetUpIntroduction(Display *display, Window window, Colormap colormap)
 		&bigtitlePixmap, &bigtitlePixmapM, &attributes);
 	HandleXPMError(display, XpmErrorStatus, "InitialiseIntro()");
 
-    /* Create the stars for the letter shine */
+    /* Free the xpm pixmap attributes */
+	XpmFreeAttributes(&attributes);
+}
+
+void SetUpSparkles(Display *display, Window window, Colormap colormap)
+{
+	XpmAttributes   attributes;
+	int             XpmErrorStatus;
+
+    attributes.valuemask = XpmColormap;
+	attributes.colormap = colormap;
+
+    /* Create the stars for the letter shine - most attract screens use them */
 	XpmErrorStatus = XpmCreatePixmapFromData(display, window, star1_xpm,
 		&stars[0], &starsM[0], &attributes);
 	HandleXPMError(display, XpmErrorStatus, "InitialiseIntro(star1)");
@@ -176,8 +188,6 @@ void SetUpIntroduction(Display *display, Window window, Colormap colormap)
 
     /* Free the xpm pixmap attributes */
 	XpmFreeAttributes(&attributes);
-
-	ResetIntroduction();
 }
 
 void DrawIntroTitle(Display *display, Window window, int x, int y)
@@ -376,7 +386,7 @@ static void DoFinish(Display *display, Window window)
 	mode = MODE_INSTRUCT;
 
 	if (noSound == False)
-		playSoundFile("whoosh", 50);
+		playSound(SND_WHOOSH, 50);
 }
 
 
@@ -407,7 +417,12 @@ void Introduction(Display *display, Window window)
 
 		case INTRO_BLOCKS:
 			if (getSpecialEffects(display) == True && !firstTime)
+			{
+				/* The blocks are sprites so they go in the effect buffer */
+				BeginSfxBuffer();
 				DoBlocks(display, bufferWindow);
+				EndSfxBuffer();
+			}
 			else
 				DoBlocks(display, window);
 			IntroState = INTRO_TEXT;
@@ -417,7 +432,7 @@ void Introduction(Display *display, Window window)
 			if (getSpecialEffects(display) == True && !firstTime)
 			{
 				DoText(display, bufferWindow);
-				while (WindowShatterEffect(display, window));
+				changeSfxMode(SFX_SHATTER);
 			}
 			else
 				DoText(display, window);
@@ -454,17 +469,20 @@ void RedrawIntroduction(Display *display, Window window)
 }
 
 void FreeIntroduction(Display *display)
+{
+    if (bigtitlePixmap)		XFreePixmap(display, bigtitlePixmap);         
+	if (bigtitlePixmapM)	XFreePixmap(display, bigtitlePixmapM);
+}
+
+void FreeSparkles(Display *display)
 {
 	int i;
 
-	for (i = 0; i < 10; i++)
+	for (i = 0; i < 11; i++)
 	{
     	if (stars[i])	XFreePixmap(display, stars[i]);         
     	if (starsM[i])	XFreePixmap(display, starsM[i]);         
 	}
-
-    if (bigtitlePixmap)		XFreePixmap(display, bigtitlePixmap);         
-	if (bigtitlePixmapM)	XFreePixmap(display, bigtitlePixmapM);
 }
 
 void ResetIntroduction(void)
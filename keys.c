@@ -136,8 +136,6 @@ void SetUpKeys(Display *display, Window window, Colormap colormap)
 
     // Free the xpm pixmap attributes
 	XpmFreeAttributes(&attributes);
-
-	ResetKeys();
 }
 
 static void DoText(Display *display, Window window)
@@ -315,7 +313,7 @@ static void DoFinish(Display *display, Window window)
 	ResetKeysEdit();
 	mode = MODE_KEYSEDIT;
 
-    if (noSound == False) playSoundFile("boing", 50);
+    if (noSound == False) playSound(SND_BOING, 50);
 }
 
 
@@ -335,7 +333,7 @@ void Keys(Display *display, Window window)
 			if (getSpecialEffects(display) == True)
 			{
 				DoText(display, bufferWindow);
-				while (WindowShatterEffect(display, window));
+				changeSfxMode(SFX_SHATTER);
 			}
 			else
 				DoText(display, window);
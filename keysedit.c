@@ -260,7 +260,7 @@ static void DoFinish(Display *display, Window window)
 		toggle = GLOBAL;
 
     if (noSound == False)
-		playSoundFile("warp", 50);
+		playSound(SND_WARP, 50);
 }
 
 
@@ -280,7 +280,7 @@ void KeysEdit(Display *display, Window window)
 			if (getSpecialEffects(display) == True)
 			{
 				DoText(display, bufferWindow);
-				while (WindowShatterEffect(display, window));
+				changeSfxMode(SFX_SHATTER);
 			}
 			else
 				DoText(display, window);
@@ -50,6 +50,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stddef.h>
+#include <string.h>
 #include <time.h>
 #include <assert.h>
 //#include <X11/Xlib.h>	//Replace with RAyLib
@@ -63,7 +64,9 @@
 *
 */
 
+#ifndef HEADLESS
 #include "bitmaps/balls/life.xpm"
+#endif
 
 #include "error.h"
 #include "audio.h"
@@ -84,6 +87,9 @@
 #include "mess.h"
 #include "misc.h"
 #include "file.h"
+#include "simclock.h"
+#include "replay.h"
+#include "hud.h"
 
 #include "level.h"
 
@@ -109,8 +115,6 @@
  *  Internal type declarations:
  */
 
-static void DrawLevelTimeBonus(Display *display, Window window, int timebonus);
-
 /*
  *  Internal variable declarations:
  */
@@ -131,6 +135,7 @@ static int 	timeBonus;
 * @todo: Replace below function prototype to remove the #if #else
 *
 */
+#ifndef HEADLESS
 void InitialiseLevelInfo(Display *display, Window window, Colormap colormap)
 {
 	XpmAttributes   attributes;
@@ -147,6 +152,7 @@ void InitialiseLevelInfo(Display *display, Window window, Colormap colormap)
 	/* Free the xpm pixmap attributes */
 	XpmFreeAttributes(&attributes);
 }
+#endif
 
 /** 
 *
@@ -161,13 +167,13 @@ void DecLevelTimeBonus(Display *display, Window window)
 		timeBonus--;	
 
 		/* Draw the time bonus */
-		DrawLevelTimeBonus(display, window, timeBonus);
+		SetHudTime(timeBonus);
 
 		/* Is the time run out */
 		if (timeBonus == 0)
 		{
 			/* Times up buzzer sound */
-			if (noSound == False) playSoundFile("buzzer", 70); //C Bool Lib
+			if (noSound == False) playSound(SND_BUZZER, 70); //C Bool Lib
 		}
 	}
 }
@@ -206,8 +212,8 @@ void SetLevelTimeBonus(Display *display, Window window, int seconds)
 	/* Reset the time bonus to desired time */
 	timeBonus = seconds;	
 
-	/* Draw the time bonus */
-	DrawLevelTimeBonus(display, window, timeBonus);
+	/* Show the time bonus, drawn at the end of the frame */
+	SetHudTime(timeBonus);
 }
 
 /** 
@@ -215,8 +221,7 @@ void SetLevelTimeBonus(Display *display, Window window, int seconds)
 * @todo: Replace below function prototype to remove the #if #else
 *
 */
-
-static void DrawLevelTimeBonus(Display *display, Window window, int timebonus)
+void DrawLevelTimeBonus(Display *display, Window window, int timebonus)
 {
 	int len, minutes, seconds;
 	char str[10];
@@ -257,21 +262,18 @@ void DrawLife(Display *display, Window window, int x, int y)
 void DisplayLevelNumber(Display *display, Window window, u_long level)
 {
 	/* Put the level number up */
-	DrawOutNumber(display, levelWindow, level, 260, 5);
+	SetHudLevel(level);
 }
 
 void DisplayLevelInfo(Display *display, Window window, u_long level)
 {
-	int i;
-
-	/* Clear the window for level information */
+	/* Clear the ammo belt - the number and lives are in the HUD layer */
 	XClearWindow(display, levelWindow);
 
 	DisplayLevelNumber(display, levelWindow, level);
 
-	/* Draw out the lives left pixmaps - only MAX_LIVES will be displayed */
-	for (i = 0; i < MIN(livesLeft, MAX_LIVES); i++)
-		DrawLife(display, window, 175 - (i * 30), 21);
+	/* Show the lives left - only MAX_LIVES will be displayed */
+	SetHudLives(MIN(livesLeft, MAX_LIVES));
 
 	/* Draw the score in the score window */
 	DisplayScore(display, scoreWindow, score);
@@ -501,14 +503,17 @@ void CheckAndAddExtraLife(Display *display, long score)
 */
 void HandleGameTimer(Display *display, Window window)
 {
-	static time_t oldTime = 0;
+	static float elapsed = 0.0;
+
+	/* Count game time in ticks, not wall time, so replays see the same */
+	elapsed += SimTickSeconds();
 
 	/* Time to decrement the timer */
-	if (time(NULL) > oldTime)
+	if (elapsed >= 1.0)
 	{
 		/* Decrement the timer bonus */
 		DecLevelTimeBonus(display, timeWindow);
-		oldTime = time(NULL);
+		elapsed -= 1.0;
 	}
 }
 
@@ -539,7 +544,7 @@ void CheckGameRules(Display *display, Window window)
 		DrawSpecials(display);
 
 		/* Give the play a big head with some applause */
-		if (noSound == False) playSoundFile("applause", 70);
+		if (noSound == False) playSound(SND_APPLAUSE, 70);
 
 		/* Finished level now so set up bonus screen */
         mode = MODE_BONUS;
@@ -569,7 +574,7 @@ void UpdateHighScores(Display *display)
 	/* If the user is the new boing master */
 	if (GetHighScoreRanking(score) == 1)
 	{
-		if (noSound == False) playSoundFile("youagod", 99); //C Bool Lib
+		if (noSound == False) playSound(SND_YOUAGOD, 99); //C Bool Lib
 
 		/* Ask them for some words of wisdom */
 		strcpy(message, UserInputDialogueMessage(display,
@@ -599,7 +604,7 @@ void EndTheGame(Display *display, Window window)
 	/* Game over man! */
 	SetCurrentMessage(display, messWindow, "- Game Over - ", True);		//C Bool Lib
 
-	if (noSound == False) playSoundFile("game_over", 99);	//C Bool Lib
+	if (noSound == False) playSound(SND_GAME_OVER, 99);	//C Bool Lib
 
 	TurnSpecialsOff(display);
 
@@ -608,6 +613,9 @@ void EndTheGame(Display *display, Window window)
 	/* redraw the level info */
 	DisplayLevelInfo(display, levelWindow, level);
 
+	/* Any recording stops with the game */
+	EndReplay(frame);
+
 	/* Reset game and setup for high score table */
 	gameActive = False;								//C Bool Lib
 	SetLevelNumber(GetStartingLevel());
@@ -625,7 +633,7 @@ void EndTheGame(Display *display, Window window)
 */
 void DeadBall(Display *display, Window window)
 {
-	if (noSound == False) playSoundFile("balllost", 99);  //C Bool Lib
+	if (noSound == False) playSound(SND_BALLLOST, 99);  //C Bool Lib
 
 	/* More than one ball on screen - 1 died */
 	SetCurrentMessage(display, messWindow, "Another one bites the dust!", True);		//C Bool Lib
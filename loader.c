@@ -0,0 +1,313 @@
+/*
+ * XBoing - An X11 blockout style computer game
+ *
+ * (c) Copyright 1993, 1994, 1995, Justin C. Kibell, All Rights Reserved
+ *
+ * The X Consortium, and any party obtaining a copy of these files from
+ * the X Consortium, directly or indirectly, is granted, free of charge, a
+ * full and unrestricted irrevocable, world-wide, paid up, royalty-free,
+ * nonexclusive right and license to deal in this software and
+ * documentation files (the "Software"), including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons who receive
+ * copies from any such party to do so.  This license includes without
+ * limitation a license to do the foregoing actions under any patents of
+ * the party supplying this software to the X Consortium.
+ *
+ * In no event shall the author be liable to any party for direct, indirect,
+ * special, incidental, or consequential damages arising out of the use of
+ * this software and its documentation, even if the author has been advised
+ * of the possibility of such damage.
+ *
+ * The author specifically disclaims any warranties, including, but not limited
+ * to, the implied warranties of merchantability and fitness for a particular
+ * purpose.  The software provided hereunder is on an "AS IS" basis, and the
+ * author has no obligation to provide maintenance, support, updates,
+ * enhancements, or modifications.
+ */
+
+/*
+ * =========================================================================
+ *
+ * Start up image loading - see include/loader.h.
+ *
+ * The workers take the next queued image under jobLock and decode it with
+ * nothing else shared, so the only lock is the one handing out the jobs.
+ *
+ * =========================================================================
+ */
+
+/*
+ *  Include file dependencies:
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/time.h>
+#include <raylib.h>
+
+#include "include/faketypes.h"
+#include "include/error.h"
+#include "include/init.h"
+#include "include/pack.h"
+
+#include "include/loader.h"
+
+/*
+ *  Internal macro definitions:
+ */
+
+#define DECODE_IDLE		0
+#define DECODE_RUNNING	1
+#define DECODE_DONE		2
+
+/*
+ *  Internal type declarations:
+ */
+
+typedef struct
+{
+	char 	*module;
+	char 	path[256];
+	Image 	*image;
+	double 	seconds;
+} loadJob;
+
+typedef struct
+{
+	char 	*module;
+	int 	images;
+	double 	decode;
+	double 	upload;
+} loadTiming;
+
+static double 		GetLoadSeconds(void);
+static loadTiming 	*GetLoadTiming(char *module);
+static void 		DecodeJob(loadJob *job);
+static void 		*DecodeWorker(void *arg);
+
+/*
+ *  Internal variable declarations:
+ */
+
+static loadJob 			jobs[LOADER_MAX_IMAGES];
+static int 				numJobs = 0, nextJob = 0;
+static pthread_mutex_t 	jobLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_t 		workers[LOADER_MAX_THREADS];
+static int 				numWorkers = 0, decodeThreads = 0;
+static int 				decodeState = DECODE_IDLE;
+
+static loadTiming 		timings[LOADER_MAX_MODULES];
+static int 				numTimings = 0;
+static loadTiming 		*uploading = NULL;
+static double 			startTime = 0.0, uploadStart, decodeStart, decodeWall;
+static int 				reported = False;
+
+
+static double GetLoadSeconds(void)
+{
+	struct timeval tv;
+
+	gettimeofday(&tv, NULL);
+	return (double) tv.tv_sec + (double) tv.tv_usec / 1000000.0;
+}
+
+
+/**
+ * Finds the timings for a module, adding it the first time it is seen.
+ *
+ */
+static loadTiming *GetLoadTiming(char *module)
+{
+	int i;
+
+	for (i = 0; i < numTimings; i++)
+		if (!strcmp(timings[i].module, module))
+			return &timings[i];
+
+	/* Out of slots - lump the rest in with the last one */
+	if (numTimings == LOADER_MAX_MODULES)
+		return &timings[numTimings - 1];
+
+	timings[numTimings].module = module;
+	return &timings[numTimings++];
+}
+
+
+static void DecodeJob(loadJob *job)
+{
+	double t0 = GetLoadSeconds();
+
+	*job->image 	= LoadPackedImage(job->path);
+	job->seconds 	= GetLoadSeconds() - t0;
+}
+
+
+/**
+ * Worker thread - decodes queued images until there are none left.
+ *
+ */
+static void *DecodeWorker(void *arg)
+{
+	int i;
+
+	while (True)
+	{
+		pthread_mutex_lock(&jobLock);
+		i = nextJob++;
+		pthread_mutex_unlock(&jobLock);
+
+		if (i >= numJobs)
+			break;
+
+		DecodeJob(&jobs[i]);
+	}
+
+	return NULL;
+}
+
+
+void StartLoadClock(void)
+{
+	startTime = GetLoadSeconds();
+}
+
+
+void QueueImage(char *module, char *path, Image *image)
+{
+	loadTiming *timing;
+	loadJob job;
+
+	job.module 	= module;
+	job.image 	= image;
+	job.seconds = 0.0;
+	snprintf(job.path, sizeof(job.path), "%s", path);
+
+	if (decodeState == DECODE_IDLE && numJobs < LOADER_MAX_IMAGES)
+	{
+		/* Timed in FinishImageDecode() once the workers are done */
+		jobs[numJobs++] = job;
+		return;
+	}
+
+	/* Too late or too many for the pool so decode it here and now */
+	DecodeJob(&job);
+
+	timing = GetLoadTiming(module);
+	timing->decode += job.seconds;
+	timing->images++;
+}
+
+
+void StartImageDecode(void)
+{
+	long cpus;
+
+	if (decodeState != DECODE_IDLE)
+		return;
+
+	decodeStart = GetLoadSeconds();
+	decodeState = DECODE_RUNNING;
+
+	if ((cpus = sysconf(_SC_NPROCESSORS_ONLN)) < 1)
+		cpus = 1;
+	if (cpus > LOADER_MAX_THREADS)
+		cpus = LOADER_MAX_THREADS;
+	if (cpus > numJobs)
+		cpus = numJobs;
+
+	for (numWorkers = 0; numWorkers < cpus; numWorkers++)
+		if (pthread_create(&workers[numWorkers], NULL, DecodeWorker, NULL))
+			break;
+
+	decodeThreads = numWorkers;
+
+	/* No threads to be had so the main thread does the lot */
+	if (numWorkers == 0)
+	{
+		DecodeWorker(NULL);
+		decodeThreads = 1;
+	}
+}
+
+
+void FinishImageDecode(void)
+{
+	loadTiming *timing;
+	int i;
+
+	if (decodeState == DECODE_DONE)
+		return;
+
+	if (decodeState == DECODE_IDLE)
+		StartImageDecode();
+
+	for (i = 0; i < numWorkers; i++)
+		pthread_join(workers[i], NULL);
+
+	decodeWall 	= GetLoadSeconds() - decodeStart;
+	decodeState = DECODE_DONE;
+	numWorkers 	= 0;
+
+	for (i = 0; i < numJobs; i++)
+	{
+		timing = GetLoadTiming(jobs[i].module);
+		timing->decode += jobs[i].seconds;
+		timing->images++;
+	}
+}
+
+
+void BeginLoadTiming(char *module)
+{
+	uploading 	= GetLoadTiming(module);
+	uploadStart = GetLoadSeconds();
+}
+
+
+void EndLoadTiming(void)
+{
+	if (uploading != NULL)
+		uploading->upload += GetLoadSeconds() - uploadStart;
+
+	uploading = NULL;
+}
+
+
+void ReportLoadTimes(void)
+{
+	char str[120];
+	int i;
+
+	if (reported == True)
+		return;
+
+	reported = True;
+
+	if (debug == False)
+		return;
+
+	/* Decode is summed over the workers so it can add up to more than wall */
+	sprintf(str, "%-12s %6s %10s %10s", "module", "images", "decode ms", 
+		"upload ms");
+	NormalMessage(str);
+
+	for (i = 0; i < numTimings; i++)
+	{
+		sprintf(str, "%-12s %6d %10.1f %10.1f", timings[i].module, 
+			timings[i].images, timings[i].decode * 1000.0, 
+			timings[i].upload * 1000.0);
+		NormalMessage(str);
+	}
+
+	sprintf(str, "Decoded %d images on %d threads in %.1f ms.", numJobs,
+		decodeThreads, decodeWall * 1000.0);
+	NormalMessage(str);
+
+	sprintf(str, "First frame after %.1f ms.", 
+		(GetLoadSeconds() - startTime) * 1000.0);
+	NormalMessage(str);
+}
@@ -50,10 +50,14 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stddef.h>
+#include <stdbool.h>
+#include <time.h>
+#ifndef HEADLESS
 #include <X11/Xlib.h>
 #include <X11/Xutil.h>
 #include <X11/Xos.h>
 #include <X11/keysym.h>
+#endif
 
 #include "score.h"
 #include "presents.h"
@@ -82,9 +86,23 @@
 #include "dialogue.h"
 #include "error.h"
 #include "eyedude.h"
+#include "simclock.h"
+#include "rng.h"
+#include "replay.h"
+#include "hud.h"
+#ifndef HEADLESS
+#include "pacer.h"
+#include "snapshot.h"
+#include "loader.h"
+#include "assets.h"
+#endif
 
 #include "main.h"
 
+#ifdef HEADLESS
+#include "headless.h"
+#endif
+
 /*
  *  Internal macro definitions:
  */
@@ -93,16 +111,23 @@
  *  Internal type declarations:
  */
 
+#ifndef HEADLESS
 static KeySym 	GetKeySym(XEvent event);
-static void 	handleGameMode(Display *display);
 static void 	handleEventLoop(Display *display);
 static void 	ToggleGamePaused(Display *display);
 static void 	SetGamePaused(Display *display);
 static void 	handleGameStates(Display *display);
+static void 	handleRenderPass(Display *display);
 static void 	handleMiscKeys(Display *display, KeySym keysym);
 static void 	handleSpeedKeys(Display *display, KeySym keysym);
 static void 	handleExitKeys(Display *display);
 static void 	handleQuitKeys(Display *display);
+#endif
+static void 	handleGameMode(Display *display);
+static void 	handleReplayInputs(Display *display);
+#ifdef HEADLESS
+static void 	handleSimKeys(Display *display, int keysym, int Pressed);
+#endif
 
 /*
  *  Internal variable declarations:
@@ -121,6 +146,7 @@ static int 		paddleControl;
 static time_t 	pauseStartTime;
 time_t 			pausedTime;
 int 			UserTilts;
+static int 		replayPaddleX = REPLAY_NO_PADDLE;
 
 
 int GetWarpSpeed(void)
@@ -138,6 +164,9 @@ void SetUserSpeed(int delay)
 	userDelay = delay;
 	speed = (long) (temp * userDelay);
 	speedLevel = 10 - delay;
+
+	/* The game speed is the length of one simulation tick */
+	SetSimTickLength(speed);
 }
 
 int GetPaddleControlMode(void)
@@ -160,8 +189,12 @@ void SetGameSpeed(int delay)
   long longuserDelay = (long) userDelay;
 	if (delay >= 0)
 		speed = (longDelay * longuserDelay);
+
+	/* The game speed is the length of one simulation tick */
+	SetSimTickLength(speed);
 }
 
+#ifndef HEADLESS
 static KeySym GetKeySym(XEvent event)
 {
 	int count;
@@ -174,6 +207,7 @@ static KeySym GetKeySym(XEvent event)
 
 	return keysym;
 }
+#endif
 
 int paddleIsMoving(void)
 {
@@ -184,7 +218,7 @@ int paddleIsMoving(void)
 void handlePaddleMoving(Display *display)
 {
 	int static oldx = 0;
-	int x, y;
+	int x, y, found;
 
 	if (paddleControl == CONTROL_KEYS)
 	{
@@ -205,7 +239,20 @@ void handlePaddleMoving(Display *display)
 		}
 	} else if (paddleControl == CONTROL_MOUSE)
 	{
-		if (ObtainMousePosition(display, playWindow, &x, &y))
+		/* A replay gives back the pointer positions it recorded */
+		if (GetReplayMode() == REPLAY_PLAY)
+		{
+			x = replayPaddleX;
+			found = (x != REPLAY_NO_PADDLE);
+		}
+		else
+		{
+			found = ObtainMousePosition(display, playWindow, &x, &y);
+			RecordReplayInput(frame, REPLAY_PADDLE_X, 
+				found ? x : REPLAY_NO_PADDLE);
+		}
+
+		if (found)
 		{
 			/* Has the pointer moved since our last poll */
 			if (x != oldx)
@@ -236,6 +283,7 @@ void handlePaddleMoving(Display *display)
 }
 
 
+#ifndef HEADLESS
 static void ToggleGamePaused(Display *display)
 {
 	if (mode == MODE_PAUSE)
@@ -286,6 +334,13 @@ void handleIconify(Display *display)
 
 void SelectiveRedraw(Display *display)
 {
+	/* Whatever the panels showed has been lost with the window contents */
+	InvalidateHud();
+	ForgetDrawnSnapshot();
+
+	/* An expose can come before the first frame of a new mode */
+	UseModeAssets(display, mode);
+
 	switch (mode)
 	{
 		case MODE_GAME:
@@ -336,6 +391,8 @@ void SelectiveRedraw(Display *display)
 	/* Redisplay the message and the level/score info */
 	RedrawLevelInfo(display, levelWindow);
 	DisplayCurrentMessage(display, messWindow);
+	DrawSpecials(display);
+	FlushHud(display);
 
 	/* To be sure - to be sure */
 	XFlush(display);
@@ -353,6 +410,10 @@ void handleExposure(Display *display, XEvent event)
 
 void handleMouseButtons(Display *display, XEvent event, int Down)
 {
+	/* Acted on before the next frame so record it against that one */
+	RecordReplayInput(frame + 1, Down == True ? 
+		REPLAY_BUTTON_DOWN : REPLAY_BUTTON_UP, (int) event.xbutton.button);
+
 	if (mode == MODE_EDIT)
 	{
 		/* Allow the editor window to have control over buttons */
@@ -398,7 +459,7 @@ static void handleControlKeys(Display *display)
 
 	/* Play a bit of sound */
 	if (noSound == False)
-		playSoundFile("toggle", 50);
+		playSound(SND_TOGGLE, 50);
 }
 
 static void handleSoundKey(Display *display)
@@ -431,6 +492,7 @@ static void handleSoundKey(Display *display)
 		}
 	}
 }
+#endif
 
 void SetTiltsZero(void)
 {
@@ -438,6 +500,7 @@ void SetTiltsZero(void)
 	UserTilts = 0;
 }
 
+#ifndef HEADLESS
 static void handleGameKeys(Display *display, KeySym keysym)
 {
 	int temp;
@@ -619,7 +682,7 @@ static void handleIntroKeys(Display *display, KeySym keysym)
 
 				/* Play a bit of sound */
 				if (noSound == False)
-					playSoundFile("toggle", 50);
+					playSound(SND_TOGGLE, 50);
 				
 			}
 			break;
@@ -636,7 +699,7 @@ static void handleIntroKeys(Display *display, KeySym keysym)
 
 				/* Play a bit of sound */
 				if (noSound == False)
-					playSoundFile("toggle", 50);
+					playSound(SND_TOGGLE, 50);
 			}
 			break;
 
@@ -701,6 +764,9 @@ static void handleQuitKeys(Display *display)
 		UpdateHighScores(display);
 	}
 
+	/* Any recording stops with the game */
+	EndReplay(frame);
+
 	/* Abort game and return to intros */
 	SetGameSpeed(FAST_SPEED);
 	ResetIntroduction();
@@ -716,7 +782,7 @@ static void handleExitKeys(Display *display)
 		UpdateHighScores(display);
 	}
 
-	if (noSound == False) playSoundFile("game_over", 100);
+	if (noSound == False) playSound(SND_GAME_OVER, 100);
 
 	/* Shut down and exit game */
 	ShutDown(display, 0, "Thank you for playing XBoing.");
@@ -749,55 +815,55 @@ static void handleSpeedKeys(Display *display, KeySym keysym)
 		case XK_1:	/* Set speed to speed 1 */
 			SetUserSpeed(9);
 			SetCurrentMessage(display, messWindow, "Warp 1 - Slow", True);
-			if (noSound == False) playSoundFile("tone", 10);
+			if (noSound == False) playSound(SND_TONE, 10);
 			break;
 
 		case XK_2:	/* Set speed to speed 2 */
 			SetUserSpeed(8);
 			SetCurrentMessage(display, messWindow, "Warp 2", True);
-			if (noSound == False) playSoundFile("tone", 20);
+			if (noSound == False) playSound(SND_TONE, 20);
 			break;
 
 		case XK_3:	/* Set speed to speed 3 */
 			SetUserSpeed(7);
 			SetCurrentMessage(display, messWindow, "Warp 3", True);
-			if (noSound == False) playSoundFile("tone", 30);
+			if (noSound == False) playSound(SND_TONE, 30);
 			break;
 
 		case XK_4:	/* Set speed to speed 4 */
 			SetUserSpeed(6);
 			SetCurrentMessage(display, messWindow, "Warp 4", True);
-			if (noSound == False) playSoundFile("tone", 40);
+			if (noSound == False) playSound(SND_TONE, 40);
 			break;
 
 		case XK_5:	/* Set speed to speed 5 */
 			SetUserSpeed(5);
 			SetCurrentMessage(display, messWindow, "Warp 5 - Medium", True);
-			if (noSound == False) playSoundFile("tone", 50);
+			if (noSound == False) playSound(SND_TONE, 50);
 			break;
 
 		case XK_6:	/* Set speed to speed 6 */
 			SetUserSpeed(4);
 			SetCurrentMessage(display, messWindow, "Warp 6", True);
-			if (noSound == False) playSoundFile("tone", 60);
+			if (noSound == False) playSound(SND_TONE, 60);
 			break;
 
 		case XK_7:	/* Set speed to speed 7 */
 			SetUserSpeed(3);
 			SetCurrentMessage(display, messWindow, "Warp 7", True);
-			if (noSound == False) playSoundFile("tone", 70);
+			if (noSound == False) playSound(SND_TONE, 70);
 			break;
 
 		case XK_8:	/* Set speed to speed 8 */
 			SetUserSpeed(2);
 			SetCurrentMessage(display, messWindow, "Warp 8", True);
-			if (noSound == False) playSoundFile("tone", 80);
+			if (noSound == False) playSound(SND_TONE, 80);
 			break;
 
 		case XK_9:	/* Set speed to speed 9 */
 			SetUserSpeed(1);
 			SetCurrentMessage(display, messWindow, "Warp 9 - Fast", True);
-			if (noSound == False) playSoundFile("tone", 90);
+			if (noSound == False) playSound(SND_TONE, 90);
 			break;
 
 		default: 	/* All other keys */
@@ -808,7 +874,8 @@ static void handleSpeedKeys(Display *display, KeySym keysym)
 static void handleMiscKeys(Display *display, KeySym keysym)
 {
 	int vol = 0;
-	char str[30];
+	char str[80];
+	paceStats stats;
 
 	/* Switch on the keysym */
 	switch (keysym)
@@ -850,6 +917,14 @@ static void handleMiscKeys(Display *display, KeySym keysym)
 			handleControlKeys(display);
 			break;
 
+		case XK_f: case XK_F:
+			/* Frame times over the last few seconds */
+			GetPaceStats(PACE_FRAME, &stats);
+			sprintf(str, "Frame %.1fms p95 %.1fms max %.1fms", 
+				stats.p50 / 1000.0, stats.p95 / 1000.0, stats.max / 1000.0);
+			SetCurrentMessage(display, messWindow, str, True);
+			break;
+
 		case XK_Q: case XK_q:
 			if (YesNoDialogue(display, "Exit XBoing you wimp? [y/n]"))
 				handleExitKeys(display);
@@ -862,6 +937,9 @@ static void handleMiscKeys(Display *display, KeySym keysym)
 
 void handleKeyPress(Display *display, KeySym keysym, XEvent event, int Pressed)
 {
+	/* Acted on before the next frame so record it against that one */
+	RecordReplayInput(frame + 1, Pressed == True ? 
+		REPLAY_KEY_DOWN : REPLAY_KEY_UP, (int) keysym);
 
 	if (Pressed == False)
 	{
@@ -900,6 +978,7 @@ void handleKeyPress(Display *display, KeySym keysym, XEvent event, int Pressed)
 		}
 	}
 }
+#endif
 
 
 static void handleGameMode(Display *display)
@@ -911,6 +990,9 @@ static void handleGameMode(Display *display)
 	/* If we are going to play then setup first level */
 	if (gameActive == False)
 	{
+		/* Start recording, or restore the recorded seed and settings */
+		BeginReplayGame(frame);
+
 		/* Choose a random velocity for the ball */
 
 		/* Always start at level 1 or level specified */
@@ -947,13 +1029,13 @@ static void handleGameMode(Display *display)
 
 		/* Add bonus coin block at random intervals */
 		if (nextBonusFrame == 0 && bonusBlock == False)
-			nextBonusFrame = frame + (rand() % BONUS_SEED);
+			nextBonusFrame = frame + (GameRandom(RNG_BONUS) % BONUS_SEED);
 
 		/* Do we need to add a bonus coin or special? */
 		if (nextBonusFrame <= frame && bonusBlock == False)
 		{
 			/* Add the bonus block now - different types */
-			switch (rand() % 27)
+			switch (GameRandom(RNG_BONUS) % 27)
 			{
 				case 0: case 1: 
 				case 2: case 3: 
@@ -1043,7 +1125,7 @@ static void handleGameMode(Display *display)
 					break;
 
 				case 25:	/* choose a type to dynamite */
-					switch (rand() % 7)
+					switch (GameRandom(RNG_BONUS) % 7)
 					{
 						case 0:	/* Dynamite the block */
 							SetExplodeAllType(display, playWindow, YELLOW_BLK);
@@ -1111,8 +1193,65 @@ static void handleGameMode(Display *display)
 		CheckGameRules(display, playWindow);
 }
 
+static void handleReplayInputs(Display *display)
+{
+#ifndef HEADLESS
+	static XEvent event;
+#endif
+	int type, value;
+
+	/* Hand over everything the player did before this frame */
+	while (NextReplayInput(frame, &type, &value) == True)
+	{
+		switch (type)
+		{
+			case REPLAY_PADDLE_X:
+				/* Picked up by handlePaddleMoving() */
+				replayPaddleX = value;
+				break;
+
+#ifndef HEADLESS
+			case REPLAY_KEY_DOWN: case REPLAY_KEY_UP:
+				handleKeyPress(display, (KeySym) value, event, 
+					type == REPLAY_KEY_DOWN);
+				break;
+
+			case REPLAY_BUTTON_DOWN: case REPLAY_BUTTON_UP:
+				event.xbutton.button = (unsigned int) value;
+				handleMouseButtons(display, event, 
+					type == REPLAY_BUTTON_DOWN);
+				break;
+#else
+			case REPLAY_KEY_DOWN: case REPLAY_KEY_UP:
+				handleSimKeys(display, value, type == REPLAY_KEY_DOWN);
+				break;
+
+			case REPLAY_BUTTON_DOWN:
+				/* Every button launches a ball or shoots */
+				if (mode == MODE_GAME)
+					if (ActivateWaitingBall(display, playWindow) == False)
+						shootBullet(display, playWindow);
+				break;
+#endif
+
+			case REPLAY_END:
+			default:
+				break;
+		}
+	}
+}
+
+#ifndef HEADLESS
 static void handleGameStates(Display *display)
 {
+	static int lastMode = MODE_NONE;
+
+	/* Load what this mode draws the first time it is entered */
+	UseModeAssets(display, mode);
+
+	/* Everything but the render pass counts as sim time in the frame stats */
+	BeginPaceTimer(PACE_SIM);
+
 	/* Update the message window if any new messages come along */
 	DisplayCurrentMessage(display, messWindow);
 
@@ -1203,14 +1342,43 @@ static void handleGameStates(Display *display)
 			break;
 	}
 
+	/* Coming from another screen the play area was cleared under them */
+	if ((mode == MODE_GAME || mode == MODE_EDIT) && lastMode != mode && 
+		lastMode != MODE_PAUSE && lastMode != MODE_DIALOGUE)
+		ForgetDrawnSnapshot();
+
+	lastMode = mode;
+
+	EndPaceTimer(PACE_SIM);
+}
+
+static void handleRenderPass(Display *display)
+{
+	BeginPaceTimer(PACE_RENDER);
+
+	if (mode == MODE_GAME || mode == MODE_EDIT)
+	{
+		/* Blocks first, only cells changed since the last pass are redrawn */
+		DrawBlockLayer(display, playWindow);
+
+		/* Then the balls, bullets, eye dude and paddle as they are now */
+		RenderSnapshot(display, playWindow);
+	}
+
+	/* Draw whatever the score, level and message panels were told */
+	FlushHud(display);
+
 	/* Flush the display */
 	XFlush(display);
+
+	EndPaceTimer(PACE_RENDER);
 }
 
 static void handleEventLoop(Display *display)
 {
 	XEvent event;
-	int pending;
+	int pending, ticks, t;
+	long nextTick;
 	KeySym keysym;
 
 	pending = frame = 0;
@@ -1218,6 +1386,14 @@ static void handleEventLoop(Display *display)
 	/* Initial mode for game is Introduction */
 	mode = MODE_PRESENTS;
 
+	/* A replay goes straight into the game, one frame before it began */
+	if (GetReplayMode() == REPLAY_PLAY)
+	{
+		frame 		= GetReplayStartFrame() - 1;
+		mode 		= MODE_GAME;
+		gameActive 	= False;
+	}
+
 	/* No special effects yet */
 	changeSfxMode(SFX_NONE);
 
@@ -1243,20 +1419,23 @@ static void handleEventLoop(Display *display)
 		/* handle and audio device events if supported */
 		audioDeviceEvents();
 
-		/* See if any events are waiting for me to handle */
-		if (iconified == False && mode != MODE_PAUSE)
+		/* See if any events are waiting for me to handle - a replay 
+		 * never waits as the recorded keys will end the pause.
+		 */
+		if (iconified == False && 
+			(mode != MODE_PAUSE || GetReplayMode() == REPLAY_PLAY))
 		{
 			/* Get an event but don't wait if none arrives */
 			pending = XPending(display);
-
-			if (mode != MODE_DIALOGUE)
-				frame++;
 		}
 		else
 		{
 			/* Wait here for an event and then get the number waiting */
 			XPeekEvent(display, &event);
 			pending = XPending(display);
+
+			/* Time spent paused or iconified is not game time */
+			ResetSimClock();
 		}
 		
 		/* Handle any events pending */
@@ -1287,11 +1466,14 @@ static void handleEventLoop(Display *display)
 					break;
 
 				case ButtonRelease:
-					handleMouseButtons(display, event, False);
+					/* A replay plays the recorded buttons instead */
+					if (GetReplayMode() != REPLAY_PLAY)
+						handleMouseButtons(display, event, False);
 					break;
 
 				case ButtonPress:
-					handleMouseButtons(display, event, True);
+					if (GetReplayMode() != REPLAY_PLAY)
+						handleMouseButtons(display, event, True);
 					break;
 
 				case MotionNotify:
@@ -1300,11 +1482,16 @@ static void handleEventLoop(Display *display)
 					break;
 
 				case KeyRelease:
+					/* A replay plays the recorded keys instead */
+					if (GetReplayMode() == REPLAY_PLAY)
+						break;
 					keysym = GetKeySym(event);
 					handleKeyPress(display, keysym, event, False);
 					break;
 
 				case KeyPress:
+					if (GetReplayMode() == REPLAY_PLAY)
+						break;
 					keysym = GetKeySym(event);
 					handleKeyPress(display, keysym, event, True);
 					break;
@@ -1321,13 +1508,45 @@ static void handleEventLoop(Display *display)
 			pending--;
 		}
 		
-		/* Sleep a bit if not iconified */
-		if (iconified == False)
-			sleepSync(display, speed);
-
-		/* handle all game states and animations */
 		if (iconified == False) 
-			handleGameStates(display);
+		{
+			/* 
+			 * Run one game frame for every whole tick of wall time that has
+			 * passed, so the game speed no longer depends on drawing speed.
+			 */
+			ticks = SimTicksDue();
+			BeginPacedFrame();
+
+			for (t = 0; t < ticks; t++)
+			{
+				if (mode != MODE_DIALOGUE)
+					frame++;
+
+				/* Recorded input due by this frame, if playing one back */
+				handleReplayInputs(display);
+
+				/* handle all game states and animations */
+				handleGameStates(display);
+			}
+
+			/* Start the sounds asked for since the last pass, once each */
+			FlushSounds();
+
+			/* 
+			 * Draw once for however many ticks ran, even none, as the
+			 * balls and paddle are drawn blended between the last two.
+			 */
+			handleRenderPass(display);
+			EndPacedFrame();
+
+			/* With -debug say how long start up took, once only */
+			ReportLoadTimes();
+
+			/* Give the CPU back until the next tick or frame is due */
+			nextTick = PaceNow() + SimTimeToNextTick();
+			PaceUntil(nextTick < PaceFrameDeadline() ? 
+				nextTick : PaceFrameDeadline());
+		}
 	}
 
 	/* NOT REACHED */
@@ -1341,6 +1560,7 @@ int main(int argc, char **argv)
 	display = InitialiseGame(argv, argc);
 
 	SetGameSpeed(FAST_SPEED);
+	InitSimClock(speed);
 	gameActive = False;
 	iconified = False;
 
@@ -1353,3 +1573,98 @@ int main(int argc, char **argv)
 
 	/* NOTREACHED */
 }
+
+#else
+
+/**
+ * Runs a single frame of the game core without any event handling, drawing
+ * or sleeping. Used by the headless simulator (sim.c).
+ *
+ * @param Display *display Unused in the headless build, may be NULL.
+ *
+ */
+void SimulateGameFrame(Display *display)
+{
+	/* Advance time and run exactly what handleGameStates() would in game */
+	frame++;
+	handleReplayInputs(display);
+
+	if (mode == MODE_GAME)
+		handleGameMode(display);
+
+	/* Nothing is heard but the batch still has to be emptied */
+	FlushSounds();
+}
+
+/**
+ * Acts on a recorded key the way handleGameKeys() would during a game.
+ * Only the keys that change the game are handled, the rest need windows
+ * or dialogues. Keys are X11 KeySym values, which are plain ASCII for the
+ * letters and digits.
+ *
+ * @param Display *display Unused in the headless build, may be NULL.
+ * @param int keysym The recorded KeySym.
+ * @param int Pressed True if the key went down, False if it came up.
+ *
+ */
+static void handleSimKeys(Display *display, int keysym, int Pressed)
+{
+	int temp;
+
+	if (Pressed == False)
+	{
+		/* key was released */
+		paddleMotion = 0;
+		return;
+	}
+
+	switch (keysym)
+	{
+		case 't': case 'T':
+			/* Obtain an active ball and tilt it */
+			if ((temp = GetAnActiveBall()) >= 0 && UserTilts < MAX_TILTS)
+			{
+				DoBoardTilt(display, temp);
+				UserTilts++;
+			}
+			break;
+
+		case 'd': case 'D':
+			/* Obtain an active ball - ie: not on paddle */
+			if ((temp = GetAnActiveBall()) >= 0)
+				ClearBallNow(display, playWindow, temp);
+			break;
+
+		case REPLAY_XK_LEFT: case 'j': case 'J':
+			/* Set paddle to move left */
+			paddleMotion = -1;
+			break;
+
+		case 'k': case 'K':
+			/* Shoot a bullet if available */
+			if (ActivateWaitingBall(display, playWindow) == False)
+				shootBullet(display, playWindow);
+			break;
+
+		case REPLAY_XK_RIGHT: case 'l': case 'L':
+			/* Set paddle to move right */
+			paddleMotion = 1;
+			break;
+
+		case 'p': case 'P':
+			/* Nothing to grab or redraw so just switch mode */
+			mode = (mode == MODE_PAUSE) ? MODE_GAME : MODE_PAUSE;
+			break;
+
+		case '1': case '2': case '3': case '4': case '5':
+		case '6': case '7': case '8': case '9':
+			/* Warp speed keys */
+			SetUserSpeed(10 - (keysym - '0'));
+			break;
+
+		default: 	/* All other keys */
+			break;
+	}
+}
+
+#endif
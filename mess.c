@@ -76,6 +76,7 @@
 #include "intro.h"
 #include "main.h"
 #include "misc.h"
+#include "hud.h"
 
 #include "mess.h"
 
@@ -218,10 +219,11 @@ void DisplayCurrentMessage(Display *display, Window window)
 	char str[80];
 	char str2[80];
 
+	/* The message panel is only drawn again if the text has changed */
 	if (newMessageStart == True)
 	{
 		newMessageStart = False;
-		DrawMessage(display, window, currentMessage, True, green);
+		SetHudMessage(currentMessage, green);
 	}
 
 	/* Clear the frame when it's time */
@@ -238,9 +240,6 @@ void DisplayCurrentMessage(Display *display, Window window)
 			SetCurrentMessage(display, window, str, False);
 		}
 		else
-			DrawMessage(display, window, "", False, green);
-
-		/* To be sure to be sure */
-		XFlush(display);
+			SetHudMessage("", green);
 	}
 }
@@ -67,6 +67,8 @@
 #include "error.h"
 #include "stage.h"
 #include "dialogue.h"
+#include "textcache.h"
+#include "pacer.h"
 
 #include "misc.h"
 
@@ -97,34 +99,18 @@ void usleep(unsigned long usec)
 #endif
 
 /**
- * @brief Stops program execution (usleep()) if needed to meet target framerate.
+ * @brief Waits for the server to catch up, then until ms have passed since the call
  * 
  * @param display The display of the current X11 window
- * @param ms The number of miliseconds to wait between each frame
+ * @param ms The number of miliseconds from the call to return after
  */
 void sleepSync(Display *display, unsigned long ms)
 {
-    struct timeval st, et;
-    long SyncTime;
-    static unsigned long accu;// Unitialized static variable could lead to ambiguous behavior on first function call
+	/* The deadline is fixed before the sync so its time is not added on */
+	long deadline = PaceNow() + (long) ms * 1000L;
 
-    gettimeofday(&st, NULL);
-    XSync(display, False);
-    gettimeofday(&et, NULL);
-
-    SyncTime = (((et.tv_sec - st.tv_sec) * 1000) +
-               ((et.tv_usec - st.tv_usec) / 1000) );
-
-/*    if ((ms) > ((1000 / 60) + SyncTime))
-        usleep(ms - SyncTime);
-*/
-    if ((ms + accu) > ((1000 / 30) + SyncTime)) 
-    {
-        usleep(ms +accu - SyncTime);
-        accu = 0;
-    }
-    else if (ms > SyncTime)
-       accu += (ms - SyncTime);
+	XSync(display, False);
+	PaceUntil(deadline);
 }
 
 /**
@@ -183,6 +169,11 @@ void DrawShadowCentredText(Display *display, Window window, XFontStruct *font,
 	/* Start drawing so the text is centered */
     x = (width / 2) - (plen / 2);
 
+	/* Static text is drawn from the cache with its shadow in one go */
+	if (DrawCachedText(display, window, font, string, len, x, y, colour, 
+		True) == True)
+		return;
+
 	/* Draw the text with a shadow */
     DrawText(display, window, x+2, y + 2, font, black, string, -1);
     DrawText(display, window, x, y, font, colour, string, -1);
@@ -207,6 +198,11 @@ void DrawShadowText(Display *display, Window window, XFontStruct *font,
 	/* String length */
     len = strlen(string);
 
+	/* Static text is drawn from the cache with its shadow in one go */
+	if (DrawCachedText(display, window, font, string, len, x, y, colour, 
+		True) == True)
+		return;
+
 	/* Draw the text with a shadow */
     DrawText(display, window, x+2, y + 2, font, black, string, -1);
     DrawText(display, window, x, y, font, colour, string, -1);
@@ -233,6 +229,11 @@ void DrawTextFast(Display *display, Window window, int x, int y, XFontStruct *fo
 	if (numChar > 0) 
 		len = numChar;
 
+	/* Rendered once into a pixmap, then copied */
+	if (DrawCachedText(display, window, font, text, len, x, y, colour, 
+		False) == True)
+		return;
+
 	/* Change to the new font */
 	XSetFont(display, gccopy, font->fid);
 
@@ -264,6 +265,11 @@ void DrawText(Display *display, Window window, int x, int y, XFontStruct *font,
 	if (numChar > 0) 
 		len = numChar;
 
+	/* Rendered once into a pixmap, then copied */
+	if (DrawCachedText(display, window, font, text, len, x, y, colour, 
+		False) == True)
+		return;
+
 	/* Change to the new font */
 	XSetFont(display, gcxor, font->fid);
 	XSetFont(display, gcand, font->fid);
@@ -0,0 +1,252 @@
+/*
+ * XBoing - An X11 blockout style computer game
+ *
+ * (c) Copyright 1993, 1994, 1995, Justin C. Kibell, All Rights Reserved
+ *
+ * The X Consortium, and any party obtaining a copy of these files from
+ * the X Consortium, directly or indirectly, is granted, free of charge, a
+ * full and unrestricted irrevocable, world-wide, paid up, royalty-free,
+ * nonexclusive right and license to deal in this software and
+ * documentation files (the "Software"), including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons who receive
+ * copies from any such party to do so.  This license includes without
+ * limitation a license to do the foregoing actions under any patents of
+ * the party supplying this software to the X Consortium.
+ *
+ * In no event shall the author be liable to any party for direct, indirect,
+ * special, incidental, or consequential damages arising out of the use of
+ * this software and its documentation, even if the author has been advised
+ * of the possibility of such damage.
+ *
+ * The author specifically disclaims any warranties, including, but not limited
+ * to, the implied warranties of merchantability and fitness for a particular
+ * purpose.  The software provided hereunder is on an "AS IS" basis, and the
+ * author has no obligation to provide maintenance, support, updates,
+ * enhancements, or modifications.
+ */
+
+/*
+ * =========================================================================
+ *
+ * Frame pacer and frame time histograms. Each timing is a ring of the
+ * last PACE_HISTORY samples with bucket counts kept in step, so the
+ * histogram always covers the same window as the percentiles, which are
+ * worked out from a sorted copy only when asked for.
+ *
+ * =========================================================================
+ */
+
+/*
+ *  Include file dependencies:
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+
+#include "include/faketypes.h"
+#include "include/init.h"
+#include "include/error.h"
+
+#include "include/pacer.h"
+
+/*
+ *  Internal macro definitions:
+ */
+
+#define USEC_PER_SEC	1000000L
+#define USEC_PER_MSEC	1000L
+
+/*
+ *  Internal type declarations:
+ */
+
+typedef struct
+{
+	long 	samples[PACE_HISTORY];
+	int 	next, count;
+	int 	buckets[PACE_BUCKETS];
+} paceHistory;
+
+static void AddPaceSample(int series, long usec);
+static int 	CompareSamples(const void *a, const void *b);
+
+/*
+ *  Internal variable declarations:
+ */
+
+static paceHistory 	history[PACE_SERIES];
+static long 		frameStart = 0L;
+static long 		timerStart[PACE_SERIES];
+static long 		frameTotal[PACE_SERIES];
+static char 		*seriesNames[PACE_SERIES] = { "frame", "sim", "render" };
+
+
+long PaceNow(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (long) ts.tv_sec * USEC_PER_SEC + ts.tv_nsec / 1000L;
+}
+
+
+void PaceUntil(long deadline)
+{
+	struct timespec ts;
+	long wake = deadline - PACE_SPIN_USEC;
+
+	/* Sleep to an absolute time so time lost getting here is not added */
+	if (wake > PaceNow())
+	{
+		ts.tv_sec 	= wake / USEC_PER_SEC;
+		ts.tv_nsec 	= (wake % USEC_PER_SEC) * 1000L;
+
+		while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) 
+			== EINTR)
+			;
+	}
+
+	/* The wake up is late by a scheduler slice or so, spin the rest */
+	while (PaceNow() < deadline)
+		;
+}
+
+
+/**
+ * Puts a sample in the ring, dropping the oldest from the histogram once
+ * the ring is full.
+ *
+ */
+static void AddPaceSample(int series, long usec)
+{
+	paceHistory *h = &history[series];
+	int b;
+
+	if (usec < 0L)
+		usec = 0L;
+
+	if (h->count == PACE_HISTORY)
+	{
+		b = (int) (h->samples[h->next] / USEC_PER_MSEC);
+		h->buckets[b < PACE_BUCKETS ? b : PACE_BUCKETS - 1]--;
+	}
+	else
+		h->count++;
+
+	b = (int) (usec / USEC_PER_MSEC);
+	h->buckets[b < PACE_BUCKETS ? b : PACE_BUCKETS - 1]++;
+
+	h->samples[h->next] = usec;
+	h->next = (h->next + 1) % PACE_HISTORY;
+}
+
+
+void BeginPacedFrame(void)
+{
+	long now = PaceNow();
+
+	/* The first frame has nothing to measure from */
+	if (frameStart != 0L)
+		AddPaceSample(PACE_FRAME, now - frameStart);
+
+	frameStart = now;
+	frameTotal[PACE_SIM] 	= 0L;
+	frameTotal[PACE_RENDER] = 0L;
+}
+
+
+void EndPacedFrame(void)
+{
+	AddPaceSample(PACE_SIM, 	frameTotal[PACE_SIM]);
+	AddPaceSample(PACE_RENDER, 	frameTotal[PACE_RENDER]);
+}
+
+
+long PaceFrameDeadline(void)
+{
+	return frameStart + USEC_PER_SEC / PACE_FRAME_RATE;
+}
+
+
+void BeginPaceTimer(int series)
+{
+	timerStart[series] = PaceNow();
+}
+
+
+void EndPaceTimer(int series)
+{
+	frameTotal[series] += PaceNow() - timerStart[series];
+}
+
+
+static int CompareSamples(const void *a, const void *b)
+{
+	long x = *(const long *) a, y = *(const long *) b;
+
+	return (x > y) - (x < y);
+}
+
+
+void GetPaceStats(int series, paceStats *stats)
+{
+	paceHistory *h = &history[series];
+	long sorted[PACE_HISTORY], sum = 0L;
+	int i;
+
+	memset(stats, 0, sizeof(paceStats));
+	memcpy(stats->buckets, h->buckets, sizeof(h->buckets));
+
+	if ((stats->count = h->count) == 0)
+		return;
+
+	/* Only the filled part of the ring, which is its start until it wraps */
+	memcpy(sorted, h->samples, h->count * sizeof(long));
+	qsort(sorted, h->count, sizeof(long), CompareSamples);
+
+	for (i = 0; i < h->count; i++)
+		sum += sorted[i];
+
+	stats->mean = sum / h->count;
+	stats->p50 	= sorted[(h->count - 1) * 50 / 100];
+	stats->p95 	= sorted[(h->count - 1) * 95 / 100];
+	stats->p99 	= sorted[(h->count - 1) * 99 / 100];
+	stats->max 	= sorted[h->count - 1];
+}
+
+
+void ReportPaceStats(void)
+{
+	paceStats stats;
+	char str[120];
+	int s, b;
+
+	if (debug == False)
+		return;
+
+	for (s = 0; s < PACE_SERIES; s++)
+	{
+		GetPaceStats(s, &stats);
+
+		sprintf(str, "%-6s %4d samples, mean %.2f p50 %.2f p95 %.2f "
+			"p99 %.2f max %.2f ms", seriesNames[s], stats.count, 
+			stats.mean / 1000.0, stats.p50 / 1000.0, stats.p95 / 1000.0, 
+			stats.p99 / 1000.0, stats.max / 1000.0);
+		NormalMessage(str);
+
+		/* Just the buckets that have anything in them */
+		for (b = 0; b < PACE_BUCKETS; b++)
+		{
+			if (stats.buckets[b] == 0)
+				continue;
+
+			sprintf(str, "  %2d%s ms %5d", b, 
+				(b == PACE_BUCKETS - 1) ? "+" : " ", stats.buckets[b]);
+			NormalMessage(str);
+		}
+	}
+}
@@ -0,0 +1,329 @@
+/*
+ * XBoing - An X11 blockout style computer game
+ *
+ * (c) Copyright 1993, 1994, 1995, Justin C. Kibell, All Rights Reserved
+ *
+ * The X Consortium, and any party obtaining a copy of these files from
+ * the X Consortium, directly or indirectly, is granted, free of charge, a
+ * full and unrestricted irrevocable, world-wide, paid up, royalty-free,
+ * nonexclusive right and license to deal in this software and
+ * documentation files (the "Software"), including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons who receive
+ * copies from any such party to do so.  This license includes without
+ * limitation a license to do the foregoing actions under any patents of
+ * the party supplying this software to the X Consortium.
+ *
+ * In no event shall the author be liable to any party for direct, indirect,
+ * special, incidental, or consequential damages arising out of the use of
+ * this software and its documentation, even if the author has been advised
+ * of the possibility of such damage.
+ *
+ * The author specifically disclaims any warranties, including, but not limited
+ * to, the implied warranties of merchantability and fitness for a particular
+ * purpose.  The software provided hereunder is on an "AS IS" basis, and the
+ * author has no obligation to provide maintenance, support, updates,
+ * enhancements, or modifications.
+ */
+
+/*
+ * =========================================================================
+ *
+ * Asset pack reader. The pack is mapped read only and never copied; the
+ * entry table is checked once when it is opened so the lookups after that
+ * can trust it. See pack.h for the layout and xbpack.c for the writer.
+ *
+ * =========================================================================
+ */
+
+/*
+ *  Include file dependencies:
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+#include "include/faketypes.h"
+#include "include/error.h"
+
+#include "include/pack.h"
+
+/*
+ *  Internal macro definitions:
+ */
+
+/*
+ *  Internal type declarations:
+ */
+
+static int 	ComparePackEntry(const void *key, const void *entry);
+static int 	CheckAssetPack(void);
+#ifndef HEADLESS
+static Image 	MapPackedImage(packEntry *entry);
+#endif
+
+/*
+ *  Internal variable declarations:
+ */
+
+static unsigned char	*packBase = NULL;
+static size_t 			packSize = 0;
+static packEntry 		*packEntries = NULL;
+static unsigned int 	numPackEntries = 0;
+
+/* Name and type being looked for, for ComparePackEntry() */
+static int 				findType;
+
+
+/**
+ * bsearch() order for FindPackEntry() - by name, then type.
+ *
+ */
+static int ComparePackEntry(const void *key, const void *entry)
+{
+	const packEntry *e = (const packEntry *) entry;
+	int cmp;
+
+	if ((cmp = strncmp((const char *) key, e->name, PACK_NAME_LEN)) != 0)
+		return cmp;
+
+	return findType - (int) e->type;
+}
+
+
+/**
+ * Checks the header and that every entry lies inside the file.
+ *
+ * @return True if the pack can be used, False if not.
+ *
+ */
+static int CheckAssetPack(void)
+{
+	packHeader *header = (packHeader *) packBase;
+	packEntry *e;
+	unsigned int i;
+
+	if (packSize < sizeof(packHeader) ||
+		memcmp(header->magic, PACK_MAGIC, 4) != 0 ||
+		header->version != PACK_VERSION)
+		return False;
+
+	numPackEntries 	= header->numEntries;
+	packEntries 	= (packEntry *) (packBase + sizeof(packHeader));
+
+	if (numPackEntries > (packSize - sizeof(packHeader)) / sizeof(packEntry))
+		return False;
+
+	for (i = 0; i < numPackEntries; i++)
+	{
+		e = &packEntries[i];
+
+		if (e->name[PACK_NAME_LEN - 1] != '\0' || e->offset > packSize ||
+			e->size > packSize - e->offset)
+			return False;
+
+		if (e->type == PACK_IMAGE && 
+			(unsigned long long) e->width * e->height * 4 > e->size)
+			return False;
+	}
+
+	return True;
+}
+
+
+/**
+ * @brief Maps the asset pack in, if there is one
+ *
+ * @return True if the pack is mapped, False if the game has to read the
+ * asset files one by one
+ */
+int OpenAssetPack(void)
+{
+	struct stat st;
+	char *path;
+	void *base;
+	int fd;
+
+	if (packBase != NULL)
+		return True;
+
+	if ((path = getenv("XBOING_PACK_FILE")) == NULL)
+		path = PACK_FILE;
+
+	/* No pack is fine, the assets are read from their own files */
+	if ((fd = open(path, O_RDONLY)) < 0)
+		return False;
+
+	if (fstat(fd, &st) < 0 || st.st_size == 0)
+	{
+		close(fd);
+		return False;
+	}
+
+	base = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+
+	if (base == MAP_FAILED)
+		return False;
+
+	packBase = (unsigned char *) base;
+	packSize = (size_t) st.st_size;
+
+	if (CheckAssetPack() == False)
+	{
+		WarningMessage("Asset pack is damaged or out of date - ignoring it.");
+		CloseAssetPack();
+		return False;
+	}
+
+	return True;
+}
+
+
+/**
+ * @brief Unmaps the asset pack, everything got from it becomes invalid
+ */
+void CloseAssetPack(void)
+{
+	if (packBase != NULL)
+		munmap(packBase, packSize);
+
+	packBase 		= NULL;
+	packSize 		= 0;
+	packEntries 	= NULL;
+	numPackEntries 	= 0;
+}
+
+
+/**
+ * @brief Finds an asset in the pack
+ *
+ * @param name Path of the asset in the source tree
+ * @param type PACK_IMAGE, PACK_SOUND or PACK_LEVEL
+ *
+ * @return The entry, or NULL if there is no pack or it is not in it
+ */
+packEntry *FindPackEntry(char *name, int type)
+{
+	if (packBase == NULL)
+		return NULL;
+
+	findType = type;
+	return (packEntry *) bsearch(name, packEntries, numPackEntries, 
+		sizeof(packEntry), ComparePackEntry);
+}
+
+
+/**
+ * @brief Returns where an entry's data is mapped
+ *
+ * @param entry From FindPackEntry()
+ *
+ * @return Pointer to the first byte of the data, valid until the pack is
+ * closed
+ */
+unsigned char *GetPackData(packEntry *entry)
+{
+	return packBase + entry->offset;
+}
+
+
+/**
+ * @brief Opens a packed level for reading with the stdio calls
+ *
+ * @param name Path of the level in the source tree, e.g. levels/level01.data
+ *
+ * @return A stream reading the mapped text, or NULL if it is not packed
+ */
+FILE *OpenPackedLevel(char *name)
+{
+	packEntry *entry;
+
+	if ((entry = FindPackEntry(name, PACK_LEVEL)) == NULL)
+		return NULL;
+
+	/* Read only so the const mapping is never written through */
+	return fmemopen(GetPackData(entry), entry->size, "r");
+}
+
+
+#ifndef HEADLESS
+/**
+ * Makes an image whose pixels are the mapped bytes of an entry.
+ *
+ */
+static Image MapPackedImage(packEntry *entry)
+{
+	Image image;
+
+	image.data 		= GetPackData(entry);
+	image.width 	= (int) entry->width;
+	image.height 	= (int) entry->height;
+	image.mipmaps 	= 1;
+	image.format 	= PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+
+	return image;
+}
+
+
+/**
+ * @brief Loads an image from the pack, or from its file if not packed
+ *
+ * A packed image points at the mapped bytes, so free it with
+ * UnloadPackedImage() and never change it in place.
+ *
+ * @param path Path of the image in the source tree
+ *
+ * @return The image, with data NULL if it could not be loaded
+ */
+Image LoadPackedImage(char *path)
+{
+	packEntry *entry;
+
+	if ((entry = FindPackEntry(path, PACK_IMAGE)) == NULL)
+		return LoadImage(path);
+
+	return MapPackedImage(entry);
+}
+
+
+/**
+ * @brief Frees an image from LoadPackedImage()
+ *
+ * @param image The image, nothing is freed if it is mapped from the pack
+ */
+void UnloadPackedImage(Image image)
+{
+	unsigned char *data = (unsigned char *) image.data;
+
+	if (packBase != NULL && data >= packBase && data < packBase + packSize)
+		return;
+
+	UnloadImage(image);
+}
+
+
+/**
+ * @brief Loads a texture from the pack, or from its file if not packed
+ *
+ * @param path Path of the image in the source tree
+ *
+ * @return The texture, with id 0 if it could not be loaded
+ */
+Texture2D LoadPackedTexture(char *path)
+{
+	packEntry *entry;
+
+	if ((entry = FindPackEntry(path, PACK_IMAGE)) == NULL)
+		return LoadTexture(path);
+
+	/* Straight from the mapped bytes to the GPU, no decode or copy */
+	return LoadTextureFromImage(MapPackedImage(entry));
+}
+#endif
@@ -51,6 +51,8 @@
 #include <raylib.h>
 #include "faketypes.h"
 #include "paddle.h"
+#include "simclock.h"
+#include "atlas.h"
 #include "demo_blockloader.h"
 
 #define PADDLE_COUNT  3
@@ -59,10 +61,10 @@ const int PADDLE_INITIAL_INDEX = 1;
 const int PADDLE_VEL = 600;  // pixels per second
 
 typedef struct {
-	Texture2D img;
+	int sprite;
 	char *description;
 	int size;
-	char *filepath;
+	char *spriteName;
 } Paddle;
 
 Paddle paddles[PADDLE_COUNT];
@@ -70,11 +72,24 @@ Paddle paddles[PADDLE_COUNT];
 int reverseOn;
 int paddleIndex;
 int	paddlePosition;
+int	prevPaddlePosition;	// position before the last sim tick, for drawing
+float	paddleFraction;		// part of a pixel moved but not yet applied
 
 int GetPaddlePositionY(void);
 
 void DrawPaddle(void) { 
-	DrawTexture(paddles[paddleIndex].img, paddlePosition, GetPaddlePositionY(), WHITE);
+	// draw between the last two sim ticks so motion stays smooth at any frame rate
+	DrawPaddleAt(SimLerp(prevPaddlePosition, paddlePosition), paddles[paddleIndex].size);
+ }
+
+void DrawPaddleAt(int x, int size) {
+	// the size picks the image so a snapshot can draw the paddle it saw
+	for (int i = 0; i < PADDLE_COUNT; i++) {
+		if (paddles[i].size == size) {
+			DrawSprite(paddles[i].sprite, x, GetPaddlePositionY());
+			return;
+		}
+	}
  }
 
  int GetPaddlePositionY(void) {
@@ -87,33 +102,27 @@ bool InitialisePaddle(void) {
 	// do not load images if program is closing
 	if (WindowShouldClose()) return false;
 
-	Texture2D emptyTexture = {0};
-
-	// textures must be loaded from smallest to largest
-	paddles[0] = (Paddle){emptyTexture, "Small",  40, "./bitmaps/paddle/padsml.png"};
-	paddles[1] = (Paddle){emptyTexture, "Medium", 50, "./bitmaps/paddle/padmed.png"};
-	paddles[2] = (Paddle){emptyTexture, "Huge",   70, "./bitmaps/paddle/padhuge.png"};
+	// sizes must be listed from smallest to largest
+	paddles[0] = (Paddle){SPRITE_NONE, "Small",  40, "paddle/padsml"};
+	paddles[1] = (Paddle){SPRITE_NONE, "Medium", 50, "paddle/padmed"};
+	paddles[2] = (Paddle){SPRITE_NONE, "Huge",   70, "paddle/padhuge"};
 
 	// initialize variables before loop
 	int errorFlag = False;
 
-	// create textures for each paddle size
+	// look up each paddle size in the sprite atlas
 	for (int i = 0; i < PADDLE_COUNT; i++) {
 
-		// load paddle texture 
-		Image img = LoadImage(paddles[i].filepath);
-		paddles[i].img = LoadTextureFromImage(img);
+		paddles[i].sprite = GetSprite(paddles[i].spriteName);
 
-		// check if texture loaded successfully
-		if (paddles[i].img.id == 0) {
-			fprintf(stderr, "Error: failed to load texture InitialisePaddle() file: %s.\n", paddles[i].filepath);
+		// check the atlas had the paddle
+		if (paddles[i].sprite == SPRITE_NONE) {
+			fprintf(stderr, "Error: no paddle sprite InitialisePaddle() name: %s.\n", paddles[i].spriteName);
 			errorFlag = True;
 		}
-
-		UnloadImage(img);
 	}
 
-	// stop program if textures failed to load
+	// stop program if the paddle sprites are missing
 	return !errorFlag;
 
 }
@@ -131,32 +140,47 @@ void ToggleReverse(void) {
 }
 
 void FreePaddle(void) {
+	// paddle sprites live in the atlas, see FreeAtlas()
 	for (int i = 0; i < PADDLE_COUNT; i++) {
-		UnloadTexture(paddles[i].img);
+		paddles[i].sprite = SPRITE_NONE;
 	}
 }
 
 void MovePaddle(int direction) {
 
-	// calculate the movement distance, adjusted for reverse flag
-	int distance = PADDLE_VEL * (reverseOn == True ? -1 : 1) * GetFrameTime();
+	// remember where we were so DrawPaddle() can interpolate
+	prevPaddlePosition = paddlePosition;
 
-	// apply the move based on direction
+	// calculate the movement distance for one fixed sim tick, adjusted for reverse flag
+	float distance = PADDLE_VEL * (reverseOn == True ? -1 : 1) * SimTickSeconds();
+
+	// add the move based on direction to what is left over from the last tick
 	switch(direction) {
 		case PADDLE_LEFT:
-			paddlePosition -= distance;
+			paddleFraction -= distance;
 			break;
 		case PADDLE_RIGHT:
-			paddlePosition += distance;
+			paddleFraction += distance;
 			break;
 	}
 
+	// move by whole pixels and carry the rest, so short ticks still add up
+	int step = (int) paddleFraction;
+	paddlePosition += step;
+	paddleFraction -= step;
+
 	// keep position within window boundries
 	int x = getPlayWall(WALL_LEFT).width;
-	if (paddlePosition < x) paddlePosition = x;
+	if (paddlePosition < x) {
+		paddlePosition = x;
+		paddleFraction = 0.0f;
+	}
 
 	int maxHPosition = getPlayWall(WALL_RIGHT).x - paddles[paddleIndex].size;
-	if (paddlePosition > maxHPosition) paddlePosition = maxHPosition;
+	if (paddlePosition > maxHPosition) {
+		paddlePosition = maxHPosition;
+		paddleFraction = 0.0f;
+	}
 	
 }
 
@@ -168,12 +192,16 @@ int GetPaddlePositionX(void) {
 	return paddlePosition;
 }
 
+int GetPaddlePrevPositionX(void) {
+	return prevPaddlePosition;
+}
+
 Rectangle GetPaddleCollisionRec(void) {
 	return (Rectangle){
 		paddlePosition,
 		GetPaddlePositionY(),
-		paddles[paddleIndex].img.width,
-		paddles[paddleIndex].img.height
+		GetSpriteWidth(paddles[paddleIndex].sprite),
+		GetSpriteHeight(paddles[paddleIndex].sprite)
 	};
 }
 
@@ -190,6 +218,8 @@ void ResetPaddleStart(void) {
 	// set size and center paddle
 	paddleIndex = PADDLE_INITIAL_INDEX;
 	paddlePosition = (GetScreenWidth() - paddles[paddleIndex].size) / 2;
+	prevPaddlePosition = paddlePosition;
+	paddleFraction = 0.0f;
 	reverseOn = False;
 
  }
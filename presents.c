@@ -162,7 +162,19 @@ void SetUpPresents(Display *display, Window window, Colormap colormap)
 		&presents, &presentsM, &attributes);
 	HandleXPMError(display, XpmErrorStatus, "InitialisePresent(presents)");
 
-	/* Create the earth pixmap */
+    /* Free the xpm pixmap attributes */
+	XpmFreeAttributes(&attributes);
+}
+
+void SetUpEarth(Display *display, Window window, Colormap colormap)
+{
+	XpmAttributes   attributes;
+	int             XpmErrorStatus;
+
+    attributes.valuemask = XpmColormap;
+	attributes.colormap = colormap;
+
+	/* Create the earth pixmap - the high score screen uses it as well */
 
 	XpmErrorStatus = XpmCreatePixmapFromData(display, window, earth_xpm,
 		&earthPixmap, &earthPixmapM, &attributes);
@@ -170,9 +182,6 @@ void SetUpPresents(Display *display, Window window, Colormap colormap)
 
     /* Free the xpm pixmap attributes */
 	XpmFreeAttributes(&attributes);
-
-	/* Setup intro to initial state */
-	ResetPresents();
 }
 
 static void DrawLetter(Display *display, Window window, int letter, 
@@ -245,7 +254,7 @@ void DoPresentFlag(Display *display, Window window)
 	DrawShadowCentredText(display, window, copyFont, string, y, white, 
 		PLAY_WIDTH + MAIN_WIDTH);
 
-	if (noSound == False) playSoundFile("intro", 40);
+	if (noSound == False) playSound(SND_INTRO, 40);
 
 #ifdef testing
 	for (z = 0; z < 700; z+=10)
@@ -343,7 +352,7 @@ static void DoLetters(Display *display, Window window)
 
 	if (i < 6)
 	{
-		if (noSound == False) playSoundFile("stamp", 90);
+		if (noSound == False) playSound(SND_STAMP, 90);
 
 		/* Draw the letters of xboing one at a time across screen */
 		DrawLetter(display, window, i, x, y);
@@ -353,7 +362,7 @@ static void DoLetters(Display *display, Window window)
 	}
 	else
 	{
-		if (noSound == False) playSoundFile("stamp", 90);
+		if (noSound == False) playSound(SND_STAMP, 90);
 
 		y += 110;
 		x = ((PLAY_WIDTH + MAIN_WIDTH) / 2) - (dists[3]); 
@@ -383,7 +392,7 @@ static void DoSparkle(Display *display, Window window)
         startFrame = frame;
 		x = MAIN_WIDTH + PLAY_WIDTH - 50;
 		y = 212;
-		if (noSound == False) playSoundFile("ping", 70);
+		if (noSound == False) playSound(SND_PING, 70);
 
 		DEBUG("start the sparkle on xboing.")
     }
@@ -438,7 +447,7 @@ static void DoSpecialText1(Display *display, Window window)
 
 	if (frame >= nextFrame)
 	{
-		if (noSound == False) playSoundFile("key", 60);
+		if (noSound == False) playSound(SND_KEY, 60);
 		DrawText(display, window, x, y, dataFont, red, wisdom, i);
 
 		nextFrame = frame + 30;
@@ -475,7 +484,7 @@ static void DoSpecialText2(Display *display, Window window)
 
 	if (frame >= nextFrame)
 	{
-		if (noSound == False) playSoundFile("key", 60);
+		if (noSound == False) playSound(SND_KEY, 60);
 		DrawText(display, window, x, y, dataFont, red, wisdom2, i);
 
 		nextFrame = frame + 30;
@@ -511,7 +520,7 @@ static void DoSpecialText3(Display *display, Window window)
 
 	if (frame >= nextFrame)
 	{
-		if (noSound == False) playSoundFile("key", 60);
+		if (noSound == False) playSound(SND_KEY, 60);
 		DrawText(display, window, x, y, dataFont, red, wisdom3, i);
 
 		nextFrame = frame + 30;
@@ -538,7 +547,7 @@ static void DoClear(Display *display, Window window)
 		first = False;
 		nextFrame = frame;
 
-    	if (noSound == False) playSoundFile("whoosh", 70);
+    	if (noSound == False) playSound(SND_WHOOSH, 70);
 
 		DEBUG("Clearing presents screen.")
 	}
@@ -573,8 +582,7 @@ void QuickFinish(Display *display, Window window)
 
 static void DoFinish(Display *display, Window window)
 {
-	/* Free all the pixmaps used in this intro */
-	FreeAllPresents(display);
+	/* The pixmaps used in this intro are freed once the mode changes */
 
 	/* Erase all stuff in window */
 	XClearWindow(display, mainWindow);
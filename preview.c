@@ -89,6 +89,7 @@
 #include "intro.h"
 #include "keys.h"
 #include "version.h"
+#include "rng.h"
 
 #include "preview.h"
 
@@ -150,7 +151,7 @@ static void DoLoadLevel(Display *display, Window window)
     DrawStageBackground(display, window, bgrnd, True);
 
 	/* choose a random level */
-	lnum = (rand() % (MAX_NUM_LEVELS - 1)) + 1;
+	lnum = (GameRandom(RNG_PREVIEW) % (MAX_NUM_LEVELS - 1)) + 1;
 
     /* Construct the Preview level filename */
     if ((str = getenv("XBOING_LEVELS_DIR")) != NULL)
@@ -195,8 +196,8 @@ static void DoText(Display *display, Window window)
 
 	if (noSound == False) 
 	{
-		if ((rand() % 3) == 0)
-			playSoundFile("looksbad", 80);
+		if ((GameRandom(RNG_PREVIEW) % 3) == 0)
+			playSound(SND_LOOKSBAD, 80);
 	}
 
 	SetPreviewWait(PREVIEW_FINISH, frame + 5000);
@@ -217,7 +218,7 @@ static void DoFinish(Display *display, Window window)
     ResetIntroduction();
 
     if (noSound == False)
-        playSoundFile("whizzo", 50);
+        playSound(SND_WHIZZO, 50);
 
     SetGameSpeed(FAST_SPEED);
 }
@@ -240,7 +241,12 @@ void PreviewLevel(Display *display, Window window)
 	{
 		case PREVIEW_LEVEL:
 			if (getSpecialEffects(display) == True)
+			{
+				/* The blocks are sprites so they go in the effect buffer */
+				BeginSfxBuffer();
 				DoLoadLevel(display, bufferWindow);
+				EndSfxBuffer();
+			}
 			else
 				DoLoadLevel(display, window);
 			PreviewState = PREVIEW_TEXT;
@@ -250,7 +256,7 @@ void PreviewLevel(Display *display, Window window)
 			if (getSpecialEffects(display) == True)
 			{
 				DoText(display, bufferWindow);
-				while (WindowShatterEffect(display, window));
+				changeSfxMode(SFX_SHATTER);
 			}
 			else
 				DoText(display, window);
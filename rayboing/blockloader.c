@@ -44,6 +44,11 @@ Block game_blocks[15][9];
 char levelName[256]; // LOADED BUT NOT USED
 int timeBonus; // LOADED BUT NOT USED
 
+// Blocks drawn once into an offscreen texture, redrawn only when a block changes
+RenderTexture2D blockLayer;
+int blockLayerLoaded = 0;
+int blockLayerDirty = 1;
+
 // Read in all level data from a file.
 // Fills gameBlocks, levelName, and timeBonus
 void loadBlocks(char* filename);
@@ -79,6 +84,7 @@ int main(){
     }
 
     // De-Initialization
+    if (blockLayerLoaded) UnloadRenderTexture(blockLayer);
 
     CloseWindow(); // Close window and OpenGL context
 
@@ -118,21 +124,39 @@ void loadBlocks(char* filename){
 
 void drawBlocks(){
 
-	/* Loop through all blocks */
-    for (int row = 0; row < 15; row++){
+    if (!blockLayerLoaded) {
+        blockLayer = LoadRenderTexture(screenWidth, screenHeight);
+        blockLayerLoaded = 1;
+    }
+
+    /* Only redraw the blocks into the layer when one has changed */
+    if (blockLayerDirty) {
+        BeginTextureMode(blockLayer);
+        ClearBackground(BLANK);
+
+        /* Loop through all blocks */
+        for (int row = 0; row < 15; row++){
 
-        for (int col = 0; col < 9; col++){
+            for (int col = 0; col < 9; col++){
 
-            /* If there is a block, draw it */
-    		if(game_blocks[row][col].blockOffsetX > -1){
-                DrawTexture(game_blocks[row][col].texture,
-                    (col * colWidth) + game_blocks[row][col].blockOffsetX + PLAY_X_OFFSET,
-					(row * rowHeight) + game_blocks[row][col].blockOffsetY + PLAY_Y_OFFSET,
-                    WHITE);
+                /* If there is a block, draw it */
+                if(game_blocks[row][col].blockOffsetX > -1){
+                    DrawTexture(game_blocks[row][col].texture,
+                        (col * colWidth) + game_blocks[row][col].blockOffsetX + PLAY_X_OFFSET,
+                        (row * rowHeight) + game_blocks[row][col].blockOffsetY + PLAY_Y_OFFSET,
+                        WHITE);
+                }
             }
         }
+
+        EndTextureMode();
+        blockLayerDirty = 0;
     }
 
+    /* The whole block field is one quad, flipped as render textures are upside down */
+    DrawTextureRec(blockLayer.texture,
+        (Rectangle){0, 0, screenWidth, -screenHeight}, (Vector2){0, 0}, WHITE);
+
     /* The the red gamne outline */
     DrawRectangleLinesEx((Rectangle){PLAY_X_OFFSET - 1, PLAY_Y_OFFSET - 1, PLAY_WIDTH + 1, PLAY_HEIGHT + 1},
                         PLAY_BORDER_WIDTH, RED);
@@ -140,6 +164,8 @@ void drawBlocks(){
 
 void addBlock(int row, int col, char ch){
 
+    blockLayerDirty = 1;
+
     game_blocks[row][col].blockOffsetX	= (colWidth - BLOCK_WIDTH) / 2;
 	game_blocks[row][col].blockOffsetY 	= (rowHeight - BLOCK_HEIGHT) / 2;
 
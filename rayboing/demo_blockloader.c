@@ -62,6 +62,11 @@ const int ROW_MAX = 15;
 
 Block game_blocks[15][9];
 
+// Blocks drawn once into an offscreen texture, redrawn only when a block changes
+RenderTexture2D blockLayer;
+bool blockLayerLoaded = false;
+bool blockLayerDirty = true;
+
 Vector2 getPlayCorner(CORNERS corner);
 bool isBlockTypeInteractive(char ch);
 void deactivateBlock(int row, int col);
@@ -116,20 +121,39 @@ bool loadBlocks(const char* filename) {
 
 void drawBlocks(void){
 
-	/* Loop through all blocks */
-    for (int row = 0; row < 15; row++){
+    if (!blockLayerLoaded) {
+        blockLayer = LoadRenderTexture(GetScreenWidth(), GetScreenHeight());
+        blockLayerLoaded = true;
+    }
+
+    /* Only redraw the blocks into the layer when one has been hit or added */
+    if (blockLayerDirty) {
+        BeginTextureMode(blockLayer);
+        ClearBackground(BLANK);
 
-        for (int col = 0; col < 9; col++){
+        /* Loop through all blocks */
+        for (int row = 0; row < 15; row++){
 
-            /* If there is a block, draw it */
-    		if(!game_blocks[row][col].active) continue;
+            for (int col = 0; col < 9; col++){
 
-            DrawTexture(game_blocks[row][col].texture,
-                game_blocks[row][col].position.x,
-                game_blocks[row][col].position.y,
-                WHITE);
+                /* If there is a block, draw it */
+                if(!game_blocks[row][col].active) continue;
+
+                DrawTexture(game_blocks[row][col].texture,
+                    game_blocks[row][col].position.x,
+                    game_blocks[row][col].position.y,
+                    WHITE);
+            }
         }
+
+        EndTextureMode();
+        blockLayerDirty = false;
     }
+
+    /* The whole block field is one quad, flipped as render textures are upside down */
+    DrawTextureRec(blockLayer.texture,
+        (Rectangle){0, 0, blockLayer.texture.width, -blockLayer.texture.height},
+        (Vector2){0, 0}, WHITE);
 }
 
 
@@ -147,6 +171,7 @@ void addBlock(int row, int col, char ch){
 	game_blocks[row][col].blockOffsetY 	= (playArea.rowHeight - BLOCK_HEIGHT) / 2;
 
     game_blocks[row][col].type = ch;
+    blockLayerDirty = true;
 
     switch(ch){
 
@@ -435,6 +460,9 @@ void freeBlockTextures(void) {
     for (int i = 0; i < 5; i++) {
         UnloadTexture(COUNTER_BLK[i]);
     }
+
+    if (blockLayerLoaded) UnloadRenderTexture(blockLayer);
+    blockLayerLoaded = false;
 }
 
 
@@ -465,6 +493,8 @@ bool isBlockActive(int row, int col) {
 
 void activateBlock(int row, int col) {
 
+    char typeBefore = game_blocks[row][col].type;
+
     switch(game_blocks[row][col].type) {
         
         case 'w': // wall, do nothing
@@ -538,6 +568,9 @@ void activateBlock(int row, int col) {
             break;
     }
 
+    // a counter block shows its new number
+    if (game_blocks[row][col].type != typeBefore) blockLayerDirty = true;
+
     if (blocksRemaining == 0) {
         SetGameMode(MODE_WIN);
         return;
@@ -618,6 +651,7 @@ void deactivateBlock(int row, int col) {
     if (!game_blocks[row][col].active || !isBlockTypeInteractive(game_blocks[row][col].type)) return;
     game_blocks[row][col].active = false;
     blocksRemaining--;
+    blockLayerDirty = true;
 }
 
 
@@ -3,6 +3,7 @@
 
 #include "demo_gamemodes.h"
 #include "paddle.h"
+#include "simclock.h"
 #include "demo_controls.h"
 #include "demo_blockloader.h"
 #include "demo_ball.h"
@@ -39,6 +40,9 @@ void RunInitGameMode(const char *fileName) {
     ResetPaddleStart();
     ResetBall();
 
+    // don't run the ticks that passed while the end screen was up
+    ResetSimClock();
+
     RenderGameScreen();
 
     SetGameMode(MODE_PLAY);
@@ -49,8 +53,12 @@ void RunInitGameMode(const char *fileName) {
 void RunPlayMode(void) {
 
 
-    if (IsInputPaddleLeft()) MovePaddle(PADDLE_LEFT);
-    if (IsInputPaddleRight()) MovePaddle(PADDLE_RIGHT);
+    int direction = PADDLE_NONE;
+    if (IsInputPaddleLeft()) direction = PADDLE_LEFT;
+    if (IsInputPaddleRight()) direction = PADDLE_RIGHT;
+
+    // the paddle moves in fixed sim ticks, the ball still once a frame
+    for (int ticks = SimTicksDue(); ticks > 0; ticks--) MovePaddle(direction);
 
     if (IsInputReleaseBall()) ReleaseBall();
 
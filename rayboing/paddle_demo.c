@@ -1,12 +1,15 @@
 #include <stdio.h>
 #include <raylib.h>
 #include "paddle.h"
+#include "atlas.h"
 #include "faketypes.h"
+#include "simclock.h"
 
 // macros
 
 const int SCREEN_WIDTH = 582;
 const int SCREEN_HEIGHT = 720;
+const int TICK_MS = 10;   // paddle moves in fixed sim ticks, see simclock.h
 
 void DrawStatusText(void);
 void DrawTextLine(int ypos, char *text);
@@ -16,8 +19,10 @@ int main(void) {
     InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "Paddle Test");
     SetTargetFPS(60);
 
+    InitialiseAtlas();
     InitialisePaddle();
     ResetPaddleStart();
+    InitSimClock(TICK_MS);
 
     while (!WindowShouldClose()) {
     
@@ -30,8 +35,12 @@ int main(void) {
         if (IsKeyPressed(KEY_R)) ToggleReverse();
         if (IsKeyPressed(KEY_N)) SetReverseOff();
 
-        if (IsKeyDown(KEY_RIGHT) || IsKeyDown(KEY_D)) MovePaddle(PADDLE_RIGHT);
-        if (IsKeyDown(KEY_LEFT) || IsKeyDown(KEY_A)) MovePaddle(PADDLE_LEFT);
+        int direction = PADDLE_NONE;
+        if (IsKeyDown(KEY_RIGHT) || IsKeyDown(KEY_D)) direction = PADDLE_RIGHT;
+        if (IsKeyDown(KEY_LEFT) || IsKeyDown(KEY_A)) direction = PADDLE_LEFT;
+
+        // one move per sim tick due, even with no key down so DrawPaddle() settles
+        for (int ticks = SimTicksDue(); ticks > 0; ticks--) MovePaddle(direction);
 
 
         // update display
@@ -48,6 +57,7 @@ int main(void) {
 
     // release resources
     FreePaddle();
+    FreeAtlas();
 
     // exit program
     CloseWindow();
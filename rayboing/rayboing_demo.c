@@ -6,10 +6,13 @@
 #include "demo_blockloader.h"
 #include "demo_ball.h"
 #include "paddle.h"
+#include "simclock.h"
+#include "atlas.h"
 
 
 const int SCREEN_WIDTH = 575;
 const int SCREEN_HEIGHT = 720;
+const int TICK_MS = 10;   // paddle moves in fixed sim ticks, see simclock.h
 
 bool ValidateParamFilename(int argumentCount, char*arguments[]);
 void ReleaseResources(void);
@@ -30,6 +33,8 @@ int main(int argumentCount, char *arguments[]) {
 
     if (!ValidateParamFilename(argumentCount, arguments)) {
         fprintf(stderr, "Program halt on map validation");
+    } else if (!InitialiseAtlas()) {
+        fprintf(stderr, "Program halt on initialize sprite atlas");
     } else if (!loadBlockTextures()) {
         fprintf(stderr, "Program halt on iniitalize block texture");
     } else if (!InitialisePaddle()) {
@@ -39,6 +44,7 @@ int main(int argumentCount, char *arguments[]) {
     } else {
 
         initializePlayArea();
+        InitSimClock(TICK_MS);
         SetGameMode(MODE_INITGAME);
         rtnCode = 0;
 
@@ -112,4 +118,5 @@ void ReleaseResources(void) {
     FreePaddle();
     FreeBall();
     freeBlockTextures();
+    FreeAtlas();
 }
\ No newline at end of file
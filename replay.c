@@ -0,0 +1,367 @@
+/*
+ * XBoing - An X11 blockout style computer game
+ *
+ * (c) Copyright 1993, 1994, 1995, Justin C. Kibell, All Rights Reserved
+ *
+ * The X Consortium, and any party obtaining a copy of these files from
+ * the X Consortium, directly or indirectly, is granted, free of charge, a
+ * full and unrestricted irrevocable, world-wide, paid up, royalty-free,
+ * nonexclusive right and license to deal in this software and
+ * documentation files (the "Software"), including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons who receive
+ * copies from any such party to do so.  This license includes without
+ * limitation a license to do the foregoing actions under any patents of
+ * the party supplying this software to the X Consortium.
+ *
+ * In no event shall the author be liable to any party for direct, indirect,
+ * special, incidental, or consequential damages arising out of the use of
+ * this software and its documentation, even if the author has been advised
+ * of the possibility of such damage.
+ *
+ * The author specifically disclaims any warranties, including, but not limited
+ * to, the implied warranties of merchantability and fitness for a particular
+ * purpose.  The software provided hereunder is on an "AS IS" basis, and the
+ * author has no obligation to provide maintenance, support, updates,
+ * enhancements, or modifications.
+ */
+
+/*
+ * =========================================================================
+ *
+ * Input recording and replay.
+ *
+ * A recording is the four byte magic, then the header fields and then the
+ * records, all as variable length integers - seven bits a byte, low bits
+ * first, top bit set while more bytes follow. Each record is the number of
+ * frames since the record before, the record type and the value, zigzag
+ * encoded so the paddle's "no position" costs one byte. Most records fit
+ * in three bytes. Playback reads the whole file in at the start so nothing
+ * touches the disk while the game runs.
+ *
+ * =========================================================================
+ */
+
+/*
+ *  Include file dependencies:
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "include/faketypes.h"
+#include "include/main.h"
+#include "include/ball.h"
+#include "include/level.h"
+#include "include/error.h"
+#include "include/rng.h"
+#include "include/replay.h"
+
+/*
+ *  Internal macro definitions:
+ */
+
+/* Small negative values get small codes: 0, -1, 1, -2 ... -> 0, 1, 2, 3 */
+#define ZIGZAG(v)		((v) < 0 ? ((unsigned long) ~(v) << 1) | 1UL : \
+							(unsigned long) (v) << 1)
+#define UNZIGZAG(u)		(((u) & 1UL) ? ~(long) ((u) >> 1) : (long) ((u) >> 1))
+
+/*
+ *  Internal type declarations:
+ */
+
+static void 	PutVarint(unsigned long value);
+static int 		GetVarint(unsigned long *value);
+static int 		ReadNextRecord(void);
+
+/*
+ *  Internal variable declarations:
+ */
+
+static int 				replayMode = REPLAY_NONE;
+static replayHeader 	header;
+
+/* Recording */
+static FILE 			*recordFile = NULL;
+static int 				recordStarted = False;
+static int 				lastPaddleX = REPLAY_NO_PADDLE;
+
+/* Playback */
+static unsigned char 	*playData = NULL;
+static long 			playLength = 0L, playPos = 0L;
+static int 				nextType, nextValue;
+
+/* Frame of the last record written or read */
+static int 				lastFrame = 0;
+
+
+static void PutVarint(unsigned long value)
+{
+	/* Seven bits at a time, top bit says another byte follows */
+	while (value >= 0x80UL)
+	{
+		fputc((int) ((value & 0x7fUL) | 0x80UL), recordFile);
+		value >>= 7;
+	}
+
+	fputc((int) value, recordFile);
+}
+
+static int GetVarint(unsigned long *value)
+{
+	unsigned long byte;
+	int shift = 0;
+
+	*value = 0UL;
+
+	/* Read until a byte without the top bit or the data runs out */
+	while (playPos < playLength && shift < (int) (sizeof(long) * 8))
+	{
+		byte = (unsigned long) playData[playPos++];
+		*value |= (byte & 0x7fUL) << shift;
+
+		if ((byte & 0x80UL) == 0UL)
+			return True;
+
+		shift += 7;
+	}
+
+	return False;
+}
+
+static int ReadNextRecord(void)
+{
+	unsigned long delta, type, value;
+
+	/* Decode the next record ready for NextReplayInput() */
+	if (GetVarint(&delta) == False || GetVarint(&type) == False ||
+		GetVarint(&value) == False)
+	{
+		/* Cut short - play what there was and stop */
+		WarningMessage("Replay file is truncated.");
+		nextType 	= REPLAY_END;
+		nextValue 	= 0;
+		return False;
+	}
+
+	lastFrame 	+= (int) delta;
+	nextType 	= (int) type;
+	nextValue 	= (int) UNZIGZAG(value);
+
+	return True;
+}
+
+int StartReplayRecord(char *path)
+{
+	/* Open the file now so a bad path is found before the game starts */
+	if ((recordFile = fopen(path, "wb")) == NULL)
+	{
+		WarningMessage("Cannot open replay file for writing.");
+		return False;
+	}
+
+	replayMode 		= REPLAY_RECORD;
+	recordStarted 	= False;
+	lastPaddleX 	= REPLAY_NO_PADDLE;
+
+	return True;
+}
+
+int StartReplayPlayback(char *path)
+{
+	FILE *playFile;
+	unsigned long field[7];
+	int i;
+
+	if ((playFile = fopen(path, "rb")) == NULL)
+	{
+		WarningMessage("Cannot open replay file.");
+		return False;
+	}
+
+	/* Read the whole recording in at once */
+	fseek(playFile, 0L, SEEK_END);
+	playLength = ftell(playFile);
+	fseek(playFile, 0L, SEEK_SET);
+
+	if (playLength <= 4L || (playData = malloc((size_t) playLength)) == NULL)
+	{
+		WarningMessage("Cannot read replay file.");
+		fclose(playFile);
+		return False;
+	}
+
+	if (fread(playData, (size_t) playLength, 1, playFile) != 1)
+	{
+		WarningMessage("Cannot read replay file.");
+		fclose(playFile);
+		free(playData);
+		playData = NULL;
+		return False;
+	}
+
+	if (fclose(playFile) < 0)
+		WarningMessage("Cannot close replay file.");
+
+	if (memcmp(playData, REPLAY_MAGIC, 4) != 0)
+	{
+		WarningMessage("Not an xboing replay file.");
+		free(playData);
+		playData = NULL;
+		return False;
+	}
+
+	/* Version, seed, level, frame, warp, control and collision mode */
+	playPos = 4L;
+	for (i = 0; i < 7; i++)
+	{
+		if (GetVarint(&field[i]) == False)
+		{
+			WarningMessage("Replay file is truncated.");
+			free(playData);
+			playData = NULL;
+			return False;
+		}
+	}
+
+	if (field[0] != (unsigned long) REPLAY_VERSION)
+	{
+		WarningMessage("Incorrect replay file version.");
+		free(playData);
+		playData = NULL;
+		return False;
+	}
+
+	header.seed 			= field[1];
+	header.startLevel 		= (int) field[2];
+	header.startFrame 		= (int) field[3];
+	header.warpSpeed 		= (int) field[4];
+	header.controlMode 		= (int) field[5];
+	header.collisionMode 	= (int) field[6];
+
+	/* Have the first record ready */
+	lastFrame 	= header.startFrame;
+	replayMode 	= REPLAY_PLAY;
+	(void) ReadNextRecord();
+
+	return True;
+}
+
+void BeginReplayGame(int when)
+{
+	if (replayMode == REPLAY_RECORD && recordStarted == False)
+	{
+		/* Only the first game is recorded, from a fresh seed */
+		SeedGameRandom(GetGameSeed());
+
+		header.seed 			= GetGameSeed();
+		header.startLevel 		= GetStartingLevel();
+		header.startFrame 		= when;
+		header.warpSpeed 		= GetWarpSpeed();
+		header.controlMode 		= GetPaddleControlMode();
+		header.collisionMode 	= GetBallCollisionMode();
+
+		fwrite(REPLAY_MAGIC, 4, 1, recordFile);
+		PutVarint((unsigned long) REPLAY_VERSION);
+		PutVarint(header.seed);
+		PutVarint((unsigned long) header.startLevel);
+		PutVarint((unsigned long) header.startFrame);
+		PutVarint((unsigned long) header.warpSpeed);
+		PutVarint((unsigned long) header.controlMode);
+		PutVarint((unsigned long) header.collisionMode);
+
+		lastFrame 		= when;
+		recordStarted 	= True;
+	}
+	else if (replayMode == REPLAY_PLAY)
+	{
+		/* Put everything back as it was when the recording started */
+		SeedGameRandom(header.seed);
+		SetStartingLevel(header.startLevel);
+		SetUserSpeed(10 - header.warpSpeed);
+		SetPaddleControlMode(header.controlMode);
+		SetBallCollisionMode(header.collisionMode);
+	}
+}
+
+void RecordReplayInput(int when, int type, int value)
+{
+	if (replayMode != REPLAY_RECORD || recordStarted == False)
+		return;
+
+	/* The paddle is polled every few frames - only keep the changes */
+	if (type == REPLAY_PADDLE_X)
+	{
+		if (value == lastPaddleX)
+			return;
+
+		lastPaddleX = value;
+	}
+
+	/* Records never go back in time */
+	if (when < lastFrame)
+		when = lastFrame;
+
+	PutVarint((unsigned long) (when - lastFrame));
+	PutVarint((unsigned long) type);
+	PutVarint(ZIGZAG((long) value));
+
+	lastFrame = when;
+}
+
+int NextReplayInput(int when, int *type, int *value)
+{
+	if (replayMode != REPLAY_PLAY || lastFrame > when)
+		return False;
+
+	*type 	= nextType;
+	*value 	= nextValue;
+
+	/* The end record finishes playback, anything else moves on */
+	if (nextType == REPLAY_END)
+		EndReplay(when);
+	else
+		(void) ReadNextRecord();
+
+	return True;
+}
+
+void EndReplay(int when)
+{
+	if (replayMode == REPLAY_RECORD)
+	{
+		/* Close off the recording so playback knows where it stops */
+		if (recordStarted == True)
+		{
+			PutVarint((unsigned long) (when > lastFrame ? when - lastFrame : 0));
+			PutVarint((unsigned long) REPLAY_END);
+			PutVarint(0UL);
+		}
+
+		if (fclose(recordFile) < 0)
+			WarningMessage("Cannot close replay file.");
+
+		recordFile = NULL;
+	}
+	else if (replayMode == REPLAY_PLAY)
+	{
+		free(playData);
+		playData = NULL;
+	}
+
+	replayMode = REPLAY_NONE;
+}
+
+int GetReplayMode(void)
+{
+	return replayMode;
+}
+
+int GetReplayStartFrame(void)
+{
+	if (replayMode != REPLAY_PLAY)
+		return 0;
+
+	return header.startFrame;
+}
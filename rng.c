@@ -0,0 +1,122 @@
+/*
+ * XBoing - An X11 blockout style computer game
+ *
+ * (c) Copyright 1993, 1994, 1995, Justin C. Kibell, All Rights Reserved
+ *
+ * The X Consortium, and any party obtaining a copy of these files from
+ * the X Consortium, directly or indirectly, is granted, free of charge, a
+ * full and unrestricted irrevocable, world-wide, paid up, royalty-free,
+ * nonexclusive right and license to deal in this software and
+ * documentation files (the "Software"), including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons who receive
+ * copies from any such party to do so.  This license includes without
+ * limitation a license to do the foregoing actions under any patents of
+ * the party supplying this software to the X Consortium.
+ *
+ * In no event shall the author be liable to any party for direct, indirect,
+ * special, incidental, or consequential damages arising out of the use of
+ * this software and its documentation, even if the author has been advised
+ * of the possibility of such damage.
+ *
+ * The author specifically disclaims any warranties, including, but not limited
+ * to, the implied warranties of merchantability and fitness for a particular
+ * purpose.  The software provided hereunder is on an "AS IS" basis, and the
+ * author has no obligation to provide maintenance, support, updates,
+ * enhancements, or modifications.
+ */
+
+/*
+ * =========================================================================
+ *
+ * Seeded random number streams.
+ *
+ * Each stream is a PCG32 generator (permuted congruential generator, 64
+ * bits of state and 32 bits out per step). All the game streams share one
+ * seed and differ only in their stream selector, so they never overlap and
+ * a part of the game that draws more numbers than before cannot change what
+ * any other part sees.
+ *
+ * =========================================================================
+ */
+
+/*
+ *  Include file dependencies:
+ */
+
+#include <stdio.h>
+
+#include "include/rng.h"
+
+/*
+ *  Internal macro definitions:
+ */
+
+#define PCG_MULTIPLIER		6364136223846793005ULL
+
+/*
+ *  Internal type declarations:
+ */
+
+/*
+ *  Internal variable declarations:
+ */
+
+static RNG 				gameStreams[NUM_RNG_STREAMS];
+static unsigned long 	gameSeed = 0UL;
+static int 				gameSeeded = 0;
+
+
+void SeedRng(RNG *rng, unsigned long long seed, unsigned long long stream)
+{
+	/* As the PCG reference code - step once either side of adding seed */
+	rng->state 	= 0ULL;
+	rng->inc 	= (stream << 1) | 1ULL;
+	(void) NextRng(rng);
+	rng->state += seed;
+	(void) NextRng(rng);
+}
+
+unsigned int NextRng(RNG *rng)
+{
+	unsigned long long old;
+	unsigned int xorshifted, rot;
+
+	/* Advance the LCG then permute the old state into the output */
+	old = rng->state;
+	rng->state = old * PCG_MULTIPLIER + rng->inc;
+
+	xorshifted 	= (unsigned int) (((old >> 18) ^ old) >> 27);
+	rot 		= (unsigned int) (old >> 59);
+
+	return (xorshifted >> rot) | (xorshifted << ((32 - rot) & 31));
+}
+
+void SeedGameRandom(unsigned long seed)
+{
+	int i;
+
+	for (i = 0; i < NUM_RNG_STREAMS; i++)
+		SeedRng(&gameStreams[i], (unsigned long long) seed, 
+			(unsigned long long) i);
+
+	gameSeed 	= seed;
+	gameSeeded 	= 1;
+}
+
+unsigned long GetGameSeed(void)
+{
+	return gameSeed;
+}
+
+int GameRandom(int stream)
+{
+	/* Anyone drawing before the game is seeded gets seed 0 */
+	if (!gameSeeded)
+		SeedGameRandom(0UL);
+
+	if (stream < 0 || stream >= NUM_RNG_STREAMS)
+		stream = 0;
+
+	return (int) (NextRng(&gameStreams[stream]) >> 1);
+}
@@ -72,9 +72,11 @@
 #include "special.h"
 #include "misc.h"
 #include "main.h"
+#include "hud.h"
 
 #include "score.h"
 
+#ifndef HEADLESS
 #include "bitmaps/digits/digit0.xpm"
 #include "bitmaps/digits/digit1.xpm"
 #include "bitmaps/digits/digit2.xpm"
@@ -85,6 +87,7 @@
 #include "bitmaps/digits/digit7.xpm"
 #include "bitmaps/digits/digit8.xpm"
 #include "bitmaps/digits/digit9.xpm"
+#endif
 
 /*
  *  Internal macro definitions:
@@ -118,6 +121,7 @@ u_long score = 0L;
  *@todo Remove reliance on X11
  *
  */
+#ifndef HEADLESS
 void InitialiseScoreDigits(Display *display, Window window, Colormap colormap)
 {
 	XpmAttributes   attributes;
@@ -170,6 +174,7 @@ void InitialiseScoreDigits(Display *display, Window window, Colormap colormap)
 	/* Free the xpm pixmap attributes */
 	XpmFreeAttributes(&attributes);
 }
+#endif
 
 /**
  * @brief Draws the digits that are used to count the score
@@ -270,29 +275,21 @@ u_long ComputeScore(u_long inc)
 }
 
 /**
- * @brief Clear the old score display and creates a new one with new score digits
+ * @brief Puts a new number in the score panel
  *
  * @param Display display X11 display
  * @param Window window X11 window size
  * @param u_long score The current score
  * @pre The old score must have an increment added to it
- * @post The old score is erased while the new score is displayed
+ * @post The score panel shows the new number from the end of the frame
  *
- * @todo remove reliance on X11
+ * Only the digits that changed are drawn again, and only once a frame
+ * however often the score goes up, see FlushHud().
  *
  */
 void DisplayScore(Display *display, Window window, u_long score)
 {
-	/* Erase the old score in the window */
-	XClearWindow(display, window);
-
-	/* Draw a zero if no score */
-	if (score == 0L)
-		RenderShape(display, window, 
-			digitPixmaps[0], digitPixmapsM[0], 192, 0, 30, 40, True);
-	else
-		/* Draw the score digits rescursively */
-		DrawOutNumber(display, window, score, 224, 0);
+	SetHudScore(score);
 }
 
 /**
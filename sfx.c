@@ -50,6 +50,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stddef.h>
+#include <raylib.h>
 
 // TODO: Remove functional reliance on X11
 // #include <X11/Xlib.h>
@@ -78,15 +79,339 @@
 #define NUM_SCAT 			10 
 #define RANDY(range) 		(rand() % (range))
 
+/* Shader passes, one for each effect drawn on the GPU */
+#define PASS_BLIND			0
+#define PASS_SHATTER		1
+#define PASS_FADE			2
+#define PASS_STATIC			3
+#define NUM_PASSES			4
+
+/* How long the timed effects take in seconds */
+#define BLIND_TIME			0.5
+#define SHATTER_TIME		0.6
+#define FADE_TIME			0.25
+
+/* 
+ * Fragment shader prologue - raylib's default vertex shader feeds it.
+ * origin is the top left of the area drawn over in framebuffer pixels,
+ * so Pixel() counts whole pixels from there whatever the quad's size.
+ */
+#define PASS_HEADER \
+	"#version 330\n" \
+	"in vec2 fragTexCoord;\n" \
+	"in vec4 fragColor;\n" \
+	"uniform sampler2D texture0;\n" \
+	"uniform vec2 origin;\n" \
+	"uniform vec2 size;\n" \
+	"uniform float progress;\n" \
+	"uniform vec2 seed;\n" \
+	"out vec4 finalColor;\n" \
+	"vec2 Pixel() {\n" \
+	"    return floor(vec2(gl_FragCoord.x - origin.x, \n" \
+	"        origin.y - gl_FragCoord.y));\n" \
+	"}\n"
+
+/*
+ *  Internal type declarations:
+ */
+
+typedef struct
+{
+	Shader 	shader;
+	int 	originLoc;
+	int 	sizeLoc;
+	int 	progressLoc;
+	int 	seedLoc;
+} sfxPass;
+
+static void 	LoadSfxPasses(void);
+static float 	EffectProgress(double length);
+static void 	DrawSfxPass(int pass, Window window, int w, int h, 
+					float progress, float seedx, float seedy);
+static void 	ClearSfxBuffer(void);
+static void 	CopyBlindColumns(Display *display, Window window, int upto);
+static void 	CopyShatterSteps(Display *display, Window window, int upto, 
+					int offx, int offy);
+
 /*
  *  Internal variable declarations:
  */
 
 static int sfxEndFrame, useSfx;
 int modeSfx;
+
+/* Wall time the current effect started, below zero when not started */
+static double sfxStartTime = -1.0;
+
+/* Blind columns or shatter steps already copied from the buffer window */
+static int sfxCopied = 0;
+
+/* The shatter scatter order (idea from xjewel) */
 static int xscat[NUM_SCAT] = { 1, 9, 3, 6, 2, 4, 0, 7, 5, 8 };
 static int yscat[NUM_SCAT] = { 2, 1, 0, 8, 6, 4, 9, 3, 7, 5 };
 
+/*
+ * The play area being brought into view. What is drawn between
+ * BeginSfxBuffer() and EndSfxBuffer() goes here as it went into the
+ * buffer window, and the blind and shatter passes reveal it. Anything
+ * drawn to the buffer window with X is copied over in the same pattern,
+ * so screens still drawn with X are revealed as well.
+ */
+static RenderTexture2D 	sfxBuffer;
+static int 				sfxBufferUsed = False;
+static sfxPass 			passes[NUM_PASSES];
+static int 				passesLoaded = False;
+
+/*
+ * Eight blinds sweep open left to right, as the old column copies did.
+ */
+static char *blindShader = PASS_HEADER
+	"void main() {\n"
+	"    float blind = floor(size.x / 8.0);\n"
+	"    if (mod(Pixel().x, blind) > progress * blind) discard;\n"
+	"    finalColor = texture(texture0, fragTexCoord) * fragColor;\n"
+	"}\n";
+
+/*
+ * Each 200x200 cell is cut into 10x10 tiles that appear one at a time in
+ * the scatter order of the old XCopyArea loops (idea from xjewel). The
+ * tables are the inverses of xscat[] and yscat[]; seed is the random
+ * offset into them.
+ */
+static char *shatterShader = PASS_HEADER
+	"const int xinv[10] = int[10](6, 0, 4, 2, 5, 8, 3, 7, 9, 1);\n"
+	"const int yinv[10] = int[10](2, 1, 0, 7, 5, 9, 4, 8, 3, 6);\n"
+	"void main() {\n"
+	"    ivec2 tile = ivec2(mod(Pixel(), 200.0) / 20.0);\n"
+	"    int sy = (yinv[tile.y] - int(seed.y) + 20) % 10;\n"
+	"    int sx = (xinv[tile.x] - sy - int(seed.x) + 20) % 10;\n"
+	"    if (float(sx * 10 + sy) >= progress * 100.0) discard;\n"
+	"    finalColor = texture(texture0, fragTexCoord) * fragColor;\n"
+	"}\n";
+
+/*
+ * A black grid every 12 pixels whose lines thicken until they meet.
+ */
+static char *fadeShader = PASS_HEADER
+	"void main() {\n"
+	"    vec2 cell = mod(Pixel(), 12.0);\n"
+	"    if (min(cell.x, cell.y) > progress * 12.0) discard;\n"
+	"    finalColor = vec4(0.0, 0.0, 0.0, 1.0);\n"
+	"}\n";
+
+/*
+ * Grey snow in 2x2 pixel flecks, reseeded every pass.
+ */
+static char *staticShader = PASS_HEADER
+	"void main() {\n"
+	"    vec2 fleck = floor(Pixel() / 2.0) + seed;\n"
+	"    float n = fract(sin(dot(fleck, vec2(12.9898, 78.233))) * 43758.5453);\n"
+	"    finalColor = vec4(vec3(n), 1.0);\n"
+	"}\n";
+
+
+/**
+ * @brief Compiles the effect shaders and makes the buffer texture
+ *
+ * Done the first time an effect runs so a game with -nosfx never does.
+ */
+static void LoadSfxPasses(void)
+{
+	char *code[NUM_PASSES];
+	int i;
+
+	if (passesLoaded == True)
+		return;
+
+	code[PASS_BLIND] 	= blindShader;
+	code[PASS_SHATTER] 	= shatterShader;
+	code[PASS_FADE] 	= fadeShader;
+	code[PASS_STATIC] 	= staticShader;
+
+	for (i = 0; i < NUM_PASSES; i++)
+	{
+		passes[i].shader 		= LoadShaderFromMemory(NULL, code[i]);
+		passes[i].originLoc 	= GetShaderLocation(passes[i].shader, 
+									"origin");
+		passes[i].sizeLoc 		= GetShaderLocation(passes[i].shader, "size");
+		passes[i].progressLoc 	= GetShaderLocation(passes[i].shader, 
+									"progress");
+		passes[i].seedLoc 		= GetShaderLocation(passes[i].shader, "seed");
+	}
+
+	sfxBuffer = LoadRenderTexture(PLAY_WIDTH, PLAY_HEIGHT);
+	passesLoaded = True;
+
+	ClearSfxBuffer();
+}
+
+/**
+ * @brief Empties the buffer so only what is drawn next gets revealed
+ */
+static void ClearSfxBuffer(void)
+{
+	BeginTextureMode(sfxBuffer);
+	ClearBackground(BLANK);
+	EndTextureMode();
+
+	sfxBufferUsed = False;
+}
+
+/**
+ * @brief Works out how far through a timed effect the game is
+ *
+ * The first call starts the clock.
+ *
+ * @param length Length of the effect in seconds
+ * @return float 0 at the start to 1 when the effect is over
+ */
+static float EffectProgress(double length)
+{
+	double now = GetTime();
+
+	if (sfxStartTime < 0.0)
+		sfxStartTime = now;
+
+	if (now - sfxStartTime >= length)
+		return 1.0f;
+
+	return (float) ((now - sfxStartTime) / length);
+}
+
+/**
+ * @brief Draws the buffer through an effect shader as one quad
+ *
+ * @param pass One of the PASS_ shaders
+ * @param window The window whose area is covered
+ * @param w Width of the area covered
+ * @param h Height of the area covered
+ * @param progress How far through the effect, 0 to 1
+ * @param seedx First random value for the pass
+ * @param seedy Second random value for the pass
+ */
+static void DrawSfxPass(int pass, Window window, int w, int h, 
+	float progress, float seedx, float seedy)
+{
+	float origin[2], size[2], seed[2];
+	int x, y;
+
+	GetWindowOrigin(window, &x, &y);
+
+	/* The framebuffer counts rows up from the bottom */
+	origin[0] = (float) x;
+	origin[1] = (float) (GetScreenHeight() - y);
+	size[0] = (float) w;
+	size[1] = (float) h;
+	seed[0] = seedx;
+	seed[1] = seedy;
+
+	SetShaderValue(passes[pass].shader, passes[pass].originLoc, origin, 
+		SHADER_UNIFORM_VEC2);
+	SetShaderValue(passes[pass].shader, passes[pass].sizeLoc, size, 
+		SHADER_UNIFORM_VEC2);
+	SetShaderValue(passes[pass].shader, passes[pass].progressLoc, &progress,
+		SHADER_UNIFORM_FLOAT);
+	SetShaderValue(passes[pass].shader, passes[pass].seedLoc, seed, 
+		SHADER_UNIFORM_VEC2);
+
+	/* Render textures are stored upside down so flip it back */
+	BeginShaderMode(passes[pass].shader);
+	DrawTextureRec(sfxBuffer.texture, (Rectangle) { 0, 0, w, -h }, 
+		(Vector2) { x, y }, WHITE);
+	EndShaderMode();
+}
+
+/**
+ * @brief Copies the next blind columns over from the buffer window
+ *
+ * Column i of each of the eight blinds is copied once, in the order the
+ * blind shader shows them.
+ *
+ * @param display Pointer to the X Display structure.
+ * @param window The X Window to copy to.
+ * @param upto Copy every column before this one in each blind
+ */
+static void CopyBlindColumns(Display *display, Window window, int upto)
+{
+	int x;
+
+	for (; sfxCopied < upto; sfxCopied++)
+		for (x = 0; x <= PLAY_WIDTH; x += (PLAY_WIDTH / 8))
+			XCopyArea(display, bufferWindow, window, gc, 
+				x + sfxCopied, 0, 1, PLAY_HEIGHT, x + sfxCopied, 0);
+}
+
+/**
+ * @brief Copies the next shatter tiles over from the buffer window
+ *
+ * Each step copies the same tile of every 200x200 cell, in the order the
+ * shatter shader shows them.
+ *
+ * @param display Pointer to the X Display structure.
+ * @param window The X Window to copy to.
+ * @param upto Copy every step before this one, out of NUM_SCAT squared
+ * @param offx Random offset into the x scatter order
+ * @param offy Random offset into the y scatter order
+ */
+static void CopyShatterSteps(Display *display, Window window, int upto, 
+	int offx, int offy)
+{
+	int srcx, srcy, destx, desty, tx, ty;
+	int tw = 200 / NUM_SCAT, th = 200 / NUM_SCAT;
+
+	for (; sfxCopied < upto; sfxCopied++)
+	{
+		srcx = sfxCopied / NUM_SCAT;
+		srcy = sfxCopied % NUM_SCAT;
+		tx = xscat[(srcx + srcy + offx) % NUM_SCAT] * tw;
+		ty = yscat[(srcy + offy) % NUM_SCAT] * th;
+
+		for (destx = 0; destx <= 4; destx++)
+			for (desty = 0; desty <= 5; desty++)
+				XCopyArea(display, bufferWindow, window, gc, 
+					(destx * 200) + tx, (desty * 200) + ty, tw, th,
+					(destx * 200) + tx, (desty * 200) + ty);
+	}
+}
+
+/**
+ * @brief Sends raylib drawing into the effect buffer
+ *
+ * Use around drawing that went to the buffer window for the next blind
+ * or shatter effect to bring into view.
+ */
+void BeginSfxBuffer(void)
+{
+	LoadSfxPasses();
+	BeginTextureMode(sfxBuffer);
+	sfxBufferUsed = True;
+}
+
+/**
+ * @brief Sends raylib drawing back to the screen
+ */
+void EndSfxBuffer(void)
+{
+	EndTextureMode();
+}
+
+/**
+ * @brief Frees the effect shaders and buffer if they were ever made
+ */
+void FreeSfx(void)
+{
+	int i;
+
+	if (passesLoaded == False)
+		return;
+
+	for (i = 0; i < NUM_PASSES; i++)
+		UnloadShader(passes[i].shader);
+
+	UnloadRenderTexture(sfxBuffer);
+	passesLoaded = False;
+}
+
 /**
  * @brief Enables or disables special effects.
  *
@@ -130,6 +455,9 @@ int getSpecialEffects(Display *display)
 void changeSfxMode(int newMode)
 {
 	modeSfx = newMode;
+
+	/* Timed effects start counting on their first pass */
+	sfxStartTime = -1.0;
 }
 
 
@@ -156,6 +484,7 @@ static void resetEffect(Display *display)
 {
 	/* Just re-centre window return */
 	modeSfx = SFX_NONE;
+	sfxStartTime = -1.0;
 	XMoveWindow(display, playWindow, 35, 60);
 }
 
@@ -163,15 +492,16 @@ static void resetEffect(Display *display)
  * @brief Creates a window blind closing effect.
  *
  * This function creates a visual effect where blinds appear to close over
- * the specified window.
+ * the specified window. Called once a frame, each call is one shader pass
+ * over the effect buffer.
  *
  * @param display Pointer to the X Display structure.
  * @param window The X Window to apply the effect.
- * @return int Returns 0 (False) to indicate completion of the effect.
+ * @return int Returns 1 (True) while the effect is ongoing, 0 (False) when finished.
  */
 int WindowBlindEffect(Display *display, Window window)
 {
-	int x, i;
+	float progress;
 
 	/* Does the user want special effects */
 	if (useSfx == False)
@@ -181,13 +511,23 @@ int WindowBlindEffect(Display *display, Window window)
 		return False;
 	}
 
-	XSetBackground(display, gcsfx, black);
+	LoadSfxPasses();
+
+	if (sfxStartTime < 0.0)
+		sfxCopied = 0;
 
 	/* Draw a blinds effect where little doors close over screen */
-	for (i = 0; i <= (PLAY_WIDTH / 8); i++)
-		for (x = 0; x <= PLAY_WIDTH; x += (PLAY_WIDTH / 8))
-			XCopyArea(display, bufferWindow, window, gc, 
-				x+i, 0, 1, PLAY_HEIGHT, x+i, 0);
+	progress = EffectProgress(BLIND_TIME);
+	CopyBlindColumns(display, window, 
+		(int) (progress * (PLAY_WIDTH / 8)) + 1);
+	if (sfxBufferUsed == True)
+		DrawSfxPass(PASS_BLIND, window, PLAY_WIDTH, PLAY_HEIGHT, progress, 
+			0.0f, 0.0f);
+
+	if (progress < 1.0f)
+		return True;
+
+	ClearSfxBuffer();
 
 	/* End of special effect - reset off */
 	resetEffect(display);
@@ -213,9 +553,7 @@ int WindowStaticEffect(Display *display, Window window, int w, int h)
 		start = False;
 	}
 
-	/* Do somehting in here */
-
-	if (frame >= sfxEndFrame) 
+	if (frame >= sfxEndFrame || useSfx == False) 
 	{
 		/* End of special effect - reset off */
 		resetEffect(display);
@@ -223,6 +561,12 @@ int WindowStaticEffect(Display *display, Window window, int w, int h)
 		return False;
 	}
 
+	LoadSfxPasses();
+
+	/* Fresh snow every frame */
+	DrawSfxPass(PASS_STATIC, window, w, h, 0.0f, (float) RANDY(1000), 
+		(float) RANDY(1000));
+
 	return True;
 }
 
@@ -230,15 +574,16 @@ int WindowStaticEffect(Display *display, Window window, int w, int h)
  * @brief Creates a window shattering effect.
  *
  * This effect simulates a window breaking into pieces and scattering.
+ * Called once a frame, each call is one shader pass over the effect buffer.
  *
  * @param display Pointer to the X Display structure.
  * @param window The X Window to apply the effect.
- * @return int Returns 0 (False) after the effect is completed.
+ * @return int Returns 1 (True) while the effect is ongoing, 0 (False) when finished.
  */
 int WindowShatterEffect(Display *display, Window window)
 {
-    int offx, offy, sizeWidth, sizeHeight;
-    int srcx, srcy, destx, desty;
+	static int offx, offy;
+	float progress;
 
 	/* Does the user want special effects */
 	if (useSfx == False)
@@ -248,45 +593,28 @@ int WindowShatterEffect(Display *display, Window window)
 		return False;
 	}
 
+	LoadSfxPasses();
 
-    offx = RANDY(NUM_SCAT);
-    offy = RANDY(NUM_SCAT);
-	sizeWidth = 200;
-	sizeHeight = 200;
+	/* A new scatter order for each shatter */
+	if (sfxStartTime < 0.0)
+	{
+		offx = RANDY(NUM_SCAT);
+		offy = RANDY(NUM_SCAT);
+		sfxCopied = 0;
+	}
 
-	/* Spend a bit of time scattering new pixmap into view */
-	/* Original idea for this effect from xjewel */
-    for (srcx = 0; srcx < NUM_SCAT; srcx++)
-    {
-    	for (srcy = 0; srcy < NUM_SCAT; srcy++)
-        {
-            for (destx = 0; destx <= 4; destx++)
-			{
-            	for (desty = 0; desty <= 5; desty++)
-                {
-					XCopyArea(display, bufferWindow, window, gc, 
-                    	(destx * sizeWidth) + 
-                        	xscat[(srcx + srcy + offx) % NUM_SCAT] 
-							* (sizeWidth / NUM_SCAT),
-
-                    	(desty * sizeHeight) + 
-                        	yscat[(srcy + offy) % NUM_SCAT] 
-							* (sizeHeight / NUM_SCAT),
-
-                    	(sizeWidth  / NUM_SCAT), 
-						(sizeHeight / NUM_SCAT),
-
-                    	(destx * sizeWidth) + 
-                        	xscat[(srcx + srcy + offx) % NUM_SCAT] 
-							* (sizeWidth / NUM_SCAT),
-
-                    	(desty * sizeHeight) + 
-                        	yscat[(srcy + offy) % NUM_SCAT] 
-							* (sizeHeight / NUM_SCAT));
-               	}
-			}
-        }
-    }
+	/* Scatter the new play area into view a tile at a time */
+	progress = EffectProgress(SHATTER_TIME);
+	CopyShatterSteps(display, window, 
+		(int) (progress * NUM_SCAT * NUM_SCAT), offx, offy);
+	if (sfxBufferUsed == True)
+		DrawSfxPass(PASS_SHATTER, window, PLAY_WIDTH, PLAY_HEIGHT, progress, 
+			(float) offx, (float) offy);
+
+	if (progress < 1.0f)
+		return True;
+
+	ClearSfxBuffer();
 
 	/* End of special effect - reset off */
 	resetEffect(display);
@@ -297,7 +625,8 @@ int WindowShatterEffect(Display *display, Window window)
  * @brief Creates a window fade effect.
  *
  * This function fades a window in and out by drawing vertical and horizontal lines
- * over the window area, creating a fading effect.
+ * over the window area, creating a fading effect. The lines are drawn by a
+ * shader in one pass a call.
  *
  * @param display Pointer to the X Display structure.
  * @param window The X Window to apply the effect.
@@ -307,11 +636,7 @@ int WindowShatterEffect(Display *display, Window window)
  */
 int WindowFadeEffect(Display *display, Window window, int w, int h)
 {
-	static int done = False;
-	static int first = True;
-	int y;
-	int x;
-	static int i = 0;
+	float progress;
 
 	/* Does the user want special effects */
 	if (useSfx == False)
@@ -321,32 +646,18 @@ int WindowFadeEffect(Display *display, Window window, int w, int h)
 		return False;
 	}
 
-	if (first == True)
-	{
-		first = False;
-		XSetForeground(display, gcsfx, black);
-		XSetBackground(display, gcsfx, black);
-		XSetWindowBorder(display, window, red);
-	}
-
-	/* Draw vertical lines */
-	for (x = i; x <= w; x += 12)
-		XDrawLine(display, window, gcsfx, x, 0, x, h);
+	LoadSfxPasses();
 
-	/* Draw horizontal lines */
-	for (y = i; y <= h; y += 12)
-		XDrawLine(display, window, gcsfx, 0, y, w, y);
+	if (sfxStartTime < 0.0)
+		XSetWindowBorder(display, window, red);
 
-	/* Fill in grid slowly */
-	i++;
-	if (i > 12) done = True;
+	/* Thicken the grid lines until they fill the window */
+	progress = EffectProgress(FADE_TIME);
+	DrawSfxPass(PASS_FADE, window, w, h, progress, 0.0f, 0.0f);
 
-	if (done == True)
+	if (progress >= 1.0f)
 	{
 		/* End of special effect - reset off */
-		done = False;
-		first = True;
-		i = 0;
 		resetEffect(display);
 		return False;
 	}
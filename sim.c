@@ -0,0 +1,287 @@
+/*
+ * XBoing - An X11 blockout style computer game
+ *
+ * (c) Copyright 1993, 1994, 1995, Justin C. Kibell, All Rights Reserved
+ *
+ * The X Consortium, and any party obtaining a copy of these files from
+ * the X Consortium, directly or indirectly, is granted, free of charge, a
+ * full and unrestricted irrevocable, world-wide, paid up, royalty-free,
+ * nonexclusive right and license to deal in this software and
+ * documentation files (the "Software"), including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons who receive
+ * copies from any such party to do so.  This license includes without
+ * limitation a license to do the foregoing actions under any patents of
+ * the party supplying this software to the X Consortium.
+ *
+ * In no event shall the author be liable to any party for direct, indirect,
+ * special, incidental, or consequential damages arising out of the use of
+ * this software and its documentation, even if the author has been advised
+ * of the possibility of such damage.
+ *
+ * The author specifically disclaims any warranties, including, but not limited
+ * to, the implied warranties of merchantability and fitness for a particular
+ * purpose.  The software provided hereunder is on an "AS IS" basis, and the
+ * author has no obligation to provide maintenance, support, updates,
+ * enhancements, or modifications.
+ */
+
+/*
+ * =========================================================================
+ *
+ * Headless simulator. Plays every level in levels/ back to back with the
+ * paddle following the ball, as fast as the game core will go, and reports
+ * how many frames were simulated per second. No display is opened, nothing
+ * is drawn, no textures are loaded and sleepSync() is never called.
+ *
+ * Build with "make -f Makefile.headless" and run as
+ *
+ *		xboing-sim [-speed <1-9>] [-frames <n>] [-start <n>] [-end <n>]
+ *			[-sweep] [-seed <n>]
+ *		xboing-sim -replay <file>
+ *
+ * -sweep uses swept ball collision instead of stepping the ball a pixel
+ * at a time, see SetBallCollisionMode(). -seed starts the game random
+ * streams from another seed, see rng.h; the same seed always plays the
+ * same games.
+ *
+ * -replay plays a game recorded with "xboing -record <file>" instead,
+ * with the recorded keys, buttons and pointer moving the paddle, and
+ * reports the score it finished on. Only the game itself is replayed -
+ * there is no bonus screen headless so it stops when the first level is
+ * cleared, and keys that open dialogues are ignored.
+ *
+ * =========================================================================
+ */
+
+/*
+ *  Include file dependencies:
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include "include/faketypes.h"
+#include "include/main.h"
+#include "include/ball.h"
+#include "include/blocks.h"
+#include "include/level.h"
+#include "include/stage.h"
+#include "include/init.h"
+#include "include/error.h"
+#include "include/headless.h"
+#include "include/score.h"
+#include "include/rng.h"
+#include "include/replay.h"
+#include "include/pack.h"
+
+/*
+ *  Internal macro definitions:
+ */
+
+/*
+ *  Internal type declarations:
+ */
+
+static double 	GetSeconds(void);
+static void 	PrintSimUsage(void);
+static int 		SimulateLevel(int levelNum, long maxFrames, long *frames);
+static void 	SimulateReplay(char *path);
+
+/*
+ *  Internal variable declarations:
+ */
+
+
+/**
+ * Returns the wall clock time in seconds.
+ *
+ * @param void
+ *
+ */
+static double GetSeconds(void)
+{
+	struct timeval tv;
+
+	gettimeofday(&tv, NULL);
+	return (double) tv.tv_sec + (double) tv.tv_usec / 1000000.0;
+}
+
+
+/**
+ * Prints the usage information for the simulator and exits.
+ *
+ * @param void
+ *
+ */
+static void PrintSimUsage(void)
+{
+	fprintf(stdout, "%s%s\n",
+		"Usage: xboing-sim [-speed <1-9>] [-frames <n>] ",
+		"[-start <1-MAX>] [-end <1-MAX>] [-sweep] [-seed <n>]");
+	fprintf(stdout, "       xboing-sim -replay <file>\n");
+	exit(1);
+}
+
+
+/**
+ * Plays one level until it is cleared, the game is lost or the frame
+ * budget runs out.
+ *
+ * @param int levelNum The level to load.
+ * @param long maxFrames Give up on the level after this many frames.
+ * @param long *frames Returns the number of frames simulated.
+ *
+ * @return MODE_BONUS if cleared, MODE_HIGHSCORE if lost, else MODE_GAME.
+ *
+ */
+static int SimulateLevel(int levelNum, long maxFrames, long *frames)
+{
+	long n;
+
+	/* Let handleGameMode() set up the level just like a new game */
+	SetStartingLevel(levelNum);
+	gameActive 	= False;
+	mode 		= MODE_GAME;
+
+	for (n = 0; n < maxFrames && mode == MODE_GAME; n++)
+	{
+		/* Nobody to click the mouse so launch waiting balls at once */
+		if (IsBallWaiting() == True)
+			ActivateWaitingBall(NULL, playWindow);
+
+		HeadlessTrackBall();
+		SimulateGameFrame(NULL);
+	}
+
+	*frames = n;
+	return mode;
+}
+
+
+/**
+ * Plays back a recorded game as fast as it will go and reports how it
+ * ended. Exits when done.
+ *
+ * @param char *path The recording to play.
+ *
+ */
+static void SimulateReplay(char *path)
+{
+	long n = 0L;
+	double t0, t1;
+
+	if (StartReplayPlayback(path) == False)
+		exit(1);
+
+	/* Warp speed is restored from the recording relative to this */
+	SetGameSpeed(FAST_SPEED);
+	SetupBlockInfo();
+
+	/* One frame before the recorded game started, see handleEventLoop() */
+	frame 		= GetReplayStartFrame() - 1;
+	gameActive 	= False;
+	mode 		= MODE_GAME;
+
+	t0 = GetSeconds();
+
+	/* Until the recording runs out or the game leaves the play area */
+	while (GetReplayMode() == REPLAY_PLAY &&
+		(mode == MODE_GAME || mode == MODE_PAUSE))
+	{
+		SimulateGameFrame(NULL);
+		n++;
+	}
+
+	t1 = GetSeconds();
+
+	fprintf(stdout, "replay %-8s level %lu score %lu %ld frames ",
+		mode == MODE_BONUS ? "cleared" :
+		mode == MODE_HIGHSCORE ? "lost" : "ended", level, score, n);
+	fprintf(stdout, "%.0f frames/sec\n",
+		(t1 > t0) ? (double) n / (t1 - t0) : 0.0);
+
+	exit(0);
+}
+
+
+int main(int argc, char **argv)
+{
+	int i, l, result;
+	int start = 1, end = MAX_NUM_LEVELS;
+	long maxFrames = SIM_MAX_FRAMES;
+	long frames, totalFrames = 0L;
+	unsigned long seed = 1UL;
+	int cleared = 0, lost = 0;
+	double t0, t1, total;
+
+	/* Levels come from the asset pack when there is one, as in the game */
+	OpenAssetPack();
+
+	for (i = 1; i < argc; i++)
+	{
+		/* The only switch without a value */
+		if (!strcmp(argv[i], "-sweep"))
+		{
+			SetBallCollisionMode(COLLIDE_SWEPT);
+			continue;
+		}
+
+		if (i + 1 >= argc)
+			PrintSimUsage();
+
+		l = atoi(argv[i + 1]);
+
+		/* Nothing else matters when playing a recording */
+		if (!strcmp(argv[i], "-replay"))
+			SimulateReplay(argv[i + 1]);
+
+		if (!strcmp(argv[i], "-seed"))
+			seed = strtoul(argv[i + 1], NULL, 10);
+		else if (!strcmp(argv[i], "-speed") && l > 0 && l <= 9)
+			SetUserSpeed(10 - l);
+		else if (!strcmp(argv[i], "-frames") && l > 0)
+			maxFrames = (long) l;
+		else if (!strcmp(argv[i], "-start") && l > 0 && l <= MAX_NUM_LEVELS)
+			start = l;
+		else if (!strcmp(argv[i], "-end") && l > 0 && l <= MAX_NUM_LEVELS)
+			end = l;
+		else
+			PrintSimUsage();
+
+		i++;
+	}
+
+	/* Same games every run so timings are comparable */
+	SeedGameRandom(seed);
+	SetPaddleControlMode(CONTROL_MOUSE);
+	SetupBlockInfo();
+
+	total = 0.0;
+	for (l = start; l <= end; l++)
+	{
+		t0 = GetSeconds();
+		result = SimulateLevel(l, maxFrames, &frames);
+		t1 = GetSeconds();
+
+		if (result == MODE_BONUS) 			cleared++;
+		else if (result == MODE_HIGHSCORE)	lost++;
+
+		totalFrames += frames;
+		total 		+= (t1 - t0);
+
+		fprintf(stdout, "level%02d %-8s %8ld frames %10.0f frames/sec\n", l,
+			result == MODE_BONUS ? "cleared" :
+			result == MODE_HIGHSCORE ? "lost" : "timeout",
+			frames, (t1 > t0) ? (double) frames / (t1 - t0) : 0.0);
+	}
+
+	fprintf(stdout, "\n%d levels, %d cleared, %d lost, %ld frames in %.3fs\n",
+		end - start + 1, cleared, lost, totalFrames, total);
+	fprintf(stdout, "%.0f frames/sec\n",
+		(total > 0.0) ? (double) totalFrames / total : 0.0);
+
+	exit(0);
+}
@@ -0,0 +1,154 @@
+/*
+ * XBoing - An X11 blockout style computer game
+ *
+ * (c) Copyright 1993, 1994, 1995, Justin C. Kibell, All Rights Reserved
+ *
+ * The X Consortium, and any party obtaining a copy of these files from
+ * the X Consortium, directly or indirectly, is granted, free of charge, a
+ * full and unrestricted irrevocable, world-wide, paid up, royalty-free,
+ * nonexclusive right and license to deal in this software and
+ * documentation files (the "Software"), including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons who receive
+ * copies from any such party to do so.  This license includes without
+ * limitation a license to do the foregoing actions under any patents of
+ * the party supplying this software to the X Consortium.
+ *
+ * In no event shall the author be liable to any party for direct, indirect,
+ * special, incidental, or consequential damages arising out of the use of
+ * this software and its documentation, even if the author has been advised
+ * of the possibility of such damage.
+ *
+ * The author specifically disclaims any warranties, including, but not limited
+ * to, the implied warranties of merchantability and fitness for a particular
+ * purpose.  The software provided hereunder is on an "AS IS" basis, and the
+ * author has no obligation to provide maintenance, support, updates,
+ * enhancements, or modifications.
+ */
+
+/*
+ * =========================================================================
+ *
+ * Fixed timestep simulation clock.
+ *
+ * Wall time is measured with the monotonic clock and added to an
+ * accumulator. Each whole tick in the accumulator is one frame of the
+ * game core. Whatever is left over is the interpolation fraction used
+ * when drawing, so rendering can run at any rate while the game itself
+ * always moves at the same speed.
+ *
+ * =========================================================================
+ */
+
+/*
+ *  Include file dependencies:
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include <time.h>
+
+#include "include/simclock.h"
+
+/*
+ *  Internal macro definitions:
+ */
+
+#define USEC_PER_MSEC	1000L
+#define USEC_PER_SEC	1000000L
+
+/*
+ *  Internal type declarations:
+ */
+
+static long GetMonotonicUsec(void);
+
+/*
+ *  Internal variable declarations:
+ */
+
+static long tickUsec = 10 * USEC_PER_MSEC;
+static long accumulator = 0L;
+static long lastTime = 0L;
+
+
+/**
+ * @brief Reads the monotonic clock
+ *
+ * @return long Microseconds since an arbitrary fixed point
+ */
+static long GetMonotonicUsec(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (long) ts.tv_sec * USEC_PER_SEC + ts.tv_nsec / 1000L;
+}
+
+void InitSimClock(long tickMs)
+{
+	SetSimTickLength(tickMs);
+	ResetSimClock();
+}
+
+void SetSimTickLength(long tickMs)
+{
+	/* A zero delay would mean infinitely many ticks per frame */
+	if (tickMs < SIM_MIN_TICK_MS)
+		tickMs = SIM_MIN_TICK_MS;
+
+	tickUsec = tickMs * USEC_PER_MSEC;
+}
+
+void ResetSimClock(void)
+{
+	accumulator = 0L;
+	lastTime = GetMonotonicUsec();
+}
+
+int SimTicksDue(void)
+{
+	long now;
+	int ticks;
+
+	/* Add the time that has passed since the last frame */
+	now = GetMonotonicUsec();
+	accumulator += now - lastTime;
+	lastTime = now;
+
+	ticks = (int) (accumulator / tickUsec);
+	accumulator -= (long) ticks * tickUsec;
+
+	/* 
+	 * If the machine cannot keep up then drop the backlog rather than
+	 * running ever more ticks per frame - the game slows down instead.
+	 */
+	if (ticks > SIM_MAX_TICKS_PER_FRAME)
+		ticks = SIM_MAX_TICKS_PER_FRAME;
+
+	return ticks;
+}
+
+float SimAlpha(void)
+{
+	return (float) accumulator / (float) tickUsec;
+}
+
+float SimTickSeconds(void)
+{
+	return (float) tickUsec / (float) USEC_PER_SEC;
+}
+
+long SimTimeToNextTick(void)
+{
+	long left;
+
+	left = tickUsec - (accumulator + (GetMonotonicUsec() - lastTime));
+	return (left > 0L) ? left : 0L;
+}
+
+int SimLerp(int prev, int curr)
+{
+	/* Round to the nearest pixel */
+	return prev + (int) lroundf((float) (curr - prev) * SimAlpha());
+}
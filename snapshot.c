@@ -0,0 +1,177 @@
+/*
+ * XBoing - An X11 blockout style computer game
+ *
+ * (c) Copyright 1993, 1994, 1995, Justin C. Kibell, All Rights Reserved
+ *
+ * The X Consortium, and any party obtaining a copy of these files from
+ * the X Consortium, directly or indirectly, is granted, free of charge, a
+ * full and unrestricted irrevocable, world-wide, paid up, royalty-free,
+ * nonexclusive right and license to deal in this software and
+ * documentation files (the "Software"), including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons who receive
+ * copies from any such party to do so.  This license includes without
+ * limitation a license to do the foregoing actions under any patents of
+ * the party supplying this software to the X Consortium.
+ *
+ * In no event shall the author be liable to any party for direct, indirect,
+ * special, incidental, or consequential damages arising out of the use of
+ * this software and its documentation, even if the author has been advised
+ * of the possibility of such damage.
+ *
+ * The author specifically disclaims any warranties, including, but not limited
+ * to, the implied warranties of merchantability and fitness for a particular
+ * purpose.  The software provided hereunder is on an "AS IS" basis, and the
+ * author has no obligation to provide maintenance, support, updates,
+ * enhancements, or modifications.
+ */
+
+/*
+ * =========================================================================
+ *
+ * Game state snapshots and the render pass that draws them, see
+ * snapshot.h.
+ *
+ * =========================================================================
+ */
+
+/*
+ *  Include file dependencies:
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <raylib.h>
+
+#include "include/faketypes.h"
+#include "include/main.h"
+#include "include/ball.h"
+#include "include/gun.h"
+#include "include/eyedude.h"
+#include "include/paddle.h"
+#include "include/special.h"
+#include "include/simclock.h"
+
+#include "include/snapshot.h"
+
+/*
+ *  Internal macro definitions:
+ */
+
+/*
+ *  Internal type declarations:
+ */
+
+static void TakeSnapshot(gameSnapshot *snap);
+static int 	SameObject(snapObject *a, snapObject *b);
+
+/*
+ *  Internal variable declarations:
+ */
+
+/* What is about to be drawn and what is on the screen now */
+static gameSnapshot 	current;
+static gameSnapshot 	drawn;
+
+
+static void TakeSnapshot(gameSnapshot *snap)
+{
+	int i, x, y;
+
+	snap->frame = frame;
+
+	/* Moving balls and bullets are blended between their last two steps */
+	for (i = 0; i < MAX_BALLS; i++)
+	{
+		snap->balls[i].shown = (balls[i].active == True &&
+			(balls[i].ballState == BALL_ACTIVE || 
+			 balls[i].ballState == BALL_READY)) ? True : False;
+		snap->balls[i].x 	 = balls[i].oldx;
+		snap->balls[i].y 	 = balls[i].oldy;
+		snap->balls[i].slide = (Killer == True) ? 
+			BALL_SLIDES - 1 : balls[i].slide;
+
+		/* A ball sitting on the paddle goes where the paddle put it */
+		if (balls[i].ballState == BALL_ACTIVE)
+			GetBallRenderPosition(&snap->balls[i].x, &snap->balls[i].y, i);
+	}
+
+	for (i = 0; i < MAX_MOVING_BULLETS; i++)
+	{
+		snap->bullets[i].shown 	= GetBulletRenderPosition(i, &x, &y);
+		snap->bullets[i].x 		= x;
+		snap->bullets[i].y 		= y;
+	}
+
+	snap->eyeDude.shown = 
+		(getEyeDudeMode() == EYEDUDE_WALK) ? True : False;
+	GetEyeDudePosition(&snap->eyeDude.x, &snap->eyeDude.y);
+	GetEyeDudeFrame(&snap->eyeDude.slide, &snap->eyeDude.direction);
+
+	/* The paddle is a sprite so it is blended between ticks as well */
+	snap->paddleX 		= SimLerp(GetPaddlePrevPositionX(), 
+		GetPaddlePositionX());
+	snap->paddleSize 	= GetPaddleSize();
+}
+
+
+static int SameObject(snapObject *a, snapObject *b)
+{
+	return (a->shown == b->shown && a->x == b->x && a->y == b->y &&
+		a->slide == b->slide && a->direction == b->direction);
+}
+
+
+void RenderSnapshot(Display *display, Window window)
+{
+	gameSnapshot *snap = &current;
+	int i;
+
+	TakeSnapshot(snap);
+
+	/* 
+	 * Erase everything that changed before drawing anything, so that one
+	 * object's erase never takes a piece out of another drawn this frame.
+	 */
+	for (i = 0; i < MAX_BALLS; i++)
+		if (drawn.balls[i].shown == True && 
+			SameObject(&drawn.balls[i], &snap->balls[i]) == False)
+			EraseTheBall(display, window, 
+				drawn.balls[i].x, drawn.balls[i].y);
+
+	for (i = 0; i < MAX_MOVING_BULLETS; i++)
+		if (drawn.bullets[i].shown == True && 
+			SameObject(&drawn.bullets[i], &snap->bullets[i]) == False)
+			EraseTheBullet(display, window, 
+				drawn.bullets[i].x, drawn.bullets[i].y);
+
+	if (drawn.eyeDude.shown == True && 
+		SameObject(&drawn.eyeDude, &snap->eyeDude) == False)
+		EraseTheEyeDude(display, window, drawn.eyeDude.x, drawn.eyeDude.y);
+
+	/* Then draw them all, an erase may have clipped one that stood still */
+	for (i = 0; i < MAX_BALLS; i++)
+		if (snap->balls[i].shown == True)
+			DrawTheBall(display, window, snap->balls[i].x, 
+				snap->balls[i].y, snap->balls[i].slide);
+
+	for (i = 0; i < MAX_MOVING_BULLETS; i++)
+		if (snap->bullets[i].shown == True)
+			DrawTheBullet(display, window, 
+				snap->bullets[i].x, snap->bullets[i].y);
+
+	if (snap->eyeDude.shown == True)
+		DrawTheEyeDude(display, window, snap->eyeDude.x, snap->eyeDude.y,
+			snap->eyeDude.slide, snap->eyeDude.direction);
+
+	DrawPaddleAt(snap->paddleX, snap->paddleSize);
+
+	drawn = *snap;
+}
+
+
+void ForgetDrawnSnapshot(void)
+{
+	/* Nothing left to erase, the next snapshot is just drawn */
+	memset(&drawn, 0, sizeof(gameSnapshot));
+}
@@ -0,0 +1,332 @@
+/*
+ * XBoing - An X11 blockout style computer game
+ *
+ * (c) Copyright 1993, 1994, 1995, Justin C. Kibell, All Rights Reserved
+ *
+ * The X Consortium, and any party obtaining a copy of these files from
+ * the X Consortium, directly or indirectly, is granted, free of charge, a
+ * full and unrestricted irrevocable, world-wide, paid up, royalty-free,
+ * nonexclusive right and license to deal in this software and
+ * documentation files (the "Software"), including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons who receive
+ * copies from any such party to do so.  This license includes without
+ * limitation a license to do the foregoing actions under any patents of
+ * the party supplying this software to the X Consortium.
+ *
+ * In no event shall the author be liable to any party for direct, indirect,
+ * special, incidental, or consequential damages arising out of the use of
+ * this software and its documentation, even if the author has been advised
+ * of the possibility of such damage.
+ *
+ * The author specifically disclaims any warranties, including, but not limited
+ * to, the implied warranties of merchantability and fitness for a particular
+ * purpose.  The software provided hereunder is on an "AS IS" basis, and the
+ * author has no obligation to provide maintenance, support, updates,
+ * enhancements, or modifications.
+ */
+
+/*
+ * =========================================================================
+ *
+ * Sound registry and frame batch, see sounds.h. The names are hashed with
+ * FNV-1a into an open addressed table, so a lookup is one hash and usually
+ * one compare.
+ *
+ * playSound() only notes the sound in this frame's batch. FlushSounds()
+ * starts each sound asked for once, louder the more often it was asked
+ * for, skips any that started too recently and starts no more than
+ * SOUND_FRAME_BUDGET, the loudest first.
+ *
+ * =========================================================================
+ */
+
+/*
+ *  Include file dependencies:
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "include/faketypes.h"
+#include "include/init.h"
+#include "include/error.h"
+#include "include/audio.h"
+
+#include "include/sounds.h"
+
+/*
+ *  Internal macro definitions:
+ */
+
+#define FNV_OFFSET		2166136261UL
+#define FNV_PRIME		16777619UL
+
+/* Louder by this much for every extra request in the same frame */
+#define SOUND_BOOST		10
+
+/*
+ *  Internal type declarations:
+ */
+
+typedef struct
+{
+	char 	*name;
+	int 	retriggerMs;		/* Least time between two starts */
+} soundInfo;
+
+static unsigned long 	HashSoundName(char *name);
+static void 			BuildSoundHash(void);
+static long 			SoundClockMs(void);
+
+/*
+ *  Internal variable declarations:
+ */
+
+/* In SND_ id order. Short effects may repeat sooner than long ones. */
+static soundInfo soundTable[NUM_SOUNDS] =
+{
+	{ "Doh1",		100 },
+	{ "Doh2",		100 },
+	{ "Doh3",		100 },
+	{ "Doh4",		100 },
+	{ "ammo",		40 },
+	{ "applause",	100 },
+	{ "ball2ball",	40 },
+	{ "balllost",	100 },
+	{ "ballshot",	40 },
+	{ "boing",		40 },
+	{ "bomb",		40 },
+	{ "bonus",		100 },
+	{ "buzzer",		100 },
+	{ "click",		40 },
+	{ "ddloo",		100 },
+	{ "evillaugh",	100 },
+	{ "game_over",	100 },
+	{ "gate",		100 },
+	{ "hithere",	100 },
+	{ "hypspc",		100 },
+	{ "intro",		100 },
+	{ "key",		40 },
+	{ "looksbad",	100 },
+	{ "metal",		40 },
+	{ "mgun",		40 },
+	{ "ouch",		100 },
+	{ "paddle",		40 },
+	{ "ping",		40 },
+	{ "shark",		100 },
+	{ "shoot",		40 },
+	{ "shotgun",	40 },
+	{ "spring",		40 },
+	{ "stamp",		100 },
+	{ "sticky",		40 },
+	{ "supbons",	100 },
+	{ "toggle",		40 },
+	{ "tone",		100 },
+	{ "touch",		40 },
+	{ "wallsoff",	100 },
+	{ "warp",		100 },
+	{ "weeek",		100 },
+	{ "whizzo",		100 },
+	{ "whoosh",		100 },
+	{ "wzzz",		100 },
+	{ "wzzz2",		100 },
+	{ "youagod",	100 },
+};
+
+/* Id plus one of the sound in each slot, 0 if the slot is empty */
+static int 	soundHash[SOUND_HASH_SIZE];
+static int 	soundHashBuilt = False;
+
+/* This frame's batch, pendingVolume[id] is 0 unless the sound is in it */
+static int 	pending[NUM_SOUNDS];
+static int 	numPending = 0;
+static int 	pendingVolume[NUM_SOUNDS];
+static int 	pendingCount[NUM_SOUNDS];
+
+/* When each sound last started, -1 if it never has */
+static long lastStarted[NUM_SOUNDS];
+static int 	lastStartedSet = False;
+
+static unsigned long 	soundsAsked = 0UL, soundsStarted = 0UL;
+static unsigned long 	soundsMerged = 0UL, soundsTooSoon = 0UL;
+static unsigned long 	soundsOverBudget = 0UL;
+
+
+static unsigned long HashSoundName(char *name)
+{
+	unsigned long h = FNV_OFFSET;
+
+	while (*name != '\0')
+		h = ((h ^ (unsigned char) *name++) * FNV_PRIME) & 0xffffffffUL;
+
+	return h;
+}
+
+
+/**
+ * Puts every name in the table, stepping on to the next slot when one is
+ * taken.
+ *
+ */
+static void BuildSoundHash(void)
+{
+	unsigned long slot;
+	int id;
+
+	memset(soundHash, 0, sizeof(soundHash));
+
+	for (id = 0; id < NUM_SOUNDS; id++)
+	{
+		slot = HashSoundName(soundTable[id].name) & (SOUND_HASH_SIZE - 1);
+		while (soundHash[slot] != 0)
+			slot = (slot + 1) & (SOUND_HASH_SIZE - 1);
+
+		soundHash[slot] = id + 1;
+	}
+
+	soundHashBuilt = True;
+}
+
+
+int GetSoundId(char *name)
+{
+	unsigned long slot;
+	int id;
+
+	if (soundHashBuilt == False)
+		BuildSoundHash();
+
+	/* The table is never full so an empty slot always ends the search */
+	slot = HashSoundName(name) & (SOUND_HASH_SIZE - 1);
+	while ((id = soundHash[slot]) != 0)
+	{
+		if (!strcmp(soundTable[id - 1].name, name))
+			return id - 1;
+
+		slot = (slot + 1) & (SOUND_HASH_SIZE - 1);
+	}
+
+	return SND_NONE;
+}
+
+
+char *GetSoundName(int id)
+{
+	if (id < 0 || id >= NUM_SOUNDS)
+		return NULL;
+
+	return soundTable[id].name;
+}
+
+
+/**
+ * Returns a millisecond clock for the retrigger intervals. Only read once
+ * a frame.
+ *
+ */
+static long SoundClockMs(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (long) ts.tv_sec * 1000L + ts.tv_nsec / 1000000L;
+}
+
+
+void playSound(int id, int volume)
+{
+	if (id < 0 || id >= NUM_SOUNDS || volume <= 0)
+		return;
+
+	soundsAsked++;
+
+	/* Already asked for this frame, keep the loudest */
+	if (pendingVolume[id] > 0)
+	{
+		if (volume > pendingVolume[id])
+			pendingVolume[id] = volume;
+
+		pendingCount[id]++;
+		soundsMerged++;
+		return;
+	}
+
+	pending[numPending++] 	= id;
+	pendingVolume[id] 		= volume;
+	pendingCount[id] 		= 1;
+}
+
+
+void FlushSounds(void)
+{
+	int i, j, id, volume;
+	int started = 0;
+	long now;
+
+	if (numPending == 0)
+		return;
+
+	if (lastStartedSet == False)
+	{
+		for (i = 0; i < NUM_SOUNDS; i++)
+			lastStarted[i] = -1L;
+
+		lastStartedSet = True;
+	}
+
+	now = SoundClockMs();
+
+	/* Boost the repeated sounds then put the loudest first */
+	for (i = 0; i < numPending; i++)
+	{
+		id = pending[i];
+		pendingVolume[id] += SOUND_BOOST * (pendingCount[id] - 1);
+		if (pendingVolume[id] > 100)
+			pendingVolume[id] = 100;
+
+		for (j = i; j > 0 && pendingVolume[pending[j - 1]] < pendingVolume[id];
+			j--)
+			pending[j] = pending[j - 1];
+
+		pending[j] = id;
+	}
+
+	for (i = 0; i < numPending; i++)
+	{
+		id 		= pending[i];
+		volume 	= pendingVolume[id];
+
+		pendingVolume[id] = 0;
+
+		if (lastStarted[id] >= 0L && 
+			now - lastStarted[id] < (long) soundTable[id].retriggerMs)
+			soundsTooSoon++;
+		else if (started == SOUND_FRAME_BUDGET)
+			soundsOverBudget++;
+		else
+		{
+			startSound(id, volume);
+			lastStarted[id] = now;
+			soundsStarted++;
+			started++;
+		}
+	}
+
+	numPending = 0;
+}
+
+
+void ReportSoundStats(void)
+{
+	char str[160];
+
+	if (debug == False)
+		return;
+
+	sprintf(str, "Sounds asked for %lu, started %lu, merged %lu, "
+		"too soon %lu, over budget %lu.", soundsAsked, soundsStarted, 
+		soundsMerged, soundsTooSoon, soundsOverBudget);
+	NormalMessage(str);
+}
@@ -56,6 +56,7 @@
 #include "level.h"
 #include "score.h"
 #include "paddle.h"
+#include "hud.h"
 
 #include "special.h"
 
@@ -65,6 +66,16 @@
 
 #define GAP			5
 
+/* Bits for the specials that are lit, see DrawSpecials() */
+#define LIT_REVERSE		(1 << 0)
+#define LIT_STICKY		(1 << 1)
+#define LIT_SAVE		(1 << 2)
+#define LIT_FASTGUN		(1 << 3)
+#define LIT_NOWALL		(1 << 4)
+#define LIT_KILLER		(1 << 5)
+#define LIT_X2			(1 << 6)
+#define LIT_X4			(1 << 7)
+
 /*
  *  Internal variable declarations:
  */
@@ -206,11 +217,36 @@ void ToggleWallsOn(Display *display, int state)
 }
 
 /**
- * @brief Draws graphical elements of specials
+ * @brief Shows which specials are on in the specials panel
+ *
+ * The panel is drawn at the end of the frame, and only if a special has
+ * come on or gone off since it was last drawn, see FlushHud().
  * 
  * @param display The current display of the X11 window
  */
 void DrawSpecials(Display *display)
+{
+	int lit = 0;
+
+	if (reverseOn == True) 	lit |= LIT_REVERSE;
+	if (stickyBat == True) 	lit |= LIT_STICKY;
+	if (saving == True) 	lit |= LIT_SAVE;
+	if (fastGun == True) 	lit |= LIT_FASTGUN;
+	if (noWalls == True) 	lit |= LIT_NOWALL;
+	if (Killer == True) 	lit |= LIT_KILLER;
+	if (x2Bonus == True) 	lit |= LIT_X2;
+	if (x4Bonus == True) 	lit |= LIT_X4;
+
+	SetHudSpecials(lit);
+}
+
+/**
+ * @brief Draws graphical elements of specials
+ * 
+ * @param display The current display of the X11 window
+ * @param lit The specials to draw lit up, as DrawSpecials() makes them
+ */
+void RenderSpecials(Display *display, int lit)
 {
 	int y = 3;
 	int x = 5;
@@ -220,7 +256,7 @@ void DrawSpecials(Display *display)
 	/*XClearWindow(display, specialWindow);*/
 
 	strcpy(string, "Reverse");
-	if (reverseOn == True)
+	if (lit & LIT_REVERSE)
 		DrawShadowText(display, specialWindow, copyFont, 
 			string, x, y, yellow);
 	else
@@ -230,7 +266,7 @@ void DrawSpecials(Display *display)
 	y += copyFont->ascent + GAP;
 
 	strcpy(string, "Sticky");
-	if (stickyBat == True)
+	if (lit & LIT_STICKY)
 		DrawShadowText(display, specialWindow, copyFont, 
 			string, x, y, yellow);
 	else
@@ -240,7 +276,7 @@ void DrawSpecials(Display *display)
 	x = 55; y = 3;
 
 	strcpy(string, "Save");
-	if (saving == True)
+	if (lit & LIT_SAVE)
 		DrawShadowText(display, specialWindow, copyFont, 
 			string, x, y, yellow);
 	else
@@ -250,7 +286,7 @@ void DrawSpecials(Display *display)
 	y += copyFont->ascent + GAP;
 
 	strcpy(string, "FastGun");
-	if (fastGun == True)
+	if (lit & LIT_FASTGUN)
 		DrawShadowText(display, specialWindow, copyFont, 
 			string, x, y, yellow);
 	else
@@ -260,7 +296,7 @@ void DrawSpecials(Display *display)
 	x = 110; y = 3;
 
 	strcpy(string, "NoWall");
-	if (noWalls == True)
+	if (lit & LIT_NOWALL)
 		DrawShadowText(display, specialWindow, copyFont, 
 			string, x, y, yellow);
 	else
@@ -270,7 +306,7 @@ void DrawSpecials(Display *display)
 	y += copyFont->ascent + GAP;
 
 	strcpy(string, "Killer");
-	if (Killer == True)
+	if (lit & LIT_KILLER)
 		DrawShadowText(display, specialWindow, copyFont, 
 			string, x, y, yellow);
 	else
@@ -280,7 +316,7 @@ void DrawSpecials(Display *display)
 	x = 155; y = 3;
 
 	strcpy(string, "x2");
-	if (x2Bonus == True)
+	if (lit & LIT_X2)
 		DrawShadowText(display, specialWindow, copyFont, 
 			string, x, y, yellow);
 	else
@@ -290,7 +326,7 @@ void DrawSpecials(Display *display)
 	y += copyFont->ascent + GAP;
 
 	strcpy(string, "x4");
-	if (x4Bonus == True)
+	if (lit & LIT_X4)
 		DrawShadowText(display, specialWindow, copyFont, 
 			string, x, y, yellow);
 	else
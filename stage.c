@@ -84,6 +84,9 @@
 #include "dialogue.h"
 #include "version.h"
 #include "init.h"
+#include "atlas.h"
+#include "pack.h"
+#include "loader.h"
 
 #include "stage.h"
 
@@ -103,11 +106,14 @@
 #define	DEVILEYE_WC			(DEVILEYE_WIDTH / 2)
 #define	DEVILEYE_HC			(DEVILEYE_HEIGHT / 2)
 
+#define NUM_BACKGROUNDS		7
+
 /*
  *  Internal type declarations:
  */
 
 static Window SetWMIcon(Display *display);
+static Texture2D UploadBackground(int i, char *name);
 
 /*
  *  Internal variable declarations:
@@ -127,62 +133,92 @@ Window 	blockWindow;
 Window 	typeWindow;
 Texture2D mainBackPixmap, iconPixmap, spacePixmap;
 Texture2D back1Pixmap, back2Pixmap, back3Pixmap, back4Pixmap, back5Pixmap;
-Texture2D devilblink[6];
+int 	devilblink[6];
 int 	devilx, devily;
 int 	blinkslides[] = { 0, 1, 2, 3, 4, 5, 5, 4, 3, 2, 1, 0, 0, 0, 
 					      0, 1, 2, 3, 4, 5, 5, 4, 3, 2, 1, 0 };
 
+/* Background images, decoded by the loader threads until they are uploaded */
+static char 	*backgroundFiles[NUM_BACKGROUNDS] = {
+	"bitmaps/bgrnds/mnbgrnd.png", 	"bitmaps/bgrnds/space.png",
+	"bitmaps/bgrnds/bgrnd.png", 	"bitmaps/bgrnds/bgrnd2.png",
+	"bitmaps/bgrnds/bgrnd3.png", 	"bitmaps/bgrnds/bgrnd4.png",
+	"bitmaps/bgrnds/bgrnd5.png" };
+static Image 	backgroundImages[NUM_BACKGROUNDS];
+static int 		backgroundsQueued = False;
+
 
 /**
- * @brief Initializes the main background texture and various other textures.
- * 
- * Creates the main background texture along with several other background textures,
- * including the devil blink animation frames.
+ * @brief Queues the background images to be decoded by the loader threads
  */
-void InitialiseMainBackPixmap(){
+void QueueBackgroundImages(void)
+{
+	int i;
 
-	/* Create the playfield background textures */
+	for (i = 0; i < NUM_BACKGROUNDS; i++)
+		QueueImage("stage", backgroundFiles[i], &backgroundImages[i]);
+
+	backgroundsQueued = True;
+}
+
+/**
+ * @brief Makes a texture from a decoded background image and drops the image
+ *
+ * @param i Index into backgroundFiles
+ * @param name Texture name for the error message
+ */
+static Texture2D UploadBackground(int i, char *name)
+{
+	Texture2D texture;
 
-	mainBackPixmap = LoadTexture("bitmaps/bgrnds/mnbgrnd.png");
-	HandleXPMError(mainBackPixmap, "mainBackPixmap");
+	texture = LoadTextureFromImage(backgroundImages[i]);
+	HandleXPMError(texture, name);
 
-	spacePixmap = LoadTexture("bitmaps/bgrnds/space.png");
-	HandleXPMError(spacePixmap, "spacePixmap");
-	
-	back1Pixmap = LoadTexture("bitmaps/bgrnds/bgrnd.png");
-	HandleXPMError(back1Pixmap, "back1Pixmap");
+	if (backgroundImages[i].data != NULL)
+		UnloadPackedImage(backgroundImages[i]);
 
-	back2Pixmap = LoadTexture("bitmaps/bgrnds/bgrnd2.png");
-	HandleXPMError(back2Pixmap, "back2Pixmap");
+	return texture;
+}
 
-	back3Pixmap = LoadTexture("bitmaps/bgrnds/bgrnd3.png");
-	HandleXPMError(back3Pixmap, "back3Pixmap");
 
-	back4Pixmap = LoadTexture("bitmaps/bgrnds/bgrnd4.png");
-	HandleXPMError(back4Pixmap, "back4Pixmap");
+/**
+ * @brief Initializes the main background texture and various other textures.
+ * 
+ * Creates the main background texture along with several other background textures,
+ * and looks up the devil blink animation frames in the sprite atlas.
+ */
+void InitialiseMainBackPixmap(){
+
+	/* Decoded on the loader threads if they were queued early enough */
+	if (backgroundsQueued == False)
+		QueueBackgroundImages();
 
-	back5Pixmap = LoadTexture("bitmaps/bgrnds/bgrnd5.png");
-	HandleXPMError(back5Pixmap, "back5Pixmap");
+	FinishImageDecode();
 
-	/* Devil blink animation */
+	/* Create the playfield background textures */
 
-	devilblink[0] = LoadTexture("bitmaps/eyes/deveyes.png");
-	HandleXPMError(devilblink[0], "devilblink[0]");
+	BeginLoadTiming("stage");
 
-	devilblink[1] = LoadTexture("bitmaps/eyes/deveyes1.png");
-	HandleXPMError(devilblink[1], "devilblink[1]");
+	mainBackPixmap 	= UploadBackground(0, "mainBackPixmap");
+	spacePixmap 	= UploadBackground(1, "spacePixmap");
+	back1Pixmap 	= UploadBackground(2, "back1Pixmap");
+	back2Pixmap 	= UploadBackground(3, "back2Pixmap");
+	back3Pixmap 	= UploadBackground(4, "back3Pixmap");
+	back4Pixmap 	= UploadBackground(5, "back4Pixmap");
+	back5Pixmap 	= UploadBackground(6, "back5Pixmap");
 
-	devilblink[2] = LoadTexture("bitmaps/eyes/deveyes2.png");
-	HandleXPMError(devilblink[2], "devilblink[2]");
+	EndLoadTiming();
 
-	devilblink[3] = LoadTexture("bitmaps/eyes/deveyes3.png");
-	HandleXPMError(devilblink[3], "devilblink[3]");
+	backgroundsQueued = False;
 
-	devilblink[4] = LoadTexture("bitmaps/eyes/deveyes4.png");
-	HandleXPMError(devilblink[4], "devilblink[4]");
+	/* Devil blink animation, packed by InitialiseAtlas() */
 
-	devilblink[5] = LoadTexture("bitmaps/eyes/deveyes5.png");
-	HandleXPMError(devilblink[5], "devilblink[5]");
+	devilblink[0] = GetSprite("eyes/deveyes");
+	devilblink[1] = GetSprite("eyes/deveyes1");
+	devilblink[2] = GetSprite("eyes/deveyes2");
+	devilblink[3] = GetSprite("eyes/deveyes3");
+	devilblink[4] = GetSprite("eyes/deveyes4");
+	devilblink[5] = GetSprite("eyes/deveyes5");
 }
 
 /**
@@ -437,6 +473,33 @@ void MapAllWindows(Display *display)
 	XFlush(display);
 }
 
+/**
+ * @brief Finds where a window's contents start inside the main window.
+ * 
+ * Works from the same positions and borders CreateAllWindows() uses, for
+ * drawing that does not go through the window itself. Only the play area
+ * and the input dialogue are known, anything else is taken as the play
+ * area.
+ *
+ * @param window The window to look up.
+ * @param x Set to the left edge of the window's contents.
+ * @param y Set to the top edge of the window's contents.
+ */
+void GetWindowOrigin(Window window, int *x, int *y)
+{
+	if (window == inputWindow)
+	{
+		/* Centred over the whole stage with a 4 pixel border */
+		*x = ((PLAY_WIDTH + MAIN_WIDTH) / 2) - (DIALOGUE_WIDTH / 2) + 4;
+		*y = ((PLAY_HEIGHT + MAIN_HEIGHT) / 2) - (DIALOGUE_HEIGHT / 2) + 4;
+		return;
+	}
+
+	/* The play and buffer windows sit together with a 2 pixel border */
+	*x = (MAIN_WIDTH / 2) + 2;
+	*y = 60 + 2;
+}
+
 /**
  * @brief Redraws the play window.
  * 
@@ -458,15 +521,12 @@ void RedrawPlayWindow(Display *display, Window window)
 /**
  * @brief Frees all background pixmaps.
  * 
- * Frees all pixmaps that were allocated for backgrounds, the icon, and devil blink
- * animations.
+ * Frees all pixmaps that were allocated for backgrounds and the icon.
  *
  * @param display The X11 display connection.
  */
 void FreeBackgroundPixmaps(Display *display)
 {
-	int i;
-
 	/* Free all the backgound pixmaps */
     if (back1Pixmap)	XFreePixmap(display, back1Pixmap); 
 	if (back2Pixmap)	XFreePixmap(display, back2Pixmap);
@@ -479,12 +539,7 @@ void FreeBackgroundPixmaps(Display *display)
     if (mainBackPixmap)	XFreePixmap(display, mainBackPixmap); 
     if (spacePixmap)	XFreePixmap(display, spacePixmap); 
 
-	for (i = 0; i < 6; i++)
-	{
-		/* Free all devil blink eyes */
-		if (devilblink[i])	XFreePixmap(display, devilblink[i]); 
-		//if (devilblinkM[i])	XFreePixmap(display, devilblinkM[i]); 
-	}
+	/* The devil blink eyes live in the sprite atlas, see FreeAtlas() */
 }
 
 /**
@@ -513,7 +568,7 @@ static Window SetWMIcon(Display *display){
 
 	/* Load icon texture */
 
-	iconPixmap = LoadTexture("bitmaps/icon.png");
+	iconPixmap = LoadPackedTexture("bitmaps/icon.png");
 	HandleXPMError(iconPixmap, "iconPixmap");
 
 	return win;
@@ -619,7 +674,7 @@ void ClearDevilEyes(Display *display, Window window)
 static void DrawTheDevilEye(int x, int y, int slide){
 	
 	/* Draw a frame of the devil eyes */
-	DrawTexture(devilblink[slide], x - DEVILEYE_WC, y - DEVILEYE_HC, WHITE);
+	DrawSprite(devilblink[slide], x - DEVILEYE_WC, y - DEVILEYE_HC);
 }
 
 /**
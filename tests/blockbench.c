@@ -0,0 +1,359 @@
+/*
+ * XBoing - An X11 blockout style computer game
+ *
+ * (c) Copyright 1993, 1994, 1995, Justin C. Kibell, All Rights Reserved
+ *
+ * The X Consortium, and any party obtaining a copy of these files from
+ * the X Consortium, directly or indirectly, is granted, free of charge, a
+ * full and unrestricted irrevocable, world-wide, paid up, royalty-free,
+ * nonexclusive right and license to deal in this software and
+ * documentation files (the "Software"), including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons who receive
+ * copies from any such party to do so.  This license includes without
+ * limitation a license to do the foregoing actions under any patents of
+ * the party supplying this software to the X Consortium.
+ *
+ * In no event shall the author be liable to any party for direct, indirect,
+ * special, incidental, or consequential damages arising out of the use of
+ * this software and its documentation, even if the author has been advised
+ * of the possibility of such damage.
+ *
+ * The author specifically disclaims any warranties, including, but not limited
+ * to, the implied warranties of merchantability and fitness for a particular
+ * purpose.  The software provided hereunder is on an "AS IS" basis, and the
+ * author has no obligation to provide maintenance, support, updates,
+ * enhancements, or modifications.
+ */
+
+/*
+ * =========================================================================
+ *
+ * Block table layout microbenchmark.
+ *
+ * Links against the headless game core and loads every level the way a
+ * new game does, so blocks.c fills in both struct aBlock and the packed
+ * struct blockHot table. Each level's blocks are then copied into the
+ * block record as it was before the hot fields were split out, and the
+ * same stream of ball positions is pushed through the CheckRegions()
+ * probe of that time - nine neighbouring cells, reading the whole record
+ * - and through the probe ball.c uses now, which goes through the real
+ * IsBlockSolid() and GetBlockRect() accessors. Both use IsBlockOccupied()
+ * for the neighbour side filter just as the game does. The answers are
+ * compared so the run also proves the two agree.
+ *
+ *		make -f Makefile.headless blockbench
+ *		tests/blockbench [-queries <n>]
+ *
+ * =========================================================================
+ */
+
+/*
+ *  Include file dependencies:
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../include/faketypes.h"
+#include "../include/main.h"
+#include "../include/ball.h"
+#include "../include/blocks.h"
+#include "../include/blockhit.h"
+#include "../include/level.h"
+#include "../include/stage.h"
+#include "../include/headless.h"
+
+/*
+ *  Internal macro definitions:
+ */
+
+#define NUM_BALLS		4096
+#define DEF_QUERIES		20000000L
+
+/*
+ *  Internal type declarations:
+ */
+
+/* struct aBlock as it was before the hot fields were split out */
+struct oldBlock
+{
+	int     	occupied;
+	int         blockType;
+	int 		hitPoints;
+
+	int     	exploding;
+	int 		explodeStartFrame;
+	int 		explodeNextFrame;
+	int 		explodeSlide;
+
+	int     	currentFrame;
+	int     	nextFrame;
+	int     	lastFrame;
+
+	int			blockOffsetX;
+	int			blockOffsetY;
+	int			x;
+	int			y;
+	int         width;
+	int         height;
+
+	int 		counterSlide;
+	int 		bonusSlide;
+
+	int			random;
+	int			drop;
+	int     	specialPopup;
+	int 		explodeAll;
+
+	int 		ballHitIndex;
+	int			balldx;
+	int			balldy;
+};
+
+static long long 	GetNanoseconds(void);
+static void 		StartLevel(int levelNum);
+static void 		CopyOldBlocks(void);
+static int 			OldRegions(int row, int col, int x, int y);
+static int 			HotRegions(int row, int col, int x, int y);
+static int 			OldCollision(int x, int y);
+static int 			HotCollision(int x, int y);
+
+/*
+ *  Internal variable declarations:
+ */
+
+static struct oldBlock 	oldBlocks[MAX_ROW][MAX_COL];
+static int 				ballX[NUM_BALLS], ballY[NUM_BALLS];
+
+
+static long long GetNanoseconds(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (long long) ts.tv_sec * 1000000000LL + (long long) ts.tv_nsec;
+}
+
+static void StartLevel(int levelNum)
+{
+	/* Let handleGameMode() load the level as for a new game */
+	SetStartingLevel(levelNum);
+	gameActive 	= False;
+	mode 		= MODE_GAME;
+	SimulateGameFrame(NULL);
+}
+
+static void CopyOldBlocks(void)
+{
+	struct aBlock *bp;
+	struct oldBlock *op;
+	int r, c;
+
+	for (r = 0; r < MAX_ROW; r++)
+		for (c = 0; c < MAX_COL; c++)
+		{
+			bp = &blocks[r][c];
+			op = &oldBlocks[r][c];
+
+			op->occupied 			= bp->occupied;
+			op->blockType 			= bp->blockType;
+			op->hitPoints 			= bp->hitPoints;
+			op->exploding 			= bp->exploding;
+			op->explodeStartFrame 	= bp->explodeStartFrame;
+			op->explodeNextFrame 	= bp->explodeNextFrame;
+			op->explodeSlide 		= bp->explodeSlide;
+			op->currentFrame 		= bp->currentFrame;
+			op->nextFrame 			= bp->nextFrame;
+			op->lastFrame 			= bp->lastFrame;
+			op->blockOffsetX 		= bp->blockOffsetX;
+			op->blockOffsetY 		= bp->blockOffsetY;
+			op->x 					= bp->x;
+			op->y 					= bp->y;
+			op->width 				= bp->width;
+			op->height 				= bp->height;
+			op->counterSlide 		= bp->counterSlide;
+			op->bonusSlide 			= bp->bonusSlide;
+			op->random 				= bp->random;
+			op->drop 				= bp->drop;
+			op->specialPopup 		= bp->specialPopup;
+			op->explodeAll 			= bp->explodeAll;
+			op->ballHitIndex 		= bp->ballHitIndex;
+			op->balldx 				= bp->balldx;
+			op->balldy 				= bp->balldy;
+		}
+}
+
+static int OldRegions(int row, int col, int x, int y)
+{
+	struct oldBlock *blockP;
+	int region = REGION_NONE;
+	int hit;
+
+	if (row < 0 || row >= MAX_ROW) return REGION_NONE;
+	if (col < 0 || col >= MAX_COL) return REGION_NONE;
+
+	/* CheckRegions() as it was, with the whole record in hand */
+	blockP = &oldBlocks[row][col];
+
+	if (blockP->occupied == 1 && blockP->exploding == False)
+	{
+		hit = BlockRegionHit(blockP->x, blockP->y, blockP->width,
+			blockP->height, x - BALL_WC, y - BALL_HC, BALL_WIDTH, BALL_HEIGHT);
+
+		if ((hit & REGION_LEFT) && IsBlockOccupied(row, col-1) == False)
+			region |= REGION_LEFT;
+		if ((hit & REGION_RIGHT) && IsBlockOccupied(row, col+1) == False)
+			region |= REGION_RIGHT;
+		if ((hit & REGION_BOTTOM) && IsBlockOccupied(row+1, col) == False)
+			region |= REGION_BOTTOM;
+		if ((hit & REGION_TOP) && IsBlockOccupied(row-1, col) == False)
+			region |= REGION_TOP;
+	}
+
+	return region;
+}
+
+static int HotRegions(int row, int col, int x, int y)
+{
+	int region = REGION_NONE;
+	int hit, bx, by, bw, bh;
+
+	if (row < 0 || row >= MAX_ROW) return REGION_NONE;
+	if (col < 0 || col >= MAX_COL) return REGION_NONE;
+
+	/* CheckRegions() as it is now, through the blocks.h accessors */
+	if (IsBlockSolid(row, col) == True)
+	{
+		GetBlockRect(row, col, &bx, &by, &bw, &bh);
+
+		hit = BlockRegionHit(bx, by, bw, bh, 
+			x - BALL_WC, y - BALL_HC, BALL_WIDTH, BALL_HEIGHT);
+
+		if ((hit & REGION_LEFT) && IsBlockOccupied(row, col-1) == False)
+			region |= REGION_LEFT;
+		if ((hit & REGION_RIGHT) && IsBlockOccupied(row, col+1) == False)
+			region |= REGION_RIGHT;
+		if ((hit & REGION_BOTTOM) && IsBlockOccupied(row+1, col) == False)
+			region |= REGION_BOTTOM;
+		if ((hit & REGION_TOP) && IsBlockOccupied(row-1, col) == False)
+			region |= REGION_TOP;
+	}
+
+	return region;
+}
+
+static int OldCollision(int x, int y)
+{
+	int row = y / rowHeight, col = x / colWidth, ret;
+
+	/* Same probe order as CheckForCollision() */
+	if ((ret = OldRegions(row, col, x, y)) != REGION_NONE) 		 return ret;
+	if ((ret = OldRegions(row+1, col, x, y)) != REGION_NONE) 	 return ret;
+	if ((ret = OldRegions(row-1, col, x, y)) != REGION_NONE) 	 return ret;
+	if ((ret = OldRegions(row, col+1, x, y)) != REGION_NONE) 	 return ret;
+	if ((ret = OldRegions(row, col-1, x, y)) != REGION_NONE) 	 return ret;
+	if ((ret = OldRegions(row+1, col+1, x, y)) != REGION_NONE) return ret;
+	if ((ret = OldRegions(row-1, col-1, x, y)) != REGION_NONE) return ret;
+	if ((ret = OldRegions(row+1, col-1, x, y)) != REGION_NONE) return ret;
+	return OldRegions(row-1, col+1, x, y);
+}
+
+static int HotCollision(int x, int y)
+{
+	int row = y / rowHeight, col = x / colWidth, ret;
+
+	if ((ret = HotRegions(row, col, x, y)) != REGION_NONE) 		 return ret;
+	if ((ret = HotRegions(row+1, col, x, y)) != REGION_NONE) 	 return ret;
+	if ((ret = HotRegions(row-1, col, x, y)) != REGION_NONE) 	 return ret;
+	if ((ret = HotRegions(row, col+1, x, y)) != REGION_NONE) 	 return ret;
+	if ((ret = HotRegions(row, col-1, x, y)) != REGION_NONE) 	 return ret;
+	if ((ret = HotRegions(row+1, col+1, x, y)) != REGION_NONE) return ret;
+	if ((ret = HotRegions(row-1, col-1, x, y)) != REGION_NONE) return ret;
+	if ((ret = HotRegions(row+1, col-1, x, y)) != REGION_NONE) return ret;
+	return HotRegions(row-1, col+1, x, y);
+}
+
+int main(int argc, char **argv)
+{
+	long queries = DEF_QUERIES, perLevel, n, mismatches = 0L, hits = 0L;
+	unsigned long sumOld = 0UL, sumHot = 0UL;
+	long long t0, oldNs = 0LL, hotNs = 0LL;
+	int i, l, r;
+
+	for (i = 1; i < argc; i++)
+	{
+		if (!strcmp(argv[i], "-queries") && i + 1 < argc &&
+			atol(argv[i + 1]) > 0)
+			queries = atol(argv[++i]);
+		else
+		{
+			fprintf(stderr, "Usage: blockbench [-queries <n>]\n");
+			exit(1);
+		}
+	}
+
+	SetGameSpeed(FAST_SPEED);
+	SetupBlockInfo();
+
+	/* Ball centres anywhere in the part of the arena blocks can be in */
+	srand(1);
+	for (i = 0; i < NUM_BALLS; i++)
+	{
+		ballX[i] = BALL_WC + rand() % (PLAY_WIDTH - BALL_WIDTH);
+		ballY[i] = BALL_HC + rand() % ((MAX_ROW - 2) * (PLAY_HEIGHT / MAX_ROW));
+	}
+
+	perLevel = queries / MAX_NUM_LEVELS;
+	if (perLevel < 1L) perLevel = 1L;
+
+	for (l = 1; l <= MAX_NUM_LEVELS; l++)
+	{
+		StartLevel(l);
+		CopyOldBlocks();
+
+		/* Both layouts must give the same answer for every ball */
+		for (i = 0; i < NUM_BALLS; i++)
+		{
+			r = HotCollision(ballX[i], ballY[i]);
+			if (OldCollision(ballX[i], ballY[i]) != r)
+				mismatches++;
+			if (r != REGION_NONE)
+				hits++;
+		}
+
+		t0 = GetNanoseconds();
+		for (n = 0; n < perLevel; n++)
+		{
+			i = (int) (n % NUM_BALLS);
+			sumOld += OldCollision(ballX[i], ballY[i]);
+		}
+		oldNs += GetNanoseconds() - t0;
+
+		t0 = GetNanoseconds();
+		for (n = 0; n < perLevel; n++)
+		{
+			i = (int) (n % NUM_BALLS);
+			sumHot += HotCollision(ballX[i], ballY[i]);
+		}
+		hotNs += GetNanoseconds() - t0;
+	}
+
+	queries = perLevel * MAX_NUM_LEVELS;
+
+	fprintf(stdout, "%d levels, %ld of %ld probes hit a block\n",
+		MAX_NUM_LEVELS, hits, (long) MAX_NUM_LEVELS * NUM_BALLS);
+	fprintf(stdout, "struct aBlock  %4d bytes/cell %6d bytes/level "
+		"%8.1f ns/query\n", (int) sizeof(struct oldBlock),
+		(int) sizeof(oldBlocks), (double) oldNs / (double) queries);
+	fprintf(stdout, "blockHot       %4d bytes/cell %6d bytes/level "
+		"%8.1f ns/query\n", (int) sizeof(struct blockHot) / GRID_CELLS,
+		(int) sizeof(struct blockHot), (double) hotNs / (double) queries);
+	fprintf(stdout, "speedup %.2fx, %ld mismatches, checksum %s\n",
+		(hotNs > 0LL) ? (double) oldNs / (double) hotNs : 0.0, mismatches,
+		(sumOld == sumHot) ? "ok" : "BAD");
+
+	exit((mismatches == 0L && sumOld == sumHot) ? 0 : 1);
+}
@@ -0,0 +1,306 @@
+/*
+ * XBoing - An X11 blockout style computer game
+ *
+ * (c) Copyright 1993, 1994, 1995, Justin C. Kibell, All Rights Reserved
+ *
+ * The X Consortium, and any party obtaining a copy of these files from
+ * the X Consortium, directly or indirectly, is granted, free of charge, a
+ * full and unrestricted irrevocable, world-wide, paid up, royalty-free,
+ * nonexclusive right and license to deal in this software and
+ * documentation files (the "Software"), including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons who receive
+ * copies from any such party to do so.  This license includes without
+ * limitation a license to do the foregoing actions under any patents of
+ * the party supplying this software to the X Consortium.
+ *
+ * In no event shall the author be liable to any party for direct, indirect,
+ * special, incidental, or consequential damages arising out of the use of
+ * this software and its documentation, even if the author has been advised
+ * of the possibility of such damage.
+ *
+ * The author specifically disclaims any warranties, including, but not limited
+ * to, the implied warranties of merchantability and fitness for a particular
+ * purpose.  The software provided hereunder is on an "AS IS" basis, and the
+ * author has no obligation to provide maintenance, support, updates,
+ * enhancements, or modifications.
+ */
+
+/*
+ * =========================================================================
+ *
+ * Ball and bullet physics microbenchmark.
+ *
+ * Links against the headless game core and, for every level in levels/
+ * and every speed 1 to 9, loads the level, fires the same scripted balls
+ * and runs the game tick by tick with the paddle following the balls and
+ * a bullet fired every few ticks. Only the physics part of each tick is
+ * timed - HandleBallMode(), HandleBulletMode() and the block explosion
+ * and animation handlers - so the numbers cover UpdateABall(),
+ * CheckForCollision(), HandleTheBlocks() and UpdateBullet(). Whenever the
+ * balls are all lost or the level is cleared the level is loaded again,
+ * outside the timing.
+ *
+ * Output is one tab separated line per level and speed, plus an "all"
+ * line per speed, after a header line naming the columns:
+ *
+ *	level speed ticks ball_updates ns_per_update queries_per_tick
+ *	p50_ns p99_ns
+ *
+ *		make -f Makefile.headless physbench
+ *		tests/physbench [-ticks <n>] [-start <n>] [-end <n>] [-sweep]
+ *
+ * =========================================================================
+ */
+
+/*
+ *  Include file dependencies:
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../include/faketypes.h"
+#include "../include/main.h"
+#include "../include/ball.h"
+#include "../include/blocks.h"
+#include "../include/gun.h"
+#include "../include/level.h"
+#include "../include/stage.h"
+#include "../include/headless.h"
+#include "../include/rng.h"
+
+/*
+ *  Internal macro definitions:
+ */
+
+#define NUM_SPEEDS		9
+#define DEF_TICKS		1000
+#define MAX_TICKS		100000
+#define SHOT_PERIOD		25		/* Ticks between scripted bullets */
+#define NUM_SHOTS		4		/* Balls fired at the start of each run */
+
+/*
+ *  Internal type declarations:
+ */
+
+static long long 	GetNanoseconds(void);
+static int 			CompareTicks(const void *a, const void *b);
+static void 		PrintBenchUsage(void);
+static void 		StartLevel(int levelNum);
+static void 		FireBalls(void);
+static int 			BallsInPlay(void);
+static void 		BenchLevel(int levelNum, int speed, int ticks);
+static void 		PrintResult(char *level, int speed, long ticks,
+						unsigned long updates, unsigned long queries,
+						long long ballNs, long long *tickNs);
+
+/*
+ *  Internal variable declarations:
+ */
+
+/* Where the scripted balls start and the way they head off */
+static int shotX[NUM_SHOTS] 	= { 100, 200, 300, 400 };
+static int shotDx[NUM_SHOTS] 	= { -3, 2, 5, -6 };
+static int shotDy[NUM_SHOTS] 	= { -5, -6, -3, -2 };
+
+static long long 		tickTimes[MAX_TICKS];
+static long long 		speedTimes[NUM_SPEEDS][MAX_TICKS];
+static long 			speedCount[NUM_SPEEDS];
+static unsigned long 	speedUpdates[NUM_SPEEDS], speedQueries[NUM_SPEEDS];
+static long long 		speedBallNs[NUM_SPEEDS];
+
+
+static long long GetNanoseconds(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (long long) ts.tv_sec * 1000000000LL + (long long) ts.tv_nsec;
+}
+
+static int CompareTicks(const void *a, const void *b)
+{
+	long long x = *(const long long *) a;
+	long long y = *(const long long *) b;
+
+	return (x > y) - (x < y);
+}
+
+static void PrintBenchUsage(void)
+{
+	fprintf(stderr, "%s%s\n",
+		"Usage: physbench [-ticks <n>] [-start <1-MAX>] [-end <1-MAX>] ",
+		"[-sweep]");
+	exit(1);
+}
+
+static void StartLevel(int levelNum)
+{
+	/* Let handleGameMode() load the level as for a new game */
+	SetStartingLevel(levelNum);
+	gameActive 	= False;
+	mode 		= MODE_GAME;
+	SimulateGameFrame(NULL);
+}
+
+static void FireBalls(void)
+{
+	int j, i;
+
+	/* Replace whatever is left with the scripted balls, already moving */
+	ClearAllBalls();
+	SetLivesLeft(3);
+
+	for (j = 0; j < NUM_SHOTS; j++)
+	{
+		i = AddANewBall(NULL, shotX[j], PLAY_HEIGHT - 80, 
+			shotDx[j], shotDy[j]);
+
+		if (i >= 0)
+			ChangeBallMode(BALL_ACTIVE, i);
+	}
+}
+
+static int BallsInPlay(void)
+{
+	int i, n = 0;
+
+	for (i = 0; i < MAX_BALLS; i++)
+		if (balls[i].active == True && balls[i].ballState == BALL_ACTIVE)
+			n++;
+
+	return n;
+}
+
+static void BenchLevel(int levelNum, int speed, int ticks)
+{
+	unsigned long updates, queries;
+	long long t0, t1, t2, ballNs = 0LL;
+	char name[8];
+	int n;
+
+	/* Same balls every run, moving at this warp speed */
+	SeedGameRandom(1UL);
+	SetUserSpeed(10 - speed);
+	StartLevel(levelNum);
+	FireBalls();
+	ResetBallStats();
+
+	for (n = 0; n < ticks; n++)
+	{
+		/* Start over if the balls are gone or the level is finished */
+		if (mode != MODE_GAME)
+		{
+			StartLevel(levelNum);
+			FireBalls();
+		}
+		else if (BallsInPlay() == 0)
+			FireBalls();
+
+		frame++;
+		HeadlessTrackBall();
+
+		if ((n % SHOT_PERIOD) == 0)
+		{
+			SetNumberBullets(4);
+			shootBullet(NULL, playWindow);
+		}
+
+		t0 = GetNanoseconds();
+		HandleBallMode(NULL, playWindow);
+		t1 = GetNanoseconds();
+		HandleBulletMode(NULL, playWindow);
+		ExplodeBlocksPending(NULL, playWindow);
+		HandlePendingAnimations(NULL, playWindow);
+		t2 = GetNanoseconds();
+
+		ballNs 		+= (t1 - t0);
+		tickTimes[n] = (t2 - t0);
+		speedTimes[speed - 1][speedCount[speed - 1]++] = (t2 - t0);
+
+		/* Pick up a level cleared or lost in this tick */
+		if (mode == MODE_GAME)
+			CheckGameRules(NULL, playWindow);
+	}
+
+	GetBallStats(&updates, &queries);
+
+	speedUpdates[speed - 1] += updates;
+	speedQueries[speed - 1] += queries;
+	speedBallNs[speed - 1] 	+= ballNs;
+
+	sprintf(name, "%02d", levelNum);
+	PrintResult(name, speed, (long) ticks, updates, queries, ballNs, 
+		tickTimes);
+}
+
+static void PrintResult(char *level, int speed, long ticks,
+	unsigned long updates, unsigned long queries, long long ballNs,
+	long long *tickNs)
+{
+	/* Sorts tickNs in place for the percentiles */
+	qsort(tickNs, (size_t) ticks, sizeof(long long), CompareTicks);
+
+	fprintf(stdout, "%s\t%d\t%ld\t%lu\t%.1f\t%.3f\t%lld\t%lld\n",
+		level, speed, ticks, updates,
+		updates > 0UL ? (double) ballNs / (double) updates : 0.0,
+		(double) queries / (double) ticks,
+		tickNs[ticks / 2], tickNs[(ticks * 99) / 100]);
+}
+
+
+int main(int argc, char **argv)
+{
+	int i, l, s;
+	int start = 1, end = MAX_NUM_LEVELS, ticks = DEF_TICKS;
+
+	for (i = 1; i < argc; i++)
+	{
+		if (!strcmp(argv[i], "-sweep"))
+		{
+			SetBallCollisionMode(COLLIDE_SWEPT);
+			continue;
+		}
+
+		if (i + 1 >= argc)
+			PrintBenchUsage();
+
+		l = atoi(argv[i + 1]);
+
+		if (!strcmp(argv[i], "-ticks") && l > 0)
+			ticks = l;
+		else if (!strcmp(argv[i], "-start") && l > 0 && l <= MAX_NUM_LEVELS)
+			start = l;
+		else if (!strcmp(argv[i], "-end") && l > 0 && l <= MAX_NUM_LEVELS)
+			end = l;
+		else
+			PrintBenchUsage();
+
+		i++;
+	}
+
+	/* Every tick of every level at one speed has to fit for the summary */
+	if (ticks * (end - start + 1) > MAX_TICKS)
+		ticks = MAX_TICKS / (end - start + 1);
+
+	SetGameSpeed(FAST_SPEED);
+	SetPaddleControlMode(CONTROL_MOUSE);
+	SetupBlockInfo();
+
+	fprintf(stdout, "level\tspeed\tticks\tball_updates\tns_per_update\t"
+		"queries_per_tick\tp50_ns\tp99_ns\n");
+
+	for (l = start; l <= end; l++)
+		for (s = 1; s <= NUM_SPEEDS; s++)
+			BenchLevel(l, s, ticks);
+
+	/* Every level together at each speed */
+	for (s = 1; s <= NUM_SPEEDS; s++)
+		PrintResult("all", s, speedCount[s - 1], speedUpdates[s - 1], 
+			speedQueries[s - 1], speedBallNs[s - 1], speedTimes[s - 1]);
+
+	exit(0);
+}
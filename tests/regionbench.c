@@ -0,0 +1,238 @@
+/*
+ * XBoing - An X11 blockout style computer game
+ *
+ * (c) Copyright 1993, 1994, 1995, Justin C. Kibell, All Rights Reserved
+ *
+ * The X Consortium, and any party obtaining a copy of these files from
+ * the X Consortium, directly or indirectly, is granted, free of charge, a
+ * full and unrestricted irrevocable, world-wide, paid up, royalty-free,
+ * nonexclusive right and license to deal in this software and
+ * documentation files (the "Software"), including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons who receive
+ * copies from any such party to do so.  This license includes without
+ * limitation a license to do the foregoing actions under any patents of
+ * the party supplying this software to the X Consortium.
+ *
+ * In no event shall the author be liable to any party for direct, indirect,
+ * special, incidental, or consequential damages arising out of the use of
+ * this software and its documentation, even if the author has been advised
+ * of the possibility of such damage.
+ *
+ * The author specifically disclaims any warranties, including, but not limited
+ * to, the implied warranties of merchantability and fitness for a particular
+ * purpose.  The software provided hereunder is on an "AS IS" basis, and the
+ * author has no obligation to provide maintenance, support, updates,
+ * enhancements, or modifications.
+ */
+
+/*
+ * =========================================================================
+ *
+ * Ball to block collision microbenchmark.
+ *
+ * Builds the four XPolygonRegion() triangles for every block size the game
+ * uses, exactly as CalculateBlockGeometry() used to, then times the same
+ * stream of ball sized rectangles through XRectInRegion() and through
+ * BlockRegionHit(). Every answer is compared so the run also proves the
+ * two agree. Only the client side of Xlib is used - no display is opened.
+ *
+ *		make -f Makefile.headless regionbench
+ *		tests/regionbench [-queries <n>]
+ *
+ * =========================================================================
+ */
+
+/*
+ *  Include file dependencies:
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <X11/Xlib.h>
+#include <X11/Xutil.h>
+
+#include "../include/blockhit.h"
+
+/*
+ *  Internal macro definitions:
+ */
+
+/* Same as ball.h - kept here so the X headers never meet faketypes.h */
+#define BALL_WIDTH		20
+#define BALL_HEIGHT		19
+
+#define NUM_SIZES		13
+#define NUM_RECTS		4096
+#define DEF_QUERIES		4000000L
+
+/*
+ *  Internal type declarations:
+ */
+
+typedef struct
+{
+	int 	x, y, width, height;
+	Region 	top, bottom, left, right;
+} benchBlock;
+
+static double 	GetSeconds(void);
+static Region 	MakeTriangle(int x0, int y0, int x1, int y1, int x2, int y2);
+static void 	SetupBenchBlock(benchBlock *b, int width, int height);
+static int 		XRegionHit(benchBlock *b, int x, int y);
+
+/*
+ *  Internal variable declarations:
+ */
+
+/* Block sizes from SetupBlockInfo() */
+static int blockSizes[NUM_SIZES][2] =
+{
+	{ 40, 20 }, { 50, 30 }, { 30, 30 }, { 33, 16 }, { 31, 31 },
+	{ 30, 19 }, { 35, 15 }, { 27, 23 }, { 32, 27 }, { 40, 15 },
+	{ 25, 27 }, { 21, 21 }, { 27, 27 }
+};
+
+static benchBlock 	blocks[NUM_SIZES];
+static int 			rectX[NUM_RECTS], rectY[NUM_RECTS];
+
+
+static double GetSeconds(void)
+{
+	struct timeval tv;
+
+	gettimeofday(&tv, NULL);
+	return (double) tv.tv_sec + (double) tv.tv_usec / 1000000.0;
+}
+
+static Region MakeTriangle(int x0, int y0, int x1, int y1, int x2, int y2)
+{
+	XPoint points[4];
+
+	points[0].x = x0; points[0].y = y0;
+	points[1].x = x1; points[1].y = y1;
+	points[2].x = x2; points[2].y = y2;
+	points[3].x = x0; points[3].y = y0;
+
+	return XPolygonRegion(points, 4, EvenOddRule);
+}
+
+static void SetupBenchBlock(benchBlock *b, int width, int height)
+{
+	int halfWidth, halfHeight;
+
+	/* Somewhere in the middle of the play area */
+	b->x 		= 200;
+	b->y 		= 250;
+	b->width 	= width;
+	b->height 	= height;
+
+	halfWidth 	= b->x + (width / 2);
+	halfHeight 	= b->y + (height / 2);
+
+	b->top 		= MakeTriangle(b->x, b->y, halfWidth, halfHeight,
+					b->x + width, b->y);
+	b->bottom 	= MakeTriangle(b->x, b->y + height, halfWidth, halfHeight,
+					b->x + width, b->y + height);
+	b->left 	= MakeTriangle(b->x, b->y, halfWidth, halfHeight,
+					b->x, b->y + height);
+	b->right 	= MakeTriangle(b->x + width, b->y, halfWidth, halfHeight,
+					b->x + width, b->y + height);
+}
+
+static int XRegionHit(benchBlock *b, int x, int y)
+{
+	int mask = REGION_NONE;
+
+	/* The eight calls CheckRegions() used to make, less the ordering */
+	if (XRectInRegion(b->left, x, y, BALL_WIDTH, BALL_HEIGHT) != RectangleOut)
+		mask |= REGION_LEFT;
+	if (XRectInRegion(b->right, x, y, BALL_WIDTH, BALL_HEIGHT) != RectangleOut)
+		mask |= REGION_RIGHT;
+	if (XRectInRegion(b->bottom, x, y, BALL_WIDTH, BALL_HEIGHT) != RectangleOut)
+		mask |= REGION_BOTTOM;
+	if (XRectInRegion(b->top, x, y, BALL_WIDTH, BALL_HEIGHT) != RectangleOut)
+		mask |= REGION_TOP;
+
+	return mask;
+}
+
+int main(int argc, char **argv)
+{
+	long queries = DEF_QUERIES, n, mismatches = 0L;
+	unsigned long sumX = 0UL, sumK = 0UL;
+	double t0, t1, tx, tk;
+	benchBlock *b;
+	int i;
+
+	if (argc == 3 && !strcmp(argv[1], "-queries") && atol(argv[2]) > 0)
+		queries = atol(argv[2]);
+	else if (argc != 1)
+	{
+		fprintf(stderr, "Usage: regionbench [-queries <n>]\n");
+		exit(1);
+	}
+
+	for (i = 0; i < NUM_SIZES; i++)
+		SetupBenchBlock(&blocks[i], blockSizes[i][0], blockSizes[i][1]);
+
+	/* Balls anywhere from just missing to fully inside the block */
+	srand(1);
+	for (i = 0; i < NUM_RECTS; i++)
+	{
+		rectX[i] = 200 - BALL_WIDTH - 2 + rand() % (50 + BALL_WIDTH + 4);
+		rectY[i] = 250 - BALL_HEIGHT - 2 + rand() % (30 + BALL_HEIGHT + 4);
+	}
+
+	/* Both methods must give the same answer for every query */
+	for (n = 0; n < (long) NUM_SIZES * NUM_RECTS; n++)
+	{
+		b = &blocks[n % NUM_SIZES];
+		i = (int) (n % NUM_RECTS);
+
+		if (XRegionHit(b, rectX[i], rectY[i]) != BlockRegionHit(b->x, b->y,
+			b->width, b->height, rectX[i], rectY[i], BALL_WIDTH, BALL_HEIGHT))
+			mismatches++;
+	}
+
+	t0 = GetSeconds();
+	for (n = 0; n < queries; n++)
+	{
+		b = &blocks[n % NUM_SIZES];
+		i = (int) (n % NUM_RECTS);
+		sumX += XRegionHit(b, rectX[i], rectY[i]);
+	}
+	t1 = GetSeconds();
+	tx = t1 - t0;
+
+	t0 = GetSeconds();
+	for (n = 0; n < queries; n++)
+	{
+		b = &blocks[n % NUM_SIZES];
+		i = (int) (n % NUM_RECTS);
+		sumK += BlockRegionHit(b->x, b->y, b->width, b->height,
+			rectX[i], rectY[i], BALL_WIDTH, BALL_HEIGHT);
+	}
+	t1 = GetSeconds();
+	tk = t1 - t0;
+
+	fprintf(stdout, "XRectInRegion  %12.0f queries/sec %8.1f ns/query\n",
+		(double) queries / tx, tx * 1e9 / (double) queries);
+	fprintf(stdout, "BlockRegionHit %12.0f queries/sec %8.1f ns/query\n",
+		(double) queries / tk, tk * 1e9 / (double) queries);
+	fprintf(stdout, "speedup %.1fx, %ld mismatches, checksum %s\n",
+		(tk > 0.0) ? tx / tk : 0.0, mismatches,
+		(sumX == sumK) ? "ok" : "BAD");
+
+	for (i = 0; i < NUM_SIZES; i++)
+	{
+		XDestroyRegion(blocks[i].top);
+		XDestroyRegion(blocks[i].bottom);
+		XDestroyRegion(blocks[i].left);
+		XDestroyRegion(blocks[i].right);
+	}
+
+	exit((mismatches == 0L && sumX == sumK) ? 0 : 1);
+}
@@ -0,0 +1,343 @@
+/*
+ * XBoing - An X11 blockout style computer game
+ *
+ * (c) Copyright 1993, 1994, 1995, Justin C. Kibell, All Rights Reserved
+ *
+ * The X Consortium, and any party obtaining a copy of these files from
+ * the X Consortium, directly or indirectly, is granted, free of charge, a
+ * full and unrestricted irrevocable, world-wide, paid up, royalty-free,
+ * nonexclusive right and license to deal in this software and
+ * documentation files (the "Software"), including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons who receive
+ * copies from any such party to do so.  This license includes without
+ * limitation a license to do the foregoing actions under any patents of
+ * the party supplying this software to the X Consortium.
+ *
+ * In no event shall the author be liable to any party for direct, indirect,
+ * special, incidental, or consequential damages arising out of the use of
+ * this software and its documentation, even if the author has been advised
+ * of the possibility of such damage.
+ *
+ * The author specifically disclaims any warranties, including, but not limited
+ * to, the implied warranties of merchantability and fitness for a particular
+ * purpose.  The software provided hereunder is on an "AS IS" basis, and the
+ * author has no obligation to provide maintenance, support, updates,
+ * enhancements, or modifications.
+ */
+
+/*
+ * =========================================================================
+ *
+ * Text cache. Entries live in a fixed table and are found through a hash
+ * of their key with chains through the table. Each keeps a colour pixmap
+ * with the text (and its shadow) and a one bit mask of the lit pixels, so
+ * drawing it is RenderShape() - one XCopyArea through the mask.
+ *
+ * =========================================================================
+ */
+
+/*
+ *  Include file dependencies:
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "include/faketypes.h"
+#include "include/init.h"
+#include "include/error.h"
+#include "include/misc.h"
+
+#include "include/textcache.h"
+
+/*
+ *  Internal macro definitions:
+ */
+
+#define NO_ENTRY		-1
+#define SHADOW_OFFSET	2
+
+/*
+ *  Internal type declarations:
+ */
+
+typedef struct
+{
+	int 			used;
+	XFontStruct 	*font;
+	char 			text[TEXT_CACHE_LEN];
+	int 			len;
+	int 			colour;
+	int 			shadow;
+	unsigned long 	hash;
+	int 			next;			/* Next entry in the same bucket */
+	long 			lastUsed;
+	Pixmap 			pixmap, mask;
+	int 			width, height;
+} textEntry;
+
+static unsigned long 	HashText(XFontStruct *font, char *text, int len, 
+							int colour, int shadow);
+static int 				FindText(XFontStruct *font, char *text, int len, 
+							int colour, int shadow, unsigned long hash);
+static int 				FreeSlot(Display *display);
+static void 			RemoveText(Display *display, int i);
+static int 				RenderText(Display *display, Window window, int i);
+static int 				EntryKb(int i);
+
+/*
+ *  Internal variable declarations:
+ */
+
+static textEntry 	entries[TEXT_CACHE_ENTRIES];
+static int 			buckets[TEXT_CACHE_BUCKETS];
+static int 			cacheReady = False;
+static int 			numEntries = 0, cacheKb = 0;
+static long 		useCount = 0L, hits = 0L, misses = 0L;
+static GC 			maskGc = None;
+
+
+/**
+ * FNV-1a over the key.
+ *
+ */
+static unsigned long HashText(XFontStruct *font, char *text, int len, 
+	int colour, int shadow)
+{
+	unsigned long h = 2166136261UL;
+	int i;
+
+	for (i = 0; i < len; i++)
+		h = (h ^ (unsigned char) text[i]) * 16777619UL;
+
+	h = (h ^ (unsigned long) font) * 16777619UL;
+	h = (h ^ (unsigned long) colour) * 16777619UL;
+	h = (h ^ (unsigned long) shadow) * 16777619UL;
+
+	return h;
+}
+
+
+static int FindText(XFontStruct *font, char *text, int len, int colour,
+	int shadow, unsigned long hash)
+{
+	int i;
+
+	for (i = buckets[hash % TEXT_CACHE_BUCKETS]; i != NO_ENTRY; 
+		i = entries[i].next)
+	{
+		if (entries[i].hash == hash && entries[i].font == font &&
+			entries[i].len == len && entries[i].colour == colour &&
+			entries[i].shadow == shadow && 
+			!strncmp(entries[i].text, text, len))
+			return i;
+	}
+
+	return NO_ENTRY;
+}
+
+
+static int EntryKb(int i)
+{
+	/* Assume 32 bits a pixel, the mask is next to nothing */
+	return (entries[i].width * entries[i].height * 4 + 1023) / 1024;
+}
+
+
+/**
+ * Unlinks an entry from its bucket and frees its pixmaps.
+ *
+ */
+static void RemoveText(Display *display, int i)
+{
+	int *link;
+
+	for (link = &buckets[entries[i].hash % TEXT_CACHE_BUCKETS]; 
+		*link != NO_ENTRY; link = &entries[*link].next)
+	{
+		if (*link == i)
+		{
+			*link = entries[i].next;
+			break;
+		}
+	}
+
+	if (entries[i].pixmap) 	XFreePixmap(display, entries[i].pixmap);
+	if (entries[i].mask) 	XFreePixmap(display, entries[i].mask);
+
+	cacheKb -= EntryKb(i);
+	numEntries--;
+	entries[i].used = False;
+}
+
+
+/**
+ * Returns an unused entry, freeing the least recently drawn ones while
+ * the cache is full or over its size.
+ *
+ */
+static int FreeSlot(Display *display)
+{
+	int i, oldest;
+
+	while (numEntries > 0 && 
+		(numEntries >= TEXT_CACHE_ENTRIES || cacheKb > TEXT_CACHE_KB))
+	{
+		oldest = NO_ENTRY;
+
+		for (i = 0; i < TEXT_CACHE_ENTRIES; i++)
+			if (entries[i].used == True && (oldest == NO_ENTRY ||
+				entries[i].lastUsed < entries[oldest].lastUsed))
+				oldest = i;
+
+		RemoveText(display, oldest);
+	}
+
+	for (i = 0; i < TEXT_CACHE_ENTRIES; i++)
+		if (entries[i].used == False)
+			return i;
+
+	/* NOT REACHED */
+	return NO_ENTRY;
+}
+
+
+/**
+ * Renders an entry's text into a new pixmap and mask.
+ *
+ */
+static int RenderText(Display *display, Window window, int i)
+{
+	textEntry *e = &entries[i];
+	int off = (e->shadow == True) ? SHADOW_OFFSET : 0;
+	int depth;
+
+	e->width 	= XTextWidth(e->font, e->text, e->len) + off;
+	e->height 	= e->font->ascent + e->font->descent + off;
+
+	/* Nothing to draw, e.g. a string of spaces in a proportional font */
+	if (e->width <= 0 || e->height <= 0)
+		return False;
+
+	depth = DefaultDepth(display, XDefaultScreen(display));
+	e->pixmap 	= XCreatePixmap(display, window, e->width, e->height, depth);
+	e->mask 	= XCreatePixmap(display, window, e->width, e->height, 1);
+
+	if (maskGc == None)
+		maskGc = XCreateGC(display, e->mask, 0, NULL);
+
+	/* The mask is set wherever the text or its shadow lights a pixel */
+	XSetForeground(display, maskGc, 0);
+	XFillRectangle(display, e->mask, maskGc, 0, 0, e->width, e->height);
+	XSetForeground(display, maskGc, 1);
+	XSetFont(display, maskGc, e->font->fid);
+	XDrawString(display, e->mask, maskGc, 0, e->font->ascent, e->text, 
+		e->len);
+
+	XSetFont(display, gccopy, e->font->fid);
+
+	if (e->shadow == True)
+	{
+		XDrawString(display, e->mask, maskGc, off, e->font->ascent + off, 
+			e->text, e->len);
+
+		XSetForeground(display, gccopy, black);
+		XDrawString(display, e->pixmap, gccopy, off, e->font->ascent + off,
+			e->text, e->len);
+	}
+
+	XSetForeground(display, gccopy, e->colour);
+	XDrawString(display, e->pixmap, gccopy, 0, e->font->ascent, e->text, 
+		e->len);
+
+	return True;
+}
+
+
+int DrawCachedText(Display *display, Window window, XFontStruct *font,
+	char *text, int len, int x, int y, int colour, int shadow)
+{
+	unsigned long hash;
+	int i, b;
+
+	if (len <= 0 || len >= TEXT_CACHE_LEN)
+		return False;
+
+	if (cacheReady == False)
+	{
+		for (b = 0; b < TEXT_CACHE_BUCKETS; b++)
+			buckets[b] = NO_ENTRY;
+		cacheReady = True;
+	}
+
+	hash = HashText(font, text, len, colour, shadow);
+
+	if ((i = FindText(font, text, len, colour, shadow, hash)) != NO_ENTRY)
+		hits++;
+	else
+	{
+		misses++;
+
+		i = FreeSlot(display);
+		entries[i].font 	= font;
+		entries[i].len 		= len;
+		entries[i].colour 	= colour;
+		entries[i].shadow 	= shadow;
+		entries[i].hash 	= hash;
+		entries[i].pixmap 	= None;
+		entries[i].mask 	= None;
+		memcpy(entries[i].text, text, len);
+		entries[i].text[len] = '\0';
+
+		if (RenderText(display, window, i) == False)
+		{
+			if (entries[i].pixmap) 	XFreePixmap(display, entries[i].pixmap);
+			if (entries[i].mask) 	XFreePixmap(display, entries[i].mask);
+			return False;
+		}
+
+		b = hash % TEXT_CACHE_BUCKETS;
+		entries[i].next = buckets[b];
+		buckets[b] 		= i;
+		entries[i].used = True;
+
+		cacheKb += EntryKb(i);
+		numEntries++;
+	}
+
+	entries[i].lastUsed = ++useCount;
+
+	RenderShape(display, window, entries[i].pixmap, entries[i].mask,
+		x, y, entries[i].width, entries[i].height, False);
+
+	return True;
+}
+
+
+void GetTextCacheStats(long *hitCount, long *missCount)
+{
+	*hitCount 	= hits;
+	*missCount 	= misses;
+}
+
+
+void FreeTextCache(Display *display)
+{
+	char str[80];
+	int i;
+
+	sprintf(str, "Text cache: %ld hits, %ld misses, %d strings.", hits, 
+		misses, numEntries);
+	DEBUG(str)
+
+	for (i = 0; i < TEXT_CACHE_ENTRIES; i++)
+		if (entries[i].used == True)
+			RemoveText(display, i);
+
+	if (maskGc != None)
+		XFreeGC(display, maskGc);
+
+	maskGc = None;
+}
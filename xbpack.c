@@ -0,0 +1,446 @@
+/*
+ * XBoing - An X11 blockout style computer game
+ *
+ * (c) Copyright 1993, 1994, 1995, Justin C. Kibell, All Rights Reserved
+ *
+ * The X Consortium, and any party obtaining a copy of these files from
+ * the X Consortium, directly or indirectly, is granted, free of charge, a
+ * full and unrestricted irrevocable, world-wide, paid up, royalty-free,
+ * nonexclusive right and license to deal in this software and
+ * documentation files (the "Software"), including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons who receive
+ * copies from any such party to do so.  This license includes without
+ * limitation a license to do the foregoing actions under any patents of
+ * the party supplying this software to the X Consortium.
+ *
+ * In no event shall the author be liable to any party for direct, indirect,
+ * special, incidental, or consequential damages arising out of the use of
+ * this software and its documentation, even if the author has been advised
+ * of the possibility of such damage.
+ *
+ * The author specifically disclaims any warranties, including, but not limited
+ * to, the implied warranties of merchantability and fitness for a particular
+ * purpose.  The software provided hereunder is on an "AS IS" basis, and the
+ * author has no obligation to provide maintenance, support, updates,
+ * enhancements, or modifications.
+ */
+
+/*
+ * =========================================================================
+ *
+ * xbpack - builds the asset pack read by pack.c. Run from the top of the
+ * source tree, after the game is built, as
+ *
+ *		xbpack [<pack file>]
+ *
+ * It takes every .png under bitmaps/, every .au in sounds/ and every .data
+ * in levels/, decodes the images to RGBA and the sounds to 16 bit PCM, and
+ * writes them with an index to the pack file, xboing.pak by default. See
+ * pack.h for the layout.
+ *
+ * =========================================================================
+ */
+
+/*
+ *  Include file dependencies:
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <raylib.h>
+
+#include "include/pack.h"
+
+/*
+ *  Internal macro definitions:
+ */
+
+#define MAX_ASSETS		1024
+
+/* Built without the X headers so faketypes.h is not pulled in */
+#ifndef True
+#define True			1
+#define False			0
+#endif
+
+/* Sun audio file header, all big endian words */
+#define AU_MAGIC		0x2e736e64
+#define AU_ULAW			1
+#define AU_LINEAR_8		2
+#define AU_LINEAR_16	3
+
+/*
+ *  Internal type declarations:
+ */
+
+typedef struct
+{
+	char 			name[PACK_NAME_LEN];
+	int 			type;
+} packAsset;
+
+static void 			AddAsset(char *name, int type);
+static void 			FindAssets(char *dir, char *ext, int type, 
+							int recurse);
+static int 				CompareAsset(const void *a, const void *b);
+static unsigned char 	*ReadWholeFile(char *path, unsigned int *size);
+static unsigned int 	ReadBigEndian(unsigned char *p);
+static short 			DecodeUlaw(unsigned char u);
+static unsigned char 	*DecodeImage(char *path, packEntry *entry);
+static unsigned char 	*DecodeSound(char *path, packEntry *entry);
+static unsigned char 	*ReadLevel(char *path, packEntry *entry);
+
+/*
+ *  Internal variable declarations:
+ */
+
+static packAsset 	assets[MAX_ASSETS];
+static int 			numAssets = 0;
+
+
+/**
+ * Adds one file to the list to be packed.
+ *
+ */
+static void AddAsset(char *name, int type)
+{
+	if (strlen(name) >= PACK_NAME_LEN)
+	{
+		fprintf(stderr, "xbpack: %s: name too long, skipped\n", name);
+		return;
+	}
+
+	if (numAssets == MAX_ASSETS)
+	{
+		fprintf(stderr, "xbpack: too many assets, %s skipped\n", name);
+		return;
+	}
+
+	strcpy(assets[numAssets].name, name);
+	assets[numAssets].type = type;
+	numAssets++;
+}
+
+
+/**
+ * Adds every file in a directory that ends in ext, going down into the
+ * directories below it if recurse is True. CVS directories are skipped.
+ *
+ */
+static void FindAssets(char *dir, char *ext, int type, int recurse)
+{
+	char path[1024];
+	struct dirent *de;
+	struct stat st;
+	DIR *d;
+	size_t len;
+
+	if ((d = opendir(dir)) == NULL)
+	{
+		perror(dir);
+		return;
+	}
+
+	while ((de = readdir(d)) != NULL)
+	{
+		if (de->d_name[0] == '.' || !strcmp(de->d_name, "CVS"))
+			continue;
+
+		snprintf(path, sizeof(path), "%s/%s", dir, de->d_name);
+		if (stat(path, &st) < 0)
+			continue;
+
+		if (S_ISDIR(st.st_mode))
+		{
+			if (recurse == True)
+				FindAssets(path, ext, type, recurse);
+			continue;
+		}
+
+		len = strlen(de->d_name);
+		if (len > strlen(ext) && !strcmp(de->d_name + len - strlen(ext), ext))
+			AddAsset(path, type);
+	}
+
+	closedir(d);
+}
+
+
+/**
+ * qsort() order for the entry table, the one FindPackEntry() searches in.
+ *
+ */
+static int CompareAsset(const void *a, const void *b)
+{
+	const packAsset *pa = (const packAsset *) a;
+	const packAsset *pb = (const packAsset *) b;
+	int cmp;
+
+	if ((cmp = strncmp(pa->name, pb->name, PACK_NAME_LEN)) != 0)
+		return cmp;
+
+	return pa->type - pb->type;
+}
+
+
+/**
+ * Reads a whole file into memory.
+ *
+ * @return The bytes, to be freed, or NULL if it could not be read.
+ *
+ */
+static unsigned char *ReadWholeFile(char *path, unsigned int *size)
+{
+	unsigned char *data;
+	FILE *fp;
+	long len;
+
+	if ((fp = fopen(path, "rb")) == NULL)
+		return NULL;
+
+	fseek(fp, 0L, SEEK_END);
+	len = ftell(fp);
+	fseek(fp, 0L, SEEK_SET);
+
+	if (len < 0 || (data = malloc(len > 0 ? len : 1)) == NULL)
+	{
+		fclose(fp);
+		return NULL;
+	}
+
+	if (fread(data, 1, (size_t) len, fp) != (size_t) len)
+	{
+		free(data);
+		fclose(fp);
+		return NULL;
+	}
+
+	fclose(fp);
+	*size = (unsigned int) len;
+	return data;
+}
+
+
+static unsigned int ReadBigEndian(unsigned char *p)
+{
+	return ((unsigned int) p[0] << 24) | ((unsigned int) p[1] << 16) |
+		((unsigned int) p[2] << 8) | (unsigned int) p[3];
+}
+
+
+/**
+ * Expands one G.711 mu-law byte to a 16 bit sample.
+ *
+ */
+static short DecodeUlaw(unsigned char u)
+{
+	int t;
+
+	u = ~u;
+	t = (((u & 0x0f) << 3) + 0x84) << ((u & 0x70) >> 4);
+
+	return (short) ((u & 0x80) ? (0x84 - t) : (t - 0x84));
+}
+
+
+/**
+ * Decodes a PNG to RGBA.
+ *
+ */
+static unsigned char *DecodeImage(char *path, packEntry *entry)
+{
+	unsigned char *pixels;
+	Image image;
+
+	image = LoadImage(path);
+	if (image.data == NULL)
+		return NULL;
+
+	ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+
+	entry->width 	= (unsigned int) image.width;
+	entry->height 	= (unsigned int) image.height;
+	entry->size 	= entry->width * entry->height * 4;
+
+	if ((pixels = malloc(entry->size)) != NULL)
+		memcpy(pixels, image.data, entry->size);
+
+	UnloadImage(image);
+	return pixels;
+}
+
+
+/**
+ * Decodes a Sun .au file to 16 bit native endian PCM.
+ *
+ */
+static unsigned char *DecodeSound(char *path, packEntry *entry)
+{
+	unsigned char *file, *p;
+	unsigned int size, offset, length, encoding, i, n;
+	short *pcm;
+
+	if ((file = ReadWholeFile(path, &size)) == NULL)
+		return NULL;
+
+	if (size < 24 || ReadBigEndian(file) != AU_MAGIC)
+	{
+		fprintf(stderr, "xbpack: %s: not an audio file\n", path);
+		free(file);
+		return NULL;
+	}
+
+	offset 			= ReadBigEndian(file + 4);
+	length 			= ReadBigEndian(file + 8);
+	encoding 		= ReadBigEndian(file + 12);
+	entry->width 	= ReadBigEndian(file + 16);
+	entry->height 	= ReadBigEndian(file + 20);
+
+	/* The length may be unknown (~0) or run past the end of the file */
+	if (offset > size) offset = size;
+	if (length > size - offset) length = size - offset;
+	p = file + offset;
+
+	n = (encoding == AU_LINEAR_16) ? length / 2 : length;
+	if (encoding != AU_ULAW && encoding != AU_LINEAR_8 && 
+		encoding != AU_LINEAR_16)
+	{
+		fprintf(stderr, "xbpack: %s: unknown encoding %u\n", path, encoding);
+		free(file);
+		return NULL;
+	}
+
+	if ((pcm = malloc((n ? n : 1) * sizeof(short))) == NULL)
+	{
+		free(file);
+		return NULL;
+	}
+
+	for (i = 0; i < n; i++)
+	{
+		if (encoding == AU_ULAW)
+			pcm[i] = DecodeUlaw(p[i]);
+		else if (encoding == AU_LINEAR_8)
+			pcm[i] = (short) ((signed char) p[i] * 256);
+		else
+			pcm[i] = (short) ((p[2 * i] << 8) | p[2 * i + 1]);
+	}
+
+	entry->size = n * sizeof(short);
+	free(file);
+	return (unsigned char *) pcm;
+}
+
+
+/**
+ * Levels are packed as they are; the game parses them as it always has.
+ *
+ */
+static unsigned char *ReadLevel(char *path, packEntry *entry)
+{
+	return ReadWholeFile(path, &entry->size);
+}
+
+
+int main(int argc, char **argv)
+{
+	static unsigned char zeros[PACK_ALIGN];
+	char *output = PACK_FILE;
+	packHeader header;
+	packEntry *entries;
+	unsigned char **data;
+	unsigned int offset;
+	int i, n;
+	FILE *fp;
+
+	if (argc > 2)
+	{
+		fprintf(stderr, "Usage: xbpack [<pack file>]\n");
+		exit(1);
+	}
+
+	if (argc == 2)
+		output = argv[1];
+
+	SetTraceLogLevel(LOG_WARNING);
+
+	FindAssets("bitmaps", ".png", PACK_IMAGE, True);
+	FindAssets("sounds", ".au", PACK_SOUND, False);
+	FindAssets("levels", ".data", PACK_LEVEL, False);
+
+	qsort(assets, numAssets, sizeof(packAsset), CompareAsset);
+
+	entries = calloc(numAssets ? numAssets : 1, sizeof(packEntry));
+	data 	= calloc(numAssets ? numAssets : 1, sizeof(unsigned char *));
+	if (entries == NULL || data == NULL)
+	{
+		fprintf(stderr, "xbpack: out of memory\n");
+		exit(1);
+	}
+
+	/* Decode everything first so the offsets are known */
+	offset = sizeof(packHeader) + numAssets * sizeof(packEntry);
+	for (i = n = 0; i < numAssets; i++)
+	{
+		strcpy(entries[n].name, assets[i].name);
+		entries[n].type = assets[i].type;
+
+		switch (assets[i].type)
+		{
+			case PACK_IMAGE: data[n] = DecodeImage(assets[i].name, &entries[n]);
+				break;
+			case PACK_SOUND: data[n] = DecodeSound(assets[i].name, &entries[n]);
+				break;
+			default: 		 data[n] = ReadLevel(assets[i].name, &entries[n]);
+				break;
+		}
+
+		if (data[n] == NULL)
+		{
+			fprintf(stderr, "xbpack: %s: cannot read, skipped\n", 
+				assets[i].name);
+			continue;
+		}
+
+		offset = (offset + PACK_ALIGN - 1) & ~(PACK_ALIGN - 1);
+		entries[n].offset 	= offset;
+		offset 				+= entries[n].size;
+		n++;
+	}
+
+	if ((fp = fopen(output, "wb")) == NULL)
+	{
+		perror(output);
+		exit(1);
+	}
+
+	/* Skipped assets leave room for entries that are never written */
+	memcpy(header.magic, PACK_MAGIC, 4);
+	header.version 		= PACK_VERSION;
+	header.numEntries 	= (unsigned int) n;
+	header.reserved 	= 0;
+
+	fwrite(&header, sizeof(header), 1, fp);
+	fwrite(entries, sizeof(packEntry), numAssets, fp);
+
+	for (i = 0; i < n; i++)
+	{
+		fwrite(zeros, 1, entries[i].offset - (unsigned int) ftell(fp), fp);
+		fwrite(data[i], 1, entries[i].size, fp);
+		free(data[i]);
+	}
+
+	if (fclose(fp) != 0)
+	{
+		perror(output);
+		exit(1);
+	}
+
+	fprintf(stdout, "xbpack: %d assets, %u bytes in %s\n", n, offset, output);
+	exit(0);
+}